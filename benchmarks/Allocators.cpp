@@ -0,0 +1,101 @@
+#include "benchmarks/Benchmark.hpp"
+#include "headers/ArenaAllocator.hpp"
+#include "headers/BlockVector.hpp"
+#include "headers/Deque.hpp"
+
+#include <cstdio>
+#include <memory>
+#include <memory_resource>
+
+namespace {
+
+const size_t REQUESTS = 200000;
+const size_t ELEMENTS = 64;
+
+/// One simulated request: a small deque is filled, drained from the front
+/// and dropped.
+template <typename DequeType>
+long
+serveRequest(DequeType& queue)
+{
+    for (size_t i = 0; i < ELEMENTS; ++i) {
+        queue.push_back(static_cast<int>(i));
+        queue.push_front(static_cast<int>(i));
+    }
+    long sum = 0;
+    while (!queue.empty()) {
+        sum += queue.front();
+        queue.pop_front();
+    }
+    return sum;
+}
+
+void
+report(const char* name, const double seconds)
+{
+    std::printf("%-28s %12.6f %12.2f\n", name, seconds, seconds * 1e9 / static_cast<double>(REQUESTS));
+}
+
+template <typename Storage>
+void
+measureDefault(const char* name)
+{
+    Timer timer;
+    long sum = 0;
+    for (size_t r = 0; r < REQUESTS; ++r) {
+        Deque<int, std::allocator<int>, Storage> queue;
+        sum += serveRequest(queue);
+    }
+    doNotOptimize(sum);
+    report(name, timer.seconds());
+}
+
+template <typename Storage>
+void
+measureArena(const char* name)
+{
+    MonotonicArena arena;
+    Timer timer;
+    long sum = 0;
+    for (size_t r = 0; r < REQUESTS; ++r) {
+        {
+            Deque<int, ArenaAllocator<int>, Storage> queue((ArenaAllocator<int>(arena)));
+            sum += serveRequest(queue);
+        }
+        arena.release();
+    }
+    doNotOptimize(sum);
+    report(name, timer.seconds());
+}
+
+void
+measurePmr()
+{
+    char buffer[64 * 1024];
+    Timer timer;
+    long sum = 0;
+    for (size_t r = 0; r < REQUESTS; ++r) {
+        std::pmr::monotonic_buffer_resource resource(buffer, sizeof(buffer));
+        pmr::Deque<int> queue(&resource);
+        sum += serveRequest(queue);
+    }
+    doNotOptimize(sum);
+    report("pmr monotonic buffer", timer.seconds());
+}
+
+} /// namespace
+
+/// Builds and drops many short-lived deques, as a request handler would,
+/// with the global heap, a MonotonicArena and a pmr stack buffer.
+void
+benchAllocators()
+{
+    std::printf("== %lu short-lived deques of %lu ints ==\n",
+                static_cast<unsigned long>(REQUESTS), static_cast<unsigned long>(2 * ELEMENTS));
+    std::printf("%-28s %12s %12s\n", "allocator", "seconds", "ns/request");
+    measureDefault<std::vector<int> >("std::allocator");
+    measureArena<std::vector<int, ArenaAllocator<int> > >("ArenaAllocator");
+    measurePmr();
+    measureDefault<BlockVector<int> >("std::allocator BlockVector");
+    measureArena<BlockVector<int, ArenaAllocator<int> > >("ArenaAllocator BlockVector");
+}
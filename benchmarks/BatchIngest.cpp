@@ -0,0 +1,116 @@
+#include "benchmarks/Benchmark.hpp"
+#include "headers/Deque.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <vector>
+
+namespace {
+
+size_t
+environmentSize(const char* name, const size_t fallback)
+{
+    const char* text = std::getenv(name);
+    return text != NULL ? static_cast<size_t>(std::strtoull(text, NULL, 10)) : fallback;
+}
+
+enum Variant {
+    PUSH_BACK_LOOP, APPEND, STD_DEQUE_INSERT_BACK,
+    PUSH_FRONT_LOOP, PREPEND, STD_DEQUE_INSERT_FRONT,
+    PUSH_BACK_N_LOOP, PUSH_BACK_N, PUSH_FRONT_N, VARIANTS
+};
+
+const char* const VARIANT_NAMES[VARIANTS] = {
+    "push_back loop", "append", "std::deque insert end",
+    "push_front loop", "prepend", "std::deque insert begin",
+    "push_back(value) loop", "push_back_n", "push_front_n"
+};
+
+/// Containers are cleared once they pass this many elements, so after the
+/// first fill the halves have their capacity and stay in cache: what is
+/// left is the cost per call and per element, not reallocation.
+const size_t WINDOW = 1 << 17;
+
+/// Ingests total elements, batch at a time, and returns ns per element.
+double
+ingest(const Variant variant, const std::vector<long>& batch, const size_t total)
+{
+    const size_t batches = total / batch.size();
+    const long* const first = batch.data();
+    const long* const last = first + batch.size();
+    Deque<long> deque;
+    std::deque<long> standard;
+    Timer timer;
+    for (size_t b = 0; b < batches; ++b) {
+        switch (variant) {
+        case PUSH_BACK_LOOP:
+            for (const long* it = first; it != last; ++it) deque.push_back(*it);
+            break;
+        case APPEND:
+            deque.append(first, last);
+            break;
+        case STD_DEQUE_INSERT_BACK:
+            standard.insert(standard.end(), first, last);
+            break;
+        case PUSH_FRONT_LOOP:
+            for (const long* it = last; it != first; ) deque.push_front(*--it);
+            break;
+        case PREPEND:
+            deque.prepend(first, last);
+            break;
+        case STD_DEQUE_INSERT_FRONT:
+            standard.insert(standard.begin(), first, last);
+            break;
+        case PUSH_BACK_N_LOOP:
+            for (size_t i = 0; i < batch.size(); ++i) deque.push_back(first[b & 7]);
+            break;
+        case PUSH_BACK_N:
+            deque.push_back_n(batch.size(), first[b & 7]);
+            break;
+        case PUSH_FRONT_N:
+            deque.push_front_n(batch.size(), first[b & 7]);
+            break;
+        default:
+            break;
+        }
+        if (deque.size() + standard.size() >= WINDOW) {
+            deque.clear();
+            standard.clear();
+        }
+    }
+    const double seconds = timer.seconds();
+    doNotOptimize(deque.size() + standard.size());
+    return seconds * 1e9 / static_cast<double>(batches * batch.size());
+}
+
+} /// namespace
+
+/// Ingests BENCH_BATCH_TOTAL longs (default 16M) per measurement in
+/// batches of 8 to 64k, element by element and with the batched calls,
+/// with std::deque range inserts for reference. ns per element.
+void
+benchBatchIngest()
+{
+    const size_t total = environmentSize("BENCH_BATCH_TOTAL", 16 << 20);
+    const size_t sizes[] = { 8, 64, 512, 4096, 32768, 65536 };
+    const size_t SIZES = sizeof(sizes) / sizeof(sizes[0]);
+
+    std::printf("== Batch ingest (%lu longs per run): ns per element ==\n", static_cast<unsigned long>(total));
+    std::printf("%-24s", "variant \\ batch");
+    for (size_t s = 0; s < SIZES; ++s) {
+        std::printf(" %9lu", static_cast<unsigned long>(sizes[s]));
+    }
+    std::printf("\n");
+    for (size_t v = 0; v < VARIANTS; ++v) {
+        std::printf("%-24s", VARIANT_NAMES[v]);
+        for (size_t s = 0; s < SIZES; ++s) {
+            std::vector<long> batch(sizes[s]);
+            for (size_t i = 0; i < batch.size(); ++i) {
+                batch[i] = static_cast<long>(i);
+            }
+            std::printf(" %9.3f", ingest(static_cast<Variant>(v), batch, total));
+        }
+        std::printf("\n");
+    }
+}
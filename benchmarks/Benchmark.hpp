@@ -0,0 +1,65 @@
+#ifndef __BENCHMARK_HPP__
+#define __BENCHMARK_HPP__
+
+#include <cstddef>
+#include <ctime>
+
+/// Wall-clock stopwatch used by every benchmark in this directory.
+class Timer
+{
+public:
+    Timer() { reset(); }
+
+    void reset()
+    {
+        ::clock_gettime(CLOCK_MONOTONIC, &start_);
+    }
+
+    double seconds() const
+    {
+        timespec now;
+        ::clock_gettime(CLOCK_MONOTONIC, &now);
+        return static_cast<double>(now.tv_sec - start_.tv_sec)
+             + static_cast<double>(now.tv_nsec - start_.tv_nsec) * 1e-9;
+    }
+
+private:
+    timespec start_;
+};
+
+/// Keeps the optimizer from discarding a computed value.
+template <typename T>
+inline void
+doNotOptimize(const T& value)
+{
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+void benchFifoDrain();
+void benchSegmentedStorage();
+void benchRingStorage();
+void benchMoveSemantics();
+void benchAllocators();
+void benchBulkEdit();
+void benchSnapshot();
+void benchReserve();
+void benchSpscHandoff();
+void benchForkJoin();
+void benchContention();
+void benchTraversal();
+void benchSegments();
+void benchCompare();
+void benchTrivialCopy();
+void benchSmallBuffer();
+void benchSuite();
+void benchStatistics();
+void benchRollingWindow();
+void benchSlidingMinMax();
+void benchMappedStorage();
+void benchSerialization();
+void benchParallel();
+void benchParallelSort();
+void benchBatchIngest();
+
+#endif /// __BENCHMARK_HPP__
+
@@ -0,0 +1,49 @@
+#include "benchmarks/Benchmark.hpp"
+#include "headers/BlockVector.hpp"
+#include "headers/Deque.hpp"
+
+#include <cstdio>
+#include <deque>
+#include <vector>
+
+namespace {
+
+/// Splices a batch into the middle of a large deque, erases it again and
+/// reports both times.
+template <typename Queue>
+void
+measureSplice(const char* name, const size_t size, const size_t batch)
+{
+    Queue queue;
+    for (size_t i = 0; i < size / 2; ++i) {
+        queue.push_back(static_cast<int>(i));
+        queue.push_front(-static_cast<int>(i));
+    }
+    const std::vector<int> values(batch, 7);
+
+    Timer timer;
+    queue.insert(queue.begin() + size / 3, values.begin(), values.end());
+    const double inserted = timer.seconds();
+
+    timer.reset();
+    queue.erase(queue.begin() + size / 3, queue.begin() + size / 3 + batch);
+    const double erased = timer.seconds();
+
+    doNotOptimize(queue.back());
+    std::printf("%-24s %14.3f %14.3f\n", name, inserted * 1e3, erased * 1e3);
+}
+
+} /// namespace
+
+void
+benchBulkEdit()
+{
+    const size_t size = 1000000;
+    const size_t batch = 10000;
+    std::printf("== Splice %lu ints into a %lu-element deque ==\n",
+                static_cast<unsigned long>(batch), static_cast<unsigned long>(size));
+    std::printf("%-24s %14s %14s\n", "container", "insert (ms)", "erase (ms)");
+    measureSplice<Deque<int> >("Deque", size, batch);
+    measureSplice<Deque<int, std::allocator<int>, BlockVector<int> > >("Deque<BlockVector>", size, batch);
+    measureSplice<std::deque<int> >("std::deque", size, batch);
+}
@@ -0,0 +1,80 @@
+#include "benchmarks/Benchmark.hpp"
+#include "headers/BlockVector.hpp"
+#include "headers/Deque.hpp"
+
+#include <cstdio>
+#include <deque>
+
+namespace {
+
+/// Element-by-element loop through operator[], as the comparisons used to do.
+template <typename Queue>
+bool
+scalarEqual(const Queue& lhs, const Queue& rhs)
+{
+    if (lhs.size() != rhs.size()) return false;
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        if (lhs[i] != rhs[i]) return false;
+    }
+    return true;
+}
+
+/// Two equal queues split across both ends; the last element of the second
+/// differs in the less-than pass so the whole prefix is scanned.
+template <typename Queue, typename Value>
+void
+measure(const char* name, const size_t count, const size_t passes)
+{
+    Queue lhs;
+    Queue rhs;
+    for (size_t i = 0; i < count / 2; ++i) {
+        lhs.push_back(static_cast<Value>(i));
+        lhs.push_front(static_cast<Value>(~i));
+    }
+    for (size_t i = 0; i < count / 3; ++i) {
+        rhs.push_front(lhs[count / 3 - 1 - i]);
+    }
+    for (size_t i = count / 3; i < lhs.size(); ++i) {
+        rhs.push_back(lhs[i]);
+    }
+    const double bytes = static_cast<double>(lhs.size() * sizeof(Value) * passes);
+
+    Timer timer;
+    bool result = true;
+    for (size_t pass = 0; pass < passes; ++pass) {
+        result &= scalarEqual(lhs, rhs);
+    }
+    const double scalar = timer.seconds();
+
+    timer.reset();
+    for (size_t pass = 0; pass < passes; ++pass) {
+        result &= (lhs == rhs);
+    }
+    const double equal = timer.seconds();
+
+    rhs.back() = static_cast<Value>(rhs.back() + 1);
+    timer.reset();
+    for (size_t pass = 0; pass < passes; ++pass) {
+        result &= (lhs < rhs) != (rhs < lhs);
+    }
+    const double less = timer.seconds();
+    doNotOptimize(result);
+    std::printf("%-24s %14.2f %14.2f %14.2f\n", name,
+                bytes / scalar * 1e-9, bytes / equal * 1e-9, 2 * bytes / less * 1e-9);
+}
+
+} /// namespace
+
+void
+benchCompare()
+{
+    const size_t count = 4000000;
+    const size_t passes = 10;
+    std::printf("== Comparison (%lu elements, GB/s) ==\n", static_cast<unsigned long>(count));
+    std::printf("%-24s %14s %14s %14s\n", "container", "scalar ==", "==", "<");
+    measure<std::deque<unsigned char>, unsigned char>("std::deque<uint8_t>", count, passes);
+    measure<Deque<unsigned char>, unsigned char>("Deque<uint8_t>", count, passes);
+    measure<std::deque<int>, int>("std::deque<int>", count, passes);
+    measure<Deque<int>, int>("Deque<int>", count, passes);
+    measure<Deque<int, std::allocator<int>, BlockVector<int> >, int>("Deque<int, BlockVector>", count, passes);
+}
@@ -0,0 +1,121 @@
+#include "benchmarks/Benchmark.hpp"
+#include "headers/ConcurrentDeque.hpp"
+#include "headers/Deque.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const size_t OPERATIONS = 100000;
+
+/// The baseline: one mutex around a whole Deque.
+class LockedDeque
+{
+public:
+    void push_front(const long value)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        deque_.push_front(value);
+    }
+
+    void push_back(const long value)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        deque_.push_back(value);
+    }
+
+    bool try_pop_front(long& value)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (deque_.empty()) return false;
+        value = deque_.front();
+        deque_.pop_front();
+        return true;
+    }
+
+    bool try_pop_back(long& value)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (deque_.empty()) return false;
+        value = deque_.back();
+        deque_.pop_back();
+        return true;
+    }
+
+private:
+    std::mutex  mutex_;
+    Deque<long> deque_;
+};
+
+/// Even threads work the front, odd threads the back; every thread alternates
+/// a push and a pop at its end and records the latency of each pair.
+template <typename Queue>
+void
+worker(Queue& queue, const size_t id, std::vector<double>& latencies)
+{
+    latencies.resize(OPERATIONS);
+    long value = 0;
+    for (size_t i = 0; i < OPERATIONS; ++i) {
+        Timer timer;
+        if (0 == id % 2) {
+            queue.push_front(static_cast<long>(i));
+            queue.try_pop_front(value);
+        } else {
+            queue.push_back(static_cast<long>(i));
+            queue.try_pop_back(value);
+        }
+        latencies[i] = timer.seconds();
+    }
+    doNotOptimize(value);
+}
+
+template <typename Queue>
+void
+measure(const char* name, const size_t threads)
+{
+    Queue queue;
+    for (long i = 0; i < 1024; ++i) {
+        queue.push_back(i);
+    }
+    std::vector<std::vector<double> > latencies(threads);
+    std::vector<std::thread> pool;
+    Timer timer;
+    for (size_t t = 0; t < threads; ++t) {
+        pool.push_back(std::thread(worker<Queue>, std::ref(queue), t, std::ref(latencies[t])));
+    }
+    for (size_t t = 0; t < threads; ++t) {
+        pool[t].join();
+    }
+    const double elapsed = timer.seconds();
+
+    std::vector<double> all;
+    for (size_t t = 0; t < threads; ++t) {
+        all.insert(all.end(), latencies[t].begin(), latencies[t].end());
+    }
+    std::vector<double>::iterator p99 = all.begin() + all.size() * 99 / 100;
+    std::nth_element(all.begin(), p99, all.end());
+    const double throughput = static_cast<double>(2 * OPERATIONS * threads) / elapsed;
+    std::printf("%-20s %8lu %14.2f %14.0f\n", name, static_cast<unsigned long>(threads), throughput * 1e-6, *p99 * 1e9);
+}
+
+} /// namespace
+
+/// Push/pop pairs at both ends from 1 to N threads, N being at least 4.
+void
+benchContention()
+{
+    size_t maxThreads = std::thread::hardware_concurrency();
+    if (maxThreads < 4) {
+        maxThreads = 4;
+    }
+    std::printf("== Contention, %lu push/pop pairs per thread ==\n", static_cast<unsigned long>(OPERATIONS));
+    std::printf("%-20s %8s %14s %14s\n", "queue", "threads", "Mops/s", "p99 pair (ns)");
+    for (size_t threads = 1; threads <= maxThreads; threads *= 2) {
+        measure<LockedDeque>("mutex + Deque", threads);
+        measure<ConcurrentDeque<long> >("ConcurrentDeque", threads);
+    }
+}
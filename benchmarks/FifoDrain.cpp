@@ -0,0 +1,30 @@
+#include "benchmarks/Benchmark.hpp"
+#include "headers/Deque.hpp"
+
+#include <cstdio>
+
+/// Fills a deque with push_back and drains it with pop_front (the FIFO
+/// pattern). With rebalancing, the cost per element stays flat as the size
+/// doubles; the old back_.erase(back_.begin()) path grew linearly per pop.
+void
+benchFifoDrain()
+{
+    std::printf("== FIFO drain (push_back N, then pop_front N) ==\n");
+    std::printf("%12s %12s %12s\n", "N", "seconds", "ns/element");
+    for (size_t n = 250000; n <= 1000000; n *= 2) {
+        Timer timer;
+        Deque<int> queue;
+        for (size_t i = 0; i < n; ++i) {
+            queue.push_back(static_cast<int>(i));
+        }
+        long long sum = 0;
+        while (!queue.empty()) {
+            sum += queue.front();
+            queue.pop_front();
+        }
+        doNotOptimize(sum);
+        const double elapsed = timer.seconds();
+        std::printf("%12lu %12.6f %12.2f\n", static_cast<unsigned long>(n), elapsed, elapsed * 1e9 / static_cast<double>(n));
+    }
+}
+
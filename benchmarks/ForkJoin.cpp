@@ -0,0 +1,149 @@
+#include "benchmarks/Benchmark.hpp"
+#include "headers/WorkStealingDeque.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const int FIB_N = 36;
+const int CUTOFF = 12;
+
+struct FibTask
+{
+    int               n;
+    long              result;
+    std::atomic<bool> done;
+};
+
+/// Fork/join scheduler: every worker owns a WorkStealingDeque of tasks,
+/// spawns into it and, while joining, runs its own tasks or steals others'.
+class Scheduler
+{
+public:
+    explicit Scheduler(const size_t workers)
+        : deques_(workers)
+        , stop_(false)
+    {
+        for (size_t i = 0; i < workers; ++i) {
+            deques_[i] = new WorkStealingDeque<FibTask*>();
+        }
+    }
+
+    ~Scheduler()
+    {
+        for (size_t i = 0; i < deques_.size(); ++i) {
+            delete deques_[i];
+        }
+    }
+
+    long run(const int n)
+    {
+        stop_.store(false);
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < deques_.size(); ++i) {
+            threads.push_back(std::thread(&Scheduler::idle, this, i));
+        }
+        const long result = fib(0, n);
+        stop_.store(true);
+        for (size_t i = 0; i < threads.size(); ++i) {
+            threads[i].join();
+        }
+        return result;
+    }
+
+private:
+    static long serialFib(const int n)
+    {
+        return n < 2 ? n : serialFib(n - 1) + serialFib(n - 2);
+    }
+
+    long fib(const size_t worker, const int n)
+    {
+        if (n < CUTOFF) {
+            return serialFib(n);
+        }
+        FibTask child;
+        child.n = n - 1;
+        child.result = 0;
+        child.done.store(false, std::memory_order_relaxed);
+        deques_[worker]->push_back(&child);
+        const long right = fib(worker, n - 2);
+        join(worker, child);
+        return child.result + right;
+    }
+
+    void execute(const size_t worker, FibTask* task)
+    {
+        task->result = fib(worker, task->n);
+        task->done.store(true, std::memory_order_release);
+    }
+
+    bool findWork(const size_t worker, FibTask*& task)
+    {
+        if (deques_[worker]->pop_back(task)) return true;
+        for (size_t i = 1; i < deques_.size(); ++i) {
+            if (deques_[(worker + i) % deques_.size()]->steal(task)) return true;
+        }
+        return false;
+    }
+
+    void join(const size_t worker, FibTask& child)
+    {
+        while (!child.done.load(std::memory_order_acquire)) {
+            FibTask* task;
+            if (findWork(worker, task)) {
+                execute(worker, task);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void idle(const size_t worker)
+    {
+        while (!stop_.load(std::memory_order_acquire)) {
+            FibTask* task;
+            if (findWork(worker, task)) {
+                execute(worker, task);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+private:
+    std::vector<WorkStealingDeque<FibTask*>*> deques_;
+    std::atomic<bool> stop_;
+};
+
+} /// namespace
+
+/// Parallel Fibonacci on 1..hardware_concurrency workers.
+void
+benchForkJoin()
+{
+    size_t cores = std::thread::hardware_concurrency();
+    if (0 == cores) {
+        cores = 1;
+    }
+    std::printf("== Fork/join fib(%d), cutoff %d ==\n", FIB_N, CUTOFF);
+    std::printf("%-12s %12s %12s\n", "workers", "seconds", "speedup");
+    double baseline = 0.0;
+    /// Powers of two, then the maximum itself.
+    for (size_t workers = 1; ; workers = std::min(workers * 2, cores)) {
+        Scheduler scheduler(workers);
+        Timer timer;
+        const long result = scheduler.run(FIB_N);
+        const double elapsed = timer.seconds();
+        doNotOptimize(result);
+        if (1 == workers) {
+            baseline = elapsed;
+        }
+        std::printf("%-12lu %12.6f %12.2f\n", static_cast<unsigned long>(workers), elapsed, baseline / elapsed);
+        if (workers == cores) break;
+    }
+}
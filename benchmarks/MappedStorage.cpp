@@ -0,0 +1,92 @@
+#include "benchmarks/Benchmark.hpp"
+#include "headers/Deque.hpp"
+#include "headers/MappedDeque.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include <unistd.h>
+
+namespace {
+
+size_t
+environmentSize(const char* name, const size_t fallback)
+{
+    const char* text = std::getenv(name);
+    return text != NULL ? static_cast<size_t>(std::strtoull(text, NULL, 10)) : fallback;
+}
+
+/// Resident set of the process, including mapped file pages in memory.
+double
+residentMiB()
+{
+    long pages = 0;
+    long resident = 0;
+    std::FILE* statm = std::fopen("/proc/self/statm", "r");
+    if (statm != NULL) {
+        if (std::fscanf(statm, "%ld %ld", &pages, &resident) != 2) {
+            resident = 0;
+        }
+        std::fclose(statm);
+    }
+    return static_cast<double>(resident) * static_cast<double>(::sysconf(_SC_PAGESIZE)) / (1 << 20);
+}
+
+/// Pushes count elements, then drains them all with pop_front, checking
+/// the sum; prints MiB/s for both phases and the resident MiB in between.
+template <typename Queue>
+void
+stream(const char* name, Queue& queue, const size_t count)
+{
+    const double mib = static_cast<double>(count * sizeof(uint64_t)) / (1 << 20);
+    Timer timer;
+    for (size_t i = 0; i < count; ++i) {
+        queue.push_back(i);
+    }
+    const double pushSeconds = timer.seconds();
+    const double resident = residentMiB();
+
+    timer.reset();
+    uint64_t sum = 0;
+    while (!queue.empty()) {
+        sum += queue.front();
+        queue.pop_front();
+    }
+    const double popSeconds = timer.seconds();
+    const uint64_t expected = static_cast<uint64_t>(count) * (count - 1) / 2;
+    std::printf("%-24s %14.0f %14.0f %16.0f%s\n", name, mib / pushSeconds, mib / popSeconds, resident,
+                sum == expected ? "" : "  checksum mismatch");
+}
+
+} /// namespace
+
+/// Streams BENCH_MAPPED_BYTES (default 1 GiB) of uint64_t through a
+/// MappedDeque in BENCH_MAPPED_PATH (default ./mapped_deque.bench). Set it
+/// to ten times the RAM size for the larger-than-memory run; the file is
+/// removed afterwards.
+void
+benchMappedStorage()
+{
+    const size_t bytes = environmentSize("BENCH_MAPPED_BYTES", static_cast<size_t>(1) << 30);
+    const char* path = std::getenv("BENCH_MAPPED_PATH") != NULL ? std::getenv("BENCH_MAPPED_PATH") : "mapped_deque.bench";
+    const size_t ram = static_cast<size_t>(::sysconf(_SC_PHYS_PAGES)) * static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    const size_t count = bytes / sizeof(uint64_t);
+
+    std::printf("== Mapped storage (%.2f GiB of uint64_t through %s, RAM %.2f GiB) ==\n",
+                static_cast<double>(bytes) / (1 << 30), path, static_cast<double>(ram) / (1 << 30));
+    std::printf("%-24s %14s %14s %16s\n", "container", "push MiB/s", "drain MiB/s", "RSS after push");
+    if (2 * bytes < ram) {
+        Deque<uint64_t> heap;
+        stream("Deque (heap)", heap, count);
+    } else {
+        std::printf("%-24s %14s\n", "Deque (heap)", "skipped, does not fit in RAM");
+    }
+    std::remove(path);
+    {
+        MappedDeque<uint64_t> mapped(path);
+        stream("MappedDeque", mapped, count);
+    }
+    std::remove(path);
+}
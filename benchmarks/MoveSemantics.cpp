@@ -0,0 +1,55 @@
+#include "benchmarks/Benchmark.hpp"
+#include "headers/Deque.hpp"
+
+#include <cstdio>
+#include <string>
+#include <utility>
+
+namespace {
+
+void
+report(const char* name, const double seconds, const size_t count)
+{
+    std::printf("%-28s %12.6f %12.2f\n", name, seconds, seconds * 1e9 / static_cast<double>(count));
+}
+
+} /// namespace
+
+/// Enqueues large string payloads by copy, by move and by emplace. Only the
+/// copy path duplicates the payload.
+void
+benchMoveSemantics()
+{
+    const size_t count = 200000;
+    const std::string payload(4096, 'x');
+    std::printf("== Enqueue %lu x 4 KiB std::string ==\n", static_cast<unsigned long>(count));
+    std::printf("%-28s %12s %12s\n", "operation", "seconds", "ns/element");
+
+    {
+        Deque<std::string> queue;
+        Timer timer;
+        for (size_t i = 0; i < count; ++i) {
+            std::string message(payload);
+            queue.push_back(message);
+        }
+        report("push_back(const&)", timer.seconds(), count);
+    }
+    {
+        Deque<std::string> queue;
+        Timer timer;
+        for (size_t i = 0; i < count; ++i) {
+            std::string message(payload);
+            queue.push_back(std::move(message));
+        }
+        report("push_back(&&)", timer.seconds(), count);
+    }
+    {
+        Deque<std::string> queue;
+        Timer timer;
+        for (size_t i = 0; i < count; ++i) {
+            queue.emplace_back(payload.size(), 'x');
+        }
+        report("emplace_back(args...)", timer.seconds(), count);
+    }
+}
+
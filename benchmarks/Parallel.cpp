@@ -0,0 +1,129 @@
+#include "benchmarks/Benchmark.hpp"
+#include "headers/DequeParallel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <thread>
+
+namespace {
+
+size_t
+environmentSize(const char* name, const size_t fallback)
+{
+    const char* text = std::getenv(name);
+    return text != NULL ? static_cast<size_t>(std::strtoull(text, NULL, 10)) : fallback;
+}
+
+/// Enough arithmetic per element that the loop is not bound by memory
+/// bandwidth alone, so added cores have something to do.
+double
+work(const double value)
+{
+    return std::sqrt(value * value + 1.0);
+}
+
+struct Times
+{
+    double reduce;
+    double transform;
+    double forEach;
+};
+
+Times
+measure(ThreadPool& pool, Deque<double>& deque, Deque<double>& output, const size_t grain)
+{
+    Times times;
+    Timer timer;
+    const double sum = deque_parallel::reduce(pool, deque, 0.0, std::plus<double>(), grain);
+    times.reduce = timer.seconds();
+    doNotOptimize(sum);
+
+    timer.reset();
+    deque_parallel::transform(pool, deque, output, work, grain);
+    times.transform = timer.seconds();
+    doNotOptimize(output.back());
+
+    timer.reset();
+    deque_parallel::for_each(pool, output, [](double& value) { value = work(value); }, grain);
+    times.forEach = timer.seconds();
+    doNotOptimize(output.front());
+    return times;
+}
+
+void
+report(const char* label, const size_t threads, const Times& times, const Times& base, const size_t count)
+{
+    const double ns = 1e9 / static_cast<double>(count);
+    std::printf("%-24s %7lu %10.2f %7.2fx %10.2f %7.2fx %10.2f %7.2fx\n", label, static_cast<unsigned long>(threads),
+                times.reduce * ns, base.reduce / times.reduce,
+                times.transform * ns, base.transform / times.transform,
+                times.forEach * ns, base.forEach / times.forEach);
+}
+
+} /// namespace
+
+/// Scales reduce, transform and for_each over a split Deque<double> from
+/// one thread up to BENCH_PARALLEL_THREADS (default: every core), with
+/// BENCH_PARALLEL_ELEMENTS (default 20M) and BENCH_PARALLEL_GRAIN (default
+/// deque_parallel::DEFAULT_GRAIN). The serial rows use the iterator loops
+/// this replaces; speedups are against them.
+void
+benchParallel()
+{
+    const size_t count = environmentSize("BENCH_PARALLEL_ELEMENTS", 20000000);
+    const size_t cores = std::max<size_t>(1, std::thread::hardware_concurrency());
+    const size_t maxThreads = std::max<size_t>(1, environmentSize("BENCH_PARALLEL_THREADS", cores));
+    const size_t grain = std::max<size_t>(1, environmentSize("BENCH_PARALLEL_GRAIN", deque_parallel::DEFAULT_GRAIN));
+
+    Deque<double> deque;
+    for (size_t i = 0; i < count; ++i) {
+        if (i % 3 == 0) deque.push_front(static_cast<double>(i));
+        else            deque.push_back(static_cast<double>(i));
+    }
+    Deque<double> output;
+
+    std::printf("== Parallel (%lu doubles, grain %lu, %lu cores): ns per element and speedup over serial ==\n",
+                static_cast<unsigned long>(count), static_cast<unsigned long>(grain), static_cast<unsigned long>(cores));
+    std::printf("%-24s %7s %10s %8s %10s %8s %10s %8s\n", "variant", "threads",
+                "reduce", "", "transform", "", "for_each", "");
+
+    Times serial;
+    Timer timer;
+    const double sum = std::accumulate(deque.begin(), deque.end(), 0.0);
+    serial.reduce = timer.seconds();
+    doNotOptimize(sum);
+
+    timer.reset();
+    output.clear();
+    std::transform(deque.begin(), deque.end(), std::back_inserter(output), work);
+    serial.transform = timer.seconds();
+    doNotOptimize(output.back());
+
+    timer.reset();
+    for (Deque<double>::iterator it = output.begin(); it != output.end(); ++it) {
+        *it = work(*it);
+    }
+    serial.forEach = timer.seconds();
+    doNotOptimize(output.front());
+    report("serial iterators", 1, serial, serial, count);
+
+    /// Powers of two, then the maximum itself.
+    for (size_t threads = 1; ; threads = std::min(threads * 2, maxThreads)) {
+        ThreadPool pool(threads - 1);
+        report("deque_parallel", threads, measure(pool, deque, output, grain), serial, count);
+        if (threads == maxThreads) break;
+    }
+
+    ThreadPool pool(maxThreads - 1);
+    const size_t grains[] = { 1024, 16384, 65536, 1048576 };
+    for (size_t g = 0; g < sizeof(grains) / sizeof(grains[0]); ++g) {
+        char label[32];
+        std::snprintf(label, sizeof(label), "grain %lu", static_cast<unsigned long>(grains[g]));
+        report(label, maxThreads, measure(pool, deque, output, grains[g]), serial, count);
+    }
+}
@@ -0,0 +1,123 @@
+#include "benchmarks/Benchmark.hpp"
+#include "headers/BlockVector.hpp"
+#include "headers/DequeParallel.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <thread>
+#include <vector>
+
+namespace {
+
+size_t
+environmentSize(const char* name, const size_t fallback)
+{
+    const char* text = std::getenv(name);
+    return text != NULL ? static_cast<size_t>(std::strtoull(text, NULL, 10)) : fallback;
+}
+
+/// A third of the values pushed at the front, as a queue fed from both
+/// ends would hold them.
+template <typename Queue>
+void
+fill(Queue& queue, const std::vector<int>& values)
+{
+    queue.clear();
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (i % 3 == 0) queue.push_front(values[i]);
+        else            queue.push_back(values[i]);
+    }
+}
+
+template <typename Queue>
+void
+check(const Queue& queue, const std::vector<int>& sorted)
+{
+    if (!std::equal(sorted.begin(), sorted.end(), queue.begin())) {
+        std::printf("sort mismatch\n");
+    }
+}
+
+void
+report(const char* label, const size_t threads, const double seconds, const double base)
+{
+    std::printf("%-34s %7lu %10.1f %8.2fx\n", label, static_cast<unsigned long>(threads), seconds * 1e3, base / seconds);
+}
+
+} /// namespace
+
+/// Sorts BENCH_SORT_ELEMENTS random ints (default 10M) held in a split
+/// Deque: by copying out to a std::vector and back, with std::sort on the
+/// Deque and on a std::deque, and with deque_parallel::sort from one
+/// thread up to BENCH_SORT_THREADS (default: every core). Speedups are
+/// against the copy.
+void
+benchParallelSort()
+{
+    const size_t count = environmentSize("BENCH_SORT_ELEMENTS", 10000000);
+    const size_t cores = std::max<size_t>(1, std::thread::hardware_concurrency());
+    const size_t maxThreads = std::max<size_t>(1, environmentSize("BENCH_SORT_THREADS", cores));
+
+    std::vector<int> values(count);
+    size_t state = 12345;
+    for (size_t i = 0; i < count; ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        values[i] = static_cast<int>(state >> 33);
+    }
+    std::vector<int> sorted(values);
+    std::sort(sorted.begin(), sorted.end());
+
+    std::printf("== Parallel sort (%lu ints, %lu cores): milliseconds ==\n",
+                static_cast<unsigned long>(count), static_cast<unsigned long>(cores));
+    std::printf("%-34s %7s %10s %9s\n", "variant", "threads", "ms", "speedup");
+
+    Deque<int> deque;
+    fill(deque, values);
+    Timer timer;
+    {
+        std::vector<int> copy(deque.begin(), deque.end());
+        std::sort(copy.begin(), copy.end());
+        deque.clear();
+        for (size_t i = 0; i < copy.size(); ++i) {
+            deque.push_back(copy[i]);
+        }
+    }
+    const double base = timer.seconds();
+    check(deque, sorted);
+    report("copy + std::sort + push_back", 1, base, base);
+
+    fill(deque, values);
+    timer.reset();
+    std::sort(deque.begin(), deque.end());
+    report("std::sort on Deque", 1, timer.seconds(), base);
+    check(deque, sorted);
+
+    {
+        std::deque<int> standard;
+        fill(standard, values);
+        timer.reset();
+        std::sort(standard.begin(), standard.end());
+        report("std::sort on std::deque", 1, timer.seconds(), base);
+        check(standard, sorted);
+    }
+
+    for (size_t threads = 1; ; threads = std::min(threads * 2, maxThreads)) {
+        ThreadPool pool(threads - 1);
+        fill(deque, values);
+        timer.reset();
+        deque_parallel::sort(pool, deque);
+        report("deque_parallel::sort", threads, timer.seconds(), base);
+        check(deque, sorted);
+        if (threads == maxThreads) break;
+    }
+
+    ThreadPool pool(maxThreads - 1);
+    Deque<int, std::allocator<int>, BlockVector<int> > blocks;
+    fill(blocks, values);
+    timer.reset();
+    deque_parallel::sort(pool, blocks);
+    report("deque_parallel::sort, BlockVector", maxThreads, timer.seconds(), base);
+    check(blocks, sorted);
+}
@@ -0,0 +1,40 @@
+#include "benchmarks/Benchmark.hpp"
+#include "headers/Deque.hpp"
+
+#include <cstdio>
+
+namespace {
+
+/// Ingests batches of known size into fresh deques, with and without
+/// reserving the back half first.
+double
+measureIngest(const size_t batch, const size_t rounds, const bool reserve)
+{
+    Timer timer;
+    for (size_t r = 0; r < rounds; ++r) {
+        Deque<long> queue;
+        if (reserve) {
+            queue.reserve_back(batch);
+        }
+        for (size_t i = 0; i < batch; ++i) {
+            queue.push_back(static_cast<long>(i));
+        }
+        doNotOptimize(queue.back());
+    }
+    return timer.seconds() * 1e9 / static_cast<double>(batch * rounds);
+}
+
+} /// namespace
+
+void
+benchReserve()
+{
+    std::printf("== Batch ingest, reserve_back vs none ==\n");
+    std::printf("%-12s %16s %16s\n", "batch", "none (ns/elt)", "reserved (ns/elt)");
+    for (size_t batch = 64; batch <= 1048576; batch *= 16) {
+        const size_t rounds = 16777216 / batch;
+        const double none = measureIngest(batch, rounds, false);
+        const double reserved = measureIngest(batch, rounds, true);
+        std::printf("%-12lu %16.2f %16.2f\n", static_cast<unsigned long>(batch), none, reserved);
+    }
+}
@@ -0,0 +1,60 @@
+#include "benchmarks/Benchmark.hpp"
+#include "headers/Deque.hpp"
+#include "headers/RingDeque.hpp"
+
+#include <cstdio>
+#include <deque>
+
+namespace {
+
+/// Builds a queue with elements on both ends, then times repeated random
+/// access passes and iterator passes over it.
+template <typename Queue>
+void
+measureAccess(const char* name, const size_t count, const size_t passes)
+{
+    Queue queue;
+    for (size_t i = 0; i < count; ++i) {
+        if (0 == i % 2) {
+            queue.push_back(static_cast<int>(i));
+        } else {
+            queue.push_front(static_cast<int>(i));
+        }
+    }
+
+    Timer indexed;
+    long long sum = 0;
+    for (size_t pass = 0; pass < passes; ++pass) {
+        for (size_t i = 0; i < count; ++i) {
+            sum += queue[i];
+        }
+    }
+    const double indexedSeconds = indexed.seconds();
+
+    Timer iterated;
+    for (size_t pass = 0; pass < passes; ++pass) {
+        for (typename Queue::const_iterator it = queue.begin(); it != queue.end(); ++it) {
+            sum += *it;
+        }
+    }
+    const double iteratedSeconds = iterated.seconds();
+    doNotOptimize(sum);
+
+    const double elements = static_cast<double>(count * passes);
+    std::printf("%-16s %16.2f %16.2f\n", name, indexedSeconds * 1e9 / elements, iteratedSeconds * 1e9 / elements);
+}
+
+} /// namespace
+
+void
+benchRingStorage()
+{
+    const size_t count = 1000000;
+    const size_t passes = 20;
+    std::printf("== Random access and iteration (%lu elements) ==\n", static_cast<unsigned long>(count));
+    std::printf("%-16s %16s %16s\n", "container", "operator[] ns/el", "iterator ns/el");
+    measureAccess<Deque<int> >("Deque", count, passes);
+    measureAccess<RingDeque<int> >("RingDeque", count, passes);
+    measureAccess<std::deque<int> >("std::deque", count, passes);
+}
+
@@ -0,0 +1,72 @@
+#include "benchmarks/Benchmark.hpp"
+#include "headers/CircularDeque.hpp"
+#include "headers/Deque.hpp"
+#include "headers/RingDeque.hpp"
+
+#include <cstdio>
+#include <deque>
+
+namespace {
+
+/// Keeps a running sum over the last window samples the way callers do
+/// today: push_back, then pop_front once the window is full.
+template <typename Queue>
+void
+measureManual(const char* name, const size_t window, const size_t samples)
+{
+    Queue queue;
+    long long sum = 0;
+    long long checksum = 0;
+    Timer timer;
+    for (size_t i = 0; i < samples; ++i) {
+        const int sample = static_cast<int>(i * 2654435761u >> 20);
+        queue.push_back(sample);
+        sum += sample;
+        if (queue.size() > window) {
+            sum -= queue.front();
+            queue.pop_front();
+        }
+        checksum += sum;
+    }
+    const double seconds = timer.seconds();
+    doNotOptimize(checksum);
+    std::printf("%-28s %12.2f\n", name, seconds * 1e9 / static_cast<double>(samples));
+}
+
+/// The same sum with CircularDeque reporting the evicted sample.
+void
+measureCircular(const size_t window, const size_t samples)
+{
+    CircularDeque<int> queue(window);
+    long long sum = 0;
+    long long checksum = 0;
+    int evicted = 0;
+    Timer timer;
+    for (size_t i = 0; i < samples; ++i) {
+        const int sample = static_cast<int>(i * 2654435761u >> 20);
+        if (queue.push_back(sample, evicted)) {
+            sum -= evicted;
+        }
+        sum += sample;
+        checksum += sum;
+    }
+    const double seconds = timer.seconds();
+    doNotOptimize(checksum);
+    std::printf("%-28s %12.2f\n", "CircularDeque", seconds * 1e9 / static_cast<double>(samples));
+}
+
+} /// namespace
+
+void
+benchRollingWindow()
+{
+    const size_t window = 1000000;
+    const size_t samples = 50000000;
+    std::printf("== Rolling window (sum of the last %lu of %lu samples) ==\n",
+                static_cast<unsigned long>(window), static_cast<unsigned long>(samples));
+    std::printf("%-28s %12s\n", "container", "ns/sample");
+    measureManual<Deque<int> >("Deque push_back+pop_front", window, samples);
+    measureManual<RingDeque<int> >("RingDeque", window, samples);
+    measureManual<std::deque<int> >("std::deque", window, samples);
+    measureCircular(window, samples);
+}
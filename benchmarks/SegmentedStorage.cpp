@@ -0,0 +1,42 @@
+#include "benchmarks/Benchmark.hpp"
+#include "headers/BlockVector.hpp"
+#include "headers/Deque.hpp"
+
+#include <cstdio>
+
+namespace {
+
+/// Pushes count elements at the back and records the slowest single push,
+/// which is where a contiguous half pays for reallocating and copying itself.
+template <typename Queue>
+void
+measurePushStalls(const char* name, const size_t count)
+{
+    Queue queue;
+    double worst = 0.0;
+    Timer total;
+    for (size_t i = 0; i < count; ++i) {
+        Timer single;
+        queue.push_back(static_cast<int>(i));
+        const double elapsed = single.seconds();
+        if (elapsed > worst) {
+            worst = elapsed;
+        }
+    }
+    const double elapsed = total.seconds();
+    doNotOptimize(queue.back());
+    std::printf("%-24s %12.6f %16.2f\n", name, elapsed, worst * 1e6);
+}
+
+} /// namespace
+
+void
+benchSegmentedStorage()
+{
+    const size_t count = 8000000;
+    std::printf("== Push stalls (%lu x push_back) ==\n", static_cast<unsigned long>(count));
+    std::printf("%-24s %12s %16s\n", "storage", "seconds", "worst push (us)");
+    measurePushStalls<Deque<int> >("std::vector (default)", count);
+    measurePushStalls<Deque<int, std::allocator<int>, BlockVector<int> > >("BlockVector", count);
+}
+
@@ -0,0 +1,86 @@
+#include "benchmarks/Benchmark.hpp"
+#include "headers/BlockVector.hpp"
+#include "headers/Deque.hpp"
+
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+template <typename Queue>
+void
+measureSum(const char* name, const size_t count, const size_t passes)
+{
+    Queue queue;
+    for (size_t i = 0; i < count; ++i) {
+        queue.push_back(static_cast<int>(i));
+        queue.push_front(static_cast<int>(i));
+    }
+    const double elements = static_cast<double>(queue.size() * passes);
+
+    Timer timer;
+    long long sum = 0;
+    for (size_t pass = 0; pass < passes; ++pass) {
+        for (typename Queue::const_iterator it = queue.begin(); it != queue.end(); ++it) {
+            sum += *it;
+        }
+    }
+    const double iterated = timer.seconds();
+
+    timer.reset();
+    for (size_t pass = 0; pass < passes; ++pass) {
+        queue.for_each_segment([&sum](const int* data, const size_t size, bool) {
+            long long run = 0;
+            for (size_t i = 0; i < size; ++i) {
+                run += data[i];
+            }
+            sum += run;
+        });
+    }
+    const double segmented = timer.seconds();
+    doNotOptimize(sum);
+    std::printf("%-20s %16.3f %16.3f\n", name, iterated * 1e9 / elements, segmented * 1e9 / elements);
+}
+
+/// Hands a byte deque to writev through its segments, without copying.
+void
+measureWritev(const size_t bytes, const size_t rounds)
+{
+    Deque<char> buffer;
+    for (size_t i = 0; i < bytes / 2; ++i) {
+        buffer.push_back('b');
+        buffer.push_front('f');
+    }
+    buffer.normalize();
+    const int fd = ::open("/dev/null", O_WRONLY);
+    if (fd < 0) return;
+    Timer timer;
+    for (size_t r = 0; r < rounds; ++r) {
+        std::vector<iovec> vectors;
+        buffer.for_each_segment([&vectors](const char* data, const size_t size, bool) {
+            iovec vector = { const_cast<char*>(data), size };
+            vectors.push_back(vector);
+        });
+        doNotOptimize(::writev(fd, vectors.data(), static_cast<int>(vectors.size())));
+    }
+    const double elapsed = timer.seconds();
+    ::close(fd);
+    std::printf("%-20s %16.3f\n", "writev (us/call)", elapsed * 1e6 / static_cast<double>(rounds));
+}
+
+} /// namespace
+
+void
+benchSegments()
+{
+    const size_t count = 500000;
+    const size_t passes = 20;
+    std::printf("== Segment export (%lu ints) ==\n", static_cast<unsigned long>(2 * count));
+    std::printf("%-20s %16s %16s\n", "container", "iterator ns/el", "segments ns/el");
+    measureSum<Deque<int> >("Deque", count, passes);
+    measureSum<Deque<int, std::allocator<int>, BlockVector<int> > >("Deque<BlockVector>", count, passes);
+    measureWritev(1 << 20, 1000);
+}
@@ -0,0 +1,126 @@
+#include "benchmarks/Benchmark.hpp"
+#include "headers/Deque.hpp"
+#include "headers/DequeSerialization.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+size_t
+environmentSize(const char* name, const size_t fallback)
+{
+    const char* text = std::getenv(name);
+    return text != NULL ? static_cast<size_t>(std::strtoull(text, NULL, 10)) : fallback;
+}
+
+void
+report(const char* name, const double seconds, const size_t bytes)
+{
+    std::printf("%-36s %10.3f %12.0f\n", name, seconds, static_cast<double>(bytes) / (1 << 20) / seconds);
+}
+
+} /// namespace
+
+/// Saves and restores a Deque<uint64_t> of BENCH_SNAPSHOT_ELEMENTS (default
+/// 100M, 800 MB) elements, a third of them in the front half, to
+/// BENCH_SNAPSHOT_PATH (default ./deque_snapshot.bench, removed afterwards).
+/// The baseline writes and reads element by element through iterators and
+/// push_back. Timings include the page cache, not the disk.
+void
+benchSerialization()
+{
+    const size_t count = environmentSize("BENCH_SNAPSHOT_ELEMENTS", 100000000);
+    const char* path = std::getenv("BENCH_SNAPSHOT_PATH") != NULL ? std::getenv("BENCH_SNAPSHOT_PATH")
+                                                                   : "deque_snapshot.bench";
+    const size_t bytes = count * sizeof(uint64_t);
+    Deque<uint64_t> deque;
+    deque.reserve_front(count / 3 + 1);
+    deque.reserve_back(count - count / 3);
+    for (size_t i = 0; i < count; ++i) {
+        if (i % 3 == 0) deque.push_front(i);
+        else            deque.push_back(i);
+    }
+
+    std::printf("== Serialization (%lu uint64_t, %s) ==\n", static_cast<unsigned long>(count), path);
+    std::printf("%-36s %10s %12s\n", "operation", "seconds", "MiB/s");
+    Timer timer;
+    {
+        std::ofstream out(path, std::ios::binary);
+        for (Deque<uint64_t>::const_iterator it = deque.begin(); it != deque.end(); ++it) {
+            out.write(reinterpret_cast<const char*>(&*it), sizeof(uint64_t));
+        }
+    }
+    report("save element by element", timer.seconds(), bytes);
+
+    timer.reset();
+    {
+        std::ifstream in(path, std::ios::binary);
+        Deque<uint64_t> restored;
+        uint64_t value;
+        while (in.read(reinterpret_cast<char*>(&value), sizeof(value))) {
+            restored.push_back(value);
+        }
+        doNotOptimize(restored.back());
+    }
+    report("load element by element (push_back)", timer.seconds(), bytes);
+
+    timer.reset();
+    {
+        std::ofstream out(path, std::ios::binary);
+        save(deque, out);
+    }
+    report("save(std::ostream)", timer.seconds(), bytes);
+
+    timer.reset();
+    {
+        std::ifstream in(path, std::ios::binary);
+        Deque<uint64_t> restored;
+        load(restored, in);
+        doNotOptimize(restored.back());
+    }
+    report("load(std::istream)", timer.seconds(), bytes);
+
+    timer.reset();
+    {
+        const int descriptor = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        save(deque, descriptor);
+        ::close(descriptor);
+    }
+    report("save(fd)", timer.seconds(), bytes);
+
+    timer.reset();
+    bool same = false;
+    {
+        const int descriptor = ::open(path, O_RDONLY);
+        Deque<uint64_t> restored;
+        load(restored, descriptor);
+        ::close(descriptor);
+        const double seconds = timer.seconds();
+        report("load(fd)", seconds, bytes);
+        same = restored == deque;
+    }
+
+    timer.reset();
+    DequeView<uint64_t> view(path);
+    report("DequeView open", timer.seconds(), bytes);
+    timer.reset();
+    uint64_t sum = 0;
+    view.for_each_segment([&sum](const uint64_t* data, const size_t size, bool) {
+        for (size_t i = 0; i < size; ++i) {
+            sum += data[i];
+        }
+    });
+    report("DequeView sum of every element", timer.seconds(), bytes);
+    doNotOptimize(sum);
+    if (!same || sum != static_cast<uint64_t>(count) * (count - 1) / 2) {
+        std::printf("round trip mismatch\n");
+    }
+    std::remove(path);
+}
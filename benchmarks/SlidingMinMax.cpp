@@ -0,0 +1,106 @@
+#include "benchmarks/Benchmark.hpp"
+#include "headers/Deque.hpp"
+#include "headers/MonotonicDeque.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+/// Elements scanned by the naive rescan per window size; its ticks are
+/// capped to this budget, since a 1M window over 10M ticks is 10^13 steps.
+const size_t RESCAN_BUDGET = 200000000;
+
+std::vector<int>
+makeStream(const size_t count)
+{
+    std::vector<int> stream(count);
+    size_t state = 42;
+    for (size_t i = 0; i < count; ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        stream[i] = static_cast<int>(state >> 40);
+    }
+    return stream;
+}
+
+/// ns per tick of keeping a Deque window and rescanning it for min and max.
+double
+measureRescan(const std::vector<int>& stream, const size_t window)
+{
+    Deque<int> queue;
+    const size_t warmup = std::min(window, stream.size());
+    for (size_t i = 0; i < warmup; ++i) {
+        queue.push_back(stream[i]);
+    }
+    const size_t ticks = std::min(stream.size() - warmup, std::max<size_t>(RESCAN_BUDGET / window, 1));
+    long long sum = 0;
+    Timer timer;
+    for (size_t i = warmup; i < warmup + ticks; ++i) {
+        queue.push_back(stream[i]);
+        queue.pop_front();
+        sum += *std::min_element(queue.begin(), queue.end());
+        sum += *std::max_element(queue.begin(), queue.end());
+    }
+    const double seconds = timer.seconds();
+    doNotOptimize(sum);
+    return seconds * 1e9 / static_cast<double>(ticks);
+}
+
+/// ns per tick of the count window over the whole stream.
+double
+measureCount(const std::vector<int>& stream, const size_t window)
+{
+    MonotonicDeque<int> extremes;
+    long long sum = 0;
+    Timer timer;
+    for (size_t i = 0; i < stream.size(); ++i) {
+        extremes.push(stream[i]);
+        extremes.keep_last(window);
+        sum += extremes.min() + extremes.max();
+    }
+    const double seconds = timer.seconds();
+    doNotOptimize(sum);
+    return seconds * 1e9 / static_cast<double>(stream.size());
+}
+
+/// ns per tick of a time window whose ticks arrive 1 to 3 time units apart,
+/// 2 on average, so it spans about window ticks.
+double
+measureTime(const std::vector<int>& stream, const size_t window)
+{
+    MonotonicDeque<int> extremes;
+    long long sum = 0;
+    unsigned long long now = 0;
+    Timer timer;
+    for (size_t i = 0; i < stream.size(); ++i) {
+        now += 1 + (stream[i] & 1) * 2;
+        extremes.push(stream[i], now);
+        if (now >= 2 * window) {
+            extremes.expire_older_than(now - 2 * window + 1);
+        }
+        sum += extremes.min() + extremes.max();
+    }
+    const double seconds = timer.seconds();
+    doNotOptimize(sum);
+    return seconds * 1e9 / static_cast<double>(stream.size());
+}
+
+} /// namespace
+
+void
+benchSlidingMinMax()
+{
+    const size_t count = 10000000;
+    const std::vector<int> stream = makeStream(count);
+    std::printf("== Sliding min/max over %lu ticks (rescan capped at %lu scanned elements) ==\n",
+                static_cast<unsigned long>(count), static_cast<unsigned long>(RESCAN_BUDGET));
+    std::printf("%10s %16s %16s %16s %10s\n", "window", "rescan ns/tick", "count ns/tick", "time ns/tick", "speedup");
+    for (size_t window = 16; window <= 1048576; window *= 16) {
+        const double rescan = measureRescan(stream, window);
+        const double counted = measureCount(stream, window);
+        const double timed = measureTime(stream, window);
+        std::printf("%10lu %16.2f %16.2f %16.2f %9.0fx\n", static_cast<unsigned long>(window),
+                    rescan, counted, timed, rescan / counted);
+    }
+}
@@ -0,0 +1,91 @@
+#include "benchmarks/Benchmark.hpp"
+#include "headers/Deque.hpp"
+#include "headers/SmallDeque.hpp"
+
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace {
+
+size_t allocations = 0;
+
+/// std::allocator that counts calls to allocate.
+template <typename T>
+struct CountedAllocator : std::allocator<T>
+{
+    typedef T value_type;
+    template <typename U>
+    struct rebind { typedef CountedAllocator<U> other; };
+
+    CountedAllocator() {}
+    template <typename U>
+    CountedAllocator(const CountedAllocator<U>&) {}
+
+    T* allocate(const size_t count)
+    {
+        ++allocations;
+        return std::allocator<T>::allocate(count);
+    }
+};
+
+/// Creates, fills at both ends, drains and destroys count deques of up to
+/// six elements, then keeps count of them alive and sums them in one pass.
+template <typename Queue>
+void
+measure(const char* name, const size_t count)
+{
+    allocations = 0;
+    Timer timer;
+    long long sum = 0;
+    for (size_t i = 0; i < count; ++i) {
+        Queue queue;
+        const int length = static_cast<int>(i % 7);
+        for (int k = 0; k < length; ++k) {
+            if (k & 1) queue.push_front(k);
+            else       queue.push_back(k);
+        }
+        while (!queue.empty()) {
+            sum += queue.front();
+            queue.pop_front();
+        }
+    }
+    const double churned = timer.seconds();
+    const double perDeque = static_cast<double>(allocations) / static_cast<double>(count);
+
+    const size_t live = count / 10;
+    std::vector<Queue> queues(live);
+    for (size_t i = 0; i < live; ++i) {
+        for (int k = 0; k < 4; ++k) {
+            queues[i].push_back(static_cast<int>(i) + k);
+        }
+    }
+    timer.reset();
+    for (int pass = 0; pass < 10; ++pass) {
+        for (size_t i = 0; i < live; ++i) {
+            for (typename Queue::const_iterator it = queues[i].begin(); it != queues[i].end(); ++it) {
+                sum += *it;
+            }
+        }
+    }
+    const double scanned = timer.seconds();
+    doNotOptimize(sum);
+    std::printf("%-24s %16.1f %16.2f %16.1f\n", name,
+                churned * 1e9 / static_cast<double>(count), perDeque,
+                scanned * 1e9 / static_cast<double>(10 * live));
+}
+
+} /// namespace
+
+void
+benchSmallBuffer()
+{
+    const size_t count = 3000000;
+    std::printf("== Short-lived deques (%lu deques of 0-6 ints) ==\n", static_cast<unsigned long>(count));
+    std::printf("%-24s %16s %16s %16s\n", "container", "ns/deque", "allocs/deque", "scan ns/deque");
+    measure<std::deque<int, CountedAllocator<int> > >("std::deque", count);
+    measure<Deque<int, CountedAllocator<int> > >("Deque", count);
+    measure<SmallDeque<int, 4, CountedAllocator<int> > >("SmallDeque<int, 4>", count);
+    measure<SmallDeque<int, 8, CountedAllocator<int> > >("SmallDeque<int, 8>", count);
+}
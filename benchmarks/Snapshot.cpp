@@ -0,0 +1,62 @@
+#include "benchmarks/Benchmark.hpp"
+#include "headers/BlockVector.hpp"
+#include "headers/Deque.hpp"
+
+#include <cstdio>
+#include <deque>
+
+namespace {
+
+/// Order-book style level: trivially copyable, so halves copy with memmove.
+struct Level
+{
+    double price;
+    long   quantity;
+};
+
+/// Copy-constructs and copy-assigns snapshots of a deque split across both
+/// halves, as a per-tick snapshot would.
+template <typename Queue>
+void
+measureSnapshot(const char* name, const size_t size, const size_t rounds)
+{
+    Queue book;
+    for (size_t i = 0; i < size / 2; ++i) {
+        const Level level = { static_cast<double>(i), static_cast<long>(i) };
+        book.push_back(level);
+        book.push_front(level);
+    }
+
+    Timer timer;
+    for (size_t r = 0; r < rounds; ++r) {
+        Queue snapshot(book);
+        doNotOptimize(snapshot.back());
+    }
+    const double constructed = timer.seconds();
+
+    Queue snapshot;
+    timer.reset();
+    for (size_t r = 0; r < rounds; ++r) {
+        snapshot = book;
+        doNotOptimize(snapshot.back());
+    }
+    const double assigned = timer.seconds();
+
+    std::printf("%-24s %14.2f %14.2f\n", name,
+                constructed * 1e6 / static_cast<double>(rounds), assigned * 1e6 / static_cast<double>(rounds));
+}
+
+} /// namespace
+
+void
+benchSnapshot()
+{
+    const size_t size = 100000;
+    const size_t rounds = 1000;
+    std::printf("== Snapshot a %lu-level deque (%lu rounds) ==\n",
+                static_cast<unsigned long>(size), static_cast<unsigned long>(rounds));
+    std::printf("%-24s %14s %14s\n", "container", "copy ctor (us)", "operator= (us)");
+    measureSnapshot<Deque<Level> >("Deque", size, rounds);
+    measureSnapshot<Deque<Level, std::allocator<Level>, BlockVector<Level> > >("Deque<BlockVector>", size, rounds);
+    measureSnapshot<std::deque<Level> >("std::deque", size, rounds);
+}
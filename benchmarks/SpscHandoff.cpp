@@ -0,0 +1,125 @@
+#include "benchmarks/Benchmark.hpp"
+#include "headers/Deque.hpp"
+#include "headers/SpscDeque.hpp"
+
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+const long COUNT = 10000000;
+const size_t BATCH = 64;
+
+void
+report(const char* name, const double seconds)
+{
+    std::printf("%-28s %12.6f %12.2f\n", name, seconds, static_cast<double>(COUNT) / seconds * 1e-6);
+}
+
+/// The hand-off this replaces: a Deque behind one mutex.
+void
+measureMutexDeque()
+{
+    Deque<long> queue;
+    std::mutex mutex;
+    Timer timer;
+    std::thread producer([&queue, &mutex]() {
+        for (long i = 0; i < COUNT; ++i) {
+            std::lock_guard<std::mutex> lock(mutex);
+            queue.push_back(i);
+        }
+    });
+    long sum = 0;
+    for (long received = 0; received < COUNT;) {
+        std::lock_guard<std::mutex> lock(mutex);
+        while (!queue.empty()) {
+            sum += queue.front();
+            queue.pop_front();
+            ++received;
+        }
+    }
+    producer.join();
+    doNotOptimize(sum);
+    report("mutex + Deque", timer.seconds());
+}
+
+void
+measureSpsc()
+{
+    SpscDeque<long> queue(4096);
+    Timer timer;
+    std::thread producer([&queue]() {
+        for (long i = 0; i < COUNT;) {
+            if (queue.try_push_back(i)) {
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    long sum = 0;
+    for (long received = 0; received < COUNT;) {
+        long value;
+        if (queue.try_pop_front(value)) {
+            sum += value;
+            ++received;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    doNotOptimize(sum);
+    report("SpscDeque", timer.seconds());
+}
+
+void
+measureSpscBatched()
+{
+    SpscDeque<long> queue(4096);
+    Timer timer;
+    std::thread producer([&queue]() {
+        long batch[BATCH];
+        for (long i = 0; i < COUNT;) {
+            const long limit = COUNT - i < static_cast<long>(BATCH) ? COUNT - i : static_cast<long>(BATCH);
+            for (long j = 0; j < limit; ++j) {
+                batch[j] = i + j;
+            }
+            const size_t pushed = queue.try_push_back_n(batch, static_cast<size_t>(limit));
+            if (0 == pushed) {
+                std::this_thread::yield();
+            }
+            i += static_cast<long>(pushed);
+        }
+    });
+    long sum = 0;
+    long batch[BATCH];
+    for (long received = 0; received < COUNT;) {
+        const size_t popped = queue.try_pop_front_n(batch, BATCH);
+        for (size_t j = 0; j < popped; ++j) {
+            sum += batch[j];
+        }
+        if (0 == popped) {
+            std::this_thread::yield();
+        }
+        received += static_cast<long>(popped);
+    }
+    producer.join();
+    doNotOptimize(sum);
+    report("SpscDeque batched (64)", timer.seconds());
+}
+
+} /// namespace
+
+/// One producer thread hands COUNT longs to one consumer thread. A side that
+/// finds the queue full or empty yields, so the benchmark also makes
+/// progress on machines with fewer cores than threads.
+void
+benchSpscHandoff()
+{
+    std::printf("== Two-thread hand-off of %ld longs ==\n", COUNT);
+    std::printf("%-28s %12s %12s\n", "queue", "seconds", "Mitems/s");
+    measureMutexDeque();
+    measureSpsc();
+    measureSpscBatched();
+}
@@ -0,0 +1,71 @@
+#include "benchmarks/Benchmark.hpp"
+#include "headers/BlockVector.hpp"
+#include "headers/Deque.hpp"
+#include "headers/DequeStatistics.hpp"
+
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+
+/// A sliding window: every step pushes at the back, every eighth also at
+/// the front, and the front is popped down to 1000 elements, so growth,
+/// rebalancing and the peak size all move.
+template <typename Queue>
+double
+churn(Queue& queue, const size_t steps)
+{
+    Timer timer;
+    long long sum = 0;
+    for (size_t i = 0; i < steps; ++i) {
+        queue.push_back(static_cast<int>(i));
+        if (0 == (i & 7)) {
+            queue.push_front(static_cast<int>(i));
+        }
+        while (queue.size() > 1000) {
+            sum += queue.front();
+            queue.pop_front();
+        }
+    }
+    const double seconds = timer.seconds();
+    doNotOptimize(sum);
+    return seconds * 1e9 / static_cast<double>(steps);
+}
+
+template <typename Storage>
+void
+measure(const char* name, const size_t steps)
+{
+    Deque<int, std::allocator<int>, Storage> plain;
+    Deque<int, std::allocator<int>, Storage, DequeStatistics> counted;
+    counted.statistics().set_name(name);
+    const double plainNs = churn(plain, steps);
+    const double countedNs = churn(counted, steps);
+    const DequeCounters counters = counted.statistics().counters();
+    std::printf("%-14s %16.2f %16.2f %10.1f%% %10llu %10llu %12llu\n", name, plainNs, countedNs,
+                (countedNs / plainNs - 1) * 100, counters.reallocations, counters.rebalances, counters.elementsMoved);
+}
+
+} /// namespace
+
+/// Cost of DequeStatistics over the default NoStatistics on the hot paths,
+/// followed by a dump of the registry while the counted deques are alive.
+void
+benchStatistics()
+{
+    const size_t steps = 20000000;
+    std::printf("== Statistics policy (%lu steps of a sliding window of 1000 ints) ==\n", static_cast<unsigned long>(steps));
+    std::printf("%-14s %16s %16s %11s %10s %10s %12s\n", "storage", "none ns/step", "counted ns/step", "overhead",
+                "reallocs", "rebalances", "moved");
+    measure<std::vector<int> >("std::vector", steps);
+    measure<BlockVector<int> >("BlockVector", steps);
+
+    Deque<int, std::allocator<int>, std::vector<int>, DequeStatistics> live;
+    live.statistics().set_name("live");
+    churn(live, 100000);
+    std::printf("registry dump:\n");
+    DequeStatisticsRegistry::instance().dump(std::cout);
+    std::cout.flush();
+}
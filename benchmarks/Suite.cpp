@@ -0,0 +1,315 @@
+#include "benchmarks/Benchmark.hpp"
+#include "headers/Deque.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iterator>
+#include <list>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Pod256
+{
+    unsigned char bytes[256];
+};
+
+template <typename Value>
+Value
+makeValue(const size_t i)
+{
+    return static_cast<Value>(i);
+}
+
+/// Long enough to live on the heap rather than in the small-string buffer.
+template <>
+std::string
+makeValue<std::string>(const size_t i)
+{
+    return "deque-benchmark-" + std::to_string(i);
+}
+
+template <>
+Pod256
+makeValue<Pod256>(const size_t i)
+{
+    Pod256 pod;
+    std::memset(pod.bytes, static_cast<int>(i), sizeof(pod.bytes));
+    return pod;
+}
+
+size_t checksum(const int value)           { return static_cast<size_t>(value); }
+size_t checksum(const std::string& value)  { return value.size() + static_cast<unsigned char>(value.back()); }
+size_t checksum(const Pod256& value)       { return value.bytes[0]; }
+
+enum Operation {
+    PUSH_BACK, PUSH_FRONT, POP_BACK, POP_FRONT, RANDOM_ACCESS,
+    ITERATE, INSERT_MIDDLE, ERASE_MIDDLE, COPY, RESIZE, OPERATIONS
+};
+
+const char* const OPERATION_NAMES[OPERATIONS] = {
+    "push_back", "push_front", "pop_back", "pop_front", "random_access",
+    "iterate", "insert_middle", "erase_middle", "copy", "resize"
+};
+
+const char* const CONTAINER_NAMES[] = { "Deque", "std::deque", "std::vector", "std::list" };
+const size_t CONTAINERS = sizeof(CONTAINER_NAMES) / sizeof(CONTAINER_NAMES[0]);
+
+/// Elements touched per measurement; small sizes are repeated over many
+/// containers to reach it.
+const size_t BUDGET = 1 << 18;
+
+/// Operations a container lacks (push_front on std::vector, operator[] on
+/// std::list) are detected here and reported as skipped.
+template <typename Queue>
+auto pushFront(Queue& queue, const typename Queue::value_type& value, int) -> decltype(queue.push_front(value), bool())
+{
+    queue.push_front(value);
+    return true;
+}
+
+template <typename Queue>
+bool pushFront(Queue&, const typename Queue::value_type&, long) { return false; }
+
+template <typename Queue>
+auto popFront(Queue& queue, int) -> decltype(queue.pop_front(), bool())
+{
+    queue.pop_front();
+    return true;
+}
+
+template <typename Queue>
+bool popFront(Queue&, long) { return false; }
+
+template <typename Queue>
+auto hasIndex(const Queue& queue, int) -> decltype(queue[0], bool()) { return true; }
+
+template <typename Queue>
+bool hasIndex(const Queue&, long) { return false; }
+
+template <typename Queue>
+auto element(const Queue& queue, const size_t index, int) -> decltype(queue[index])
+{
+    return queue[index];
+}
+
+template <typename Queue>
+const typename Queue::value_type& element(const Queue& queue, const size_t index, long)
+{
+    return *std::next(queue.begin(), index);
+}
+
+template <typename Queue>
+typename Queue::iterator
+middle(Queue& queue)
+{
+    typename Queue::iterator it = queue.begin();
+    std::advance(it, queue.size() / 2);
+    return it;
+}
+
+template <typename Queue>
+void
+fill(Queue& queue, const std::vector<typename Queue::value_type>& values)
+{
+    for (size_t i = 0; i < values.size(); ++i) {
+        queue.push_back(values[i]);
+    }
+}
+
+/// Runs every operation on batch containers of size elements and stores
+/// ns per element operation, or a negative value when skipped.
+template <typename Queue>
+void
+measureContainer(const std::vector<typename Queue::value_type>& values, double (&result)[OPERATIONS])
+{
+    typedef typename Queue::value_type Value;
+    const size_t size = values.size();
+    const size_t batch = size < BUDGET ? BUDGET / size : 1;
+    const size_t middleOps = batch < 16 ? 16 / batch : 1;
+    const Value value = values[size / 2];
+    size_t sink = 0;
+    Timer timer;
+
+    {
+        std::vector<Queue> queues(batch);
+        timer.reset();
+        for (size_t b = 0; b < batch; ++b) {
+            fill(queues[b], values);
+        }
+        result[PUSH_BACK] = timer.seconds() * 1e9 / static_cast<double>(batch * size);
+
+        timer.reset();
+        for (size_t b = 0; b < batch; ++b) {
+            while (!queues[b].empty()) {
+                sink += checksum(queues[b].back());
+                queues[b].pop_back();
+            }
+        }
+        result[POP_BACK] = timer.seconds() * 1e9 / static_cast<double>(batch * size);
+    }
+    {
+        std::vector<Queue> queues(batch);
+        bool supported = true;
+        timer.reset();
+        for (size_t b = 0; b < batch && supported; ++b) {
+            for (size_t i = 0; i < size && supported; ++i) {
+                supported = pushFront(queues[b], values[i], 0);
+            }
+        }
+        result[PUSH_FRONT] = supported ? timer.seconds() * 1e9 / static_cast<double>(batch * size) : -1;
+
+        timer.reset();
+        for (size_t b = 0; b < batch && supported; ++b) {
+            while (!queues[b].empty()) {
+                sink += checksum(queues[b].front());
+                popFront(queues[b], 0);
+            }
+        }
+        result[POP_FRONT] = supported ? timer.seconds() * 1e9 / static_cast<double>(batch * size) : -1;
+    }
+    {
+        Queue queue;
+        fill(queue, values);
+        result[RANDOM_ACCESS] = -1;
+        if (hasIndex(queue, 0)) {
+            std::vector<size_t> indices(BUDGET);
+            size_t state = 12345;
+            for (size_t i = 0; i < indices.size(); ++i) {
+                state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+                indices[i] = (state >> 33) % size;
+            }
+            timer.reset();
+            for (size_t i = 0; i < indices.size(); ++i) {
+                sink += checksum(element(queue, indices[i], 0));
+            }
+            result[RANDOM_ACCESS] = timer.seconds() * 1e9 / static_cast<double>(indices.size());
+        }
+
+        timer.reset();
+        for (size_t b = 0; b < batch; ++b) {
+            for (typename Queue::const_iterator it = queue.begin(); it != queue.end(); ++it) {
+                sink += checksum(*it);
+            }
+        }
+        result[ITERATE] = timer.seconds() * 1e9 / static_cast<double>(batch * size);
+
+        timer.reset();
+        for (size_t b = 0; b < batch; ++b) {
+            Queue copy(queue);
+            sink += copy.size();
+        }
+        result[COPY] = timer.seconds() * 1e9 / static_cast<double>(batch * size);
+    }
+    {
+        std::vector<Queue> queues(batch);
+        for (size_t b = 0; b < batch; ++b) {
+            fill(queues[b], values);
+        }
+        timer.reset();
+        for (size_t b = 0; b < batch; ++b) {
+            for (size_t k = 0; k < middleOps; ++k) {
+                queues[b].insert(middle(queues[b]), value);
+            }
+        }
+        result[INSERT_MIDDLE] = timer.seconds() * 1e9 / static_cast<double>(batch * middleOps);
+
+        timer.reset();
+        for (size_t b = 0; b < batch; ++b) {
+            for (size_t k = 0; k < middleOps; ++k) {
+                queues[b].erase(middle(queues[b]));
+            }
+        }
+        result[ERASE_MIDDLE] = timer.seconds() * 1e9 / static_cast<double>(batch * middleOps);
+    }
+    {
+        timer.reset();
+        for (size_t b = 0; b < batch; ++b) {
+            Queue queue;
+            queue.resize(size);
+            queue.resize(size / 2);
+            sink += queue.size();
+        }
+        result[RESIZE] = timer.seconds() * 1e9 / static_cast<double>(batch * size);
+    }
+    doNotOptimize(sink);
+}
+
+size_t
+environmentSize(const char* name, const size_t fallback)
+{
+    const char* text = std::getenv(name);
+    return text != NULL ? static_cast<size_t>(std::strtoull(text, NULL, 10)) : fallback;
+}
+
+template <typename Value>
+void
+measureType(const char* typeName, std::FILE* csv, const size_t maxSize, const size_t maxBytes)
+{
+    for (size_t size = 10; size <= maxSize; size *= 10) {
+        /// a container, a copy and a batch of the same size, with list nodes
+        if (3 * size * (sizeof(Value) + 48) > maxBytes) {
+            std::printf("%-12s %10lu  skipped, over BENCH_MAX_BYTES\n", typeName, static_cast<unsigned long>(size));
+            continue;
+        }
+        std::vector<Value> values;
+        for (size_t i = 0; i < size; ++i) {
+            values.push_back(makeValue<Value>(i));
+        }
+        double results[CONTAINERS][OPERATIONS];
+        measureContainer<Deque<Value> >(values, results[0]);
+        measureContainer<std::deque<Value> >(values, results[1]);
+        measureContainer<std::vector<Value> >(values, results[2]);
+        measureContainer<std::list<Value> >(values, results[3]);
+
+        for (size_t op = 0; op < OPERATIONS; ++op) {
+            std::printf("%-12s %10lu %-14s", typeName, static_cast<unsigned long>(size), OPERATION_NAMES[op]);
+            for (size_t c = 0; c < CONTAINERS; ++c) {
+                if (results[c][op] < 0) {
+                    std::printf(" %12s", "-");
+                    continue;
+                }
+                std::printf(" %12.2f", results[c][op]);
+                if (csv != NULL) {
+                    std::fprintf(csv, "%s,%s,%s,%lu,%.3f\n", typeName, CONTAINER_NAMES[c], OPERATION_NAMES[op],
+                                 static_cast<unsigned long>(size), results[c][op]);
+                }
+            }
+            std::printf("\n");
+        }
+    }
+}
+
+} /// namespace
+
+/// Sizes run from 10 up to BENCH_MAX_SIZE (default 1M; 10M for the full
+/// sweep), skipping any size whose working set would pass BENCH_MAX_BYTES.
+/// Results are also written as CSV to BENCH_CSV (default bench_results.csv).
+void
+benchSuite()
+{
+    const size_t maxSize = environmentSize("BENCH_MAX_SIZE", 1000000);
+    const size_t maxBytes = environmentSize("BENCH_MAX_BYTES", static_cast<size_t>(2) << 30);
+    const char* csvPath = std::getenv("BENCH_CSV") != NULL ? std::getenv("BENCH_CSV") : "bench_results.csv";
+    std::FILE* csv = std::fopen(csvPath, "w");
+    if (csv != NULL) {
+        std::fprintf(csv, "type,container,operation,size,ns_per_op\n");
+    }
+
+    std::printf("== Suite: ns per element operation, sizes 10..%lu (CSV: %s) ==\n",
+                static_cast<unsigned long>(maxSize), csv != NULL ? csvPath : "not written");
+    std::printf("%-12s %10s %-14s", "type", "size", "operation");
+    for (size_t c = 0; c < CONTAINERS; ++c) {
+        std::printf(" %12s", CONTAINER_NAMES[c]);
+    }
+    std::printf("\n");
+    measureType<int>("int", csv, maxSize, maxBytes);
+    measureType<std::string>("std::string", csv, maxSize, maxBytes);
+    measureType<Pod256>("pod256", csv, maxSize, maxBytes);
+    if (csv != NULL) {
+        std::fclose(csv);
+    }
+}
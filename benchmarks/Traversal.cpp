@@ -0,0 +1,70 @@
+#include "benchmarks/Benchmark.hpp"
+#include "headers/BlockVector.hpp"
+#include "headers/Deque.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <iterator>
+
+namespace {
+
+/// Times the algorithms that need random-access iterators to run in
+/// O(n log n) / O(log n): std::sort, std::lower_bound and std::distance,
+/// plus a plain iterator pass.
+template <typename Queue>
+void
+measureTraversal(const char* name, const size_t count)
+{
+    Queue queue;
+    for (size_t i = 0; i < count; ++i) {
+        const int value = static_cast<int>((i * 2654435761u) % count);
+        if (0 == i % 2) {
+            queue.push_back(value);
+        } else {
+            queue.push_front(value);
+        }
+    }
+
+    Timer timer;
+    long long sum = 0;
+    for (typename Queue::const_iterator it = queue.begin(); it != queue.end(); ++it) {
+        sum += *it;
+    }
+    const double iterated = timer.seconds();
+
+    timer.reset();
+    std::sort(queue.begin(), queue.end());
+    const double sorted = timer.seconds();
+
+    const size_t lookups = 1000000;
+    timer.reset();
+    for (size_t i = 0; i < lookups; ++i) {
+        sum += *std::lower_bound(queue.begin(), queue.end(), static_cast<int>((i * 40503u) % count));
+    }
+    const double searched = timer.seconds();
+
+    timer.reset();
+    for (size_t i = 0; i < lookups; ++i) {
+        sum += std::distance(queue.begin(), queue.end() - static_cast<std::ptrdiff_t>(i % count));
+    }
+    const double measured = timer.seconds();
+    doNotOptimize(sum);
+
+    std::printf("%-20s %14.2f %14.2f %14.2f %14.2f\n", name,
+                iterated * 1e9 / static_cast<double>(count), sorted * 1e3,
+                searched * 1e9 / static_cast<double>(lookups), measured * 1e9 / static_cast<double>(lookups));
+}
+
+} /// namespace
+
+void
+benchTraversal()
+{
+    const size_t count = 1000000;
+    std::printf("== Iterator algorithms (%lu ints) ==\n", static_cast<unsigned long>(count));
+    std::printf("%-20s %14s %14s %14s %14s\n", "container", "iterate ns/el", "sort ms", "lower_bound ns", "distance ns");
+    measureTraversal<Deque<int> >("Deque", count);
+    measureTraversal<Deque<int, std::allocator<int>, BlockVector<int> > >("Deque<BlockVector>", count);
+    measureTraversal<std::deque<int> >("std::deque", count);
+}
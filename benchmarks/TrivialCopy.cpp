@@ -0,0 +1,110 @@
+#include "benchmarks/Benchmark.hpp"
+#include "headers/BlockVector.hpp"
+#include "headers/Deque.hpp"
+
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+struct Pod64
+{
+    long long words[8];
+};
+
+template <typename Value>
+Value
+makeValue(const size_t i)
+{
+    return static_cast<Value>(i);
+}
+
+template <>
+Pod64
+makeValue<Pod64>(const size_t i)
+{
+    Pod64 pod;
+    for (size_t w = 0; w < 8; ++w) {
+        pod.words[w] = static_cast<long long>(i + w);
+    }
+    return pod;
+}
+
+/// ns per element of the bulk operations, next to a push_back loop building
+/// the same deque.
+template <typename Queue>
+void
+measure(const char* name, const size_t count, const size_t rounds)
+{
+    typedef typename Queue::value_type Value;
+    std::vector<Value> source;
+    for (size_t i = 0; i < count; ++i) {
+        source.push_back(makeValue<Value>(i));
+    }
+    const Value fill = makeValue<Value>(3);
+    const double elements = static_cast<double>(count * rounds);
+
+    Timer timer;
+    for (size_t r = 0; r < rounds; ++r) {
+        Queue queue;
+        for (size_t i = 0; i < count; ++i) {
+            queue.push_back(source[i]);
+        }
+        doNotOptimize(queue.back());
+    }
+    const double pushed = timer.seconds();
+
+    timer.reset();
+    for (size_t r = 0; r < rounds; ++r) {
+        Queue queue(source.begin(), source.end());
+        doNotOptimize(queue.back());
+    }
+    const double ranged = timer.seconds();
+
+    const Queue original(source.begin(), source.end());
+    timer.reset();
+    for (size_t r = 0; r < rounds; ++r) {
+        Queue copy(original);
+        doNotOptimize(copy.back());
+    }
+    const double copied = timer.seconds();
+
+    timer.reset();
+    for (size_t r = 0; r < rounds; ++r) {
+        Queue queue;
+        queue.resize(count, fill);
+        queue.resize(count / 2);
+        doNotOptimize(queue.back());
+    }
+    const double resized = timer.seconds();
+
+    timer.reset();
+    for (size_t r = 0; r < rounds; ++r) {
+        Queue queue(original);
+        queue.insert(queue.begin() + count / 3, count, fill);
+        doNotOptimize(queue.back());
+    }
+    const double inserted = timer.seconds() - copied;
+
+    std::printf("%-28s %12.3f %12.3f %12.3f %12.3f %12.3f\n", name,
+                pushed * 1e9 / elements, ranged * 1e9 / elements, copied * 1e9 / elements,
+                resized * 1e9 / elements, inserted * 1e9 / elements);
+}
+
+} /// namespace
+
+void
+benchTrivialCopy()
+{
+    const size_t count = 200000;
+    const size_t rounds = 20;
+    std::printf("== Bulk operations on trivially copyable types (%lu elements, ns/el) ==\n",
+                static_cast<unsigned long>(count));
+    std::printf("%-28s %12s %12s %12s %12s %12s\n", "container", "push loop", "range ctor", "copy", "resize", "insert n");
+    measure<Deque<int> >("Deque<int>", count, rounds);
+    measure<Deque<int, std::allocator<int>, BlockVector<int> > >("Deque<int, BlockVector>", count, rounds);
+    measure<Deque<double> >("Deque<double>", count, rounds);
+    measure<Deque<double, std::allocator<double>, BlockVector<double> > >("Deque<double, BlockVector>", count, rounds);
+    measure<Deque<Pod64> >("Deque<Pod64>", count, rounds);
+    measure<Deque<Pod64, std::allocator<Pod64>, BlockVector<Pod64> > >("Deque<Pod64, BlockVector>", count, rounds);
+}
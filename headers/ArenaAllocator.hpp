@@ -0,0 +1,46 @@
+#ifndef __ARENA_ALLOCATOR_HPP__
+#define __ARENA_ALLOCATOR_HPP__
+
+#include "MonotonicArena.hpp"
+
+#include <cstdlib>
+
+/// Standard allocator drawing from a MonotonicArena. deallocate() is a
+/// no-op; memory comes back when the arena is released, so containers
+/// using it must not outlive the arena.
+///     MonotonicArena arena;
+///     Deque<int, ArenaAllocator<int> > deque((ArenaAllocator<int>(arena)));
+template <typename T>
+class ArenaAllocator
+{
+public:
+    typedef T              value_type;
+    typedef size_t         size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template <typename U>
+    struct rebind { typedef ArenaAllocator<U> other; };
+
+public:
+    ArenaAllocator(MonotonicArena& arena);
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& rhv);
+
+    T*    allocate(const size_type count);
+    void  deallocate(T* pointer, const size_type count);
+
+    MonotonicArena* getArena() const;
+
+private:
+    MonotonicArena* arena_;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& lhv, const ArenaAllocator<U>& rhv);
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& lhv, const ArenaAllocator<U>& rhv);
+
+#include "../templates/ArenaAllocator.cpp"
+
+#endif /// __ARENA_ALLOCATOR_HPP__
+
@@ -0,0 +1,206 @@
+#ifndef __BLOCK_VECTOR_HPP__
+#define __BLOCK_VECTOR_HPP__
+
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/// Vector-like sequence kept in fixed-size blocks reached through a map of
+/// block pointers. Growing at the back allocates a new block instead of
+/// reallocating, so existing elements never move. Blocks are drawn from
+/// Allocator one at a time.
+/// Plug it into a deque as Deque<T, Allocator, BlockVector<T, Allocator> >.
+template <typename T, typename Allocator = std::allocator<T> >
+class BlockVector
+{
+public:
+    typedef Allocator      allocator_type;
+    typedef size_t         size_type;
+    typedef T              value_type;
+    typedef T&             reference;
+    typedef const T&       const_reference;
+    typedef T*             pointer;
+    typedef const T*       const_pointer;
+    typedef std::ptrdiff_t difference_type;
+
+    static const size_type BLOCK_SIZE = (sizeof(T) < 256) ? 4096 / sizeof(T) : 16;
+                                          ///====CONST_ITERATOR====
+public:
+    class const_iterator {
+    friend class BlockVector<T, Allocator>;
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef T                               value_type;
+        typedef std::ptrdiff_t                  difference_type;
+        typedef const T*                        pointer;
+        typedef const T&                        reference;
+
+        const_iterator();
+        const_iterator(const const_iterator& rhv);
+        ~const_iterator();
+
+        const_iterator& operator=(const const_iterator& rhv);
+        const_reference operator*()                                const;
+        const_pointer   operator->()                               const;
+        const_reference operator[](const difference_type index)    const;
+        const_iterator& operator++();
+        const_iterator  operator++(int);
+        const_iterator& operator--();
+        const_iterator  operator--(int);
+        const_iterator  operator+(const difference_type size)      const;
+        const_iterator  operator-(const difference_type size)      const;
+        const_iterator& operator+=(const difference_type size);
+        const_iterator& operator-=(const difference_type size);
+        difference_type operator-(const const_iterator& rhv)       const;
+        bool            operator==(const const_iterator& rhv)      const;
+        bool            operator!=(const const_iterator& rhv)      const;
+        bool            operator<(const const_iterator& rhv)       const;
+        bool            operator>(const const_iterator& rhv)       const;
+        bool            operator<=(const const_iterator& rhv)      const;
+        bool            operator>=(const const_iterator& rhv)      const;
+
+    protected:
+        const BlockVector<T, Allocator>* getVector() const;
+        size_type             getIndex()  const;
+
+    private:
+        explicit const_iterator(const BlockVector<T, Allocator>* vector, const size_type index);
+
+    private:
+        const BlockVector* vector_;
+        size_type index_;
+    };
+                                        /// ====ITERATOR====
+public:
+    class iterator : public const_iterator {
+    friend class BlockVector<T, Allocator>;
+    public:
+        typedef T* pointer;
+        typedef T& reference;
+
+        iterator();
+        iterator(const iterator& rhv);
+        ~iterator();
+
+        using const_iterator::operator-;
+        iterator& operator=(const iterator& rhv);
+        reference operator*()                             const;
+        pointer   operator->()                            const;
+        reference operator[](const difference_type index) const;
+        iterator& operator++();
+        iterator  operator++(int);
+        iterator& operator--();
+        iterator  operator--(int);
+        iterator  operator+(const difference_type size)   const;
+        iterator  operator-(const difference_type size)   const;
+        iterator& operator+=(const difference_type size);
+        iterator& operator-=(const difference_type size);
+
+    private:
+        explicit iterator(const BlockVector<T, Allocator>* vector, const size_type index);
+    };
+
+            ///======BLOCK_VECTOR======
+public:
+    BlockVector();
+    explicit BlockVector(const Allocator& allocator);
+    BlockVector(const BlockVector<T, Allocator>& rhv);
+    BlockVector(BlockVector<T, Allocator>&& rhv) noexcept;
+    ~BlockVector();
+
+    BlockVector<T, Allocator>& operator=(const BlockVector<T, Allocator>& rhv);
+    BlockVector<T, Allocator>& operator=(BlockVector<T, Allocator>&& rhv) noexcept(nothrow_move_assignment::value);
+    reference       operator[](const size_type index);
+    const_reference operator[](const size_type index) const;
+
+    template <typename InputIterator>
+    void     assign(InputIterator first, InputIterator last);
+    template <typename InputIterator, typename = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
+    void     insert(iterator position, InputIterator first, InputIterator last);
+    void     insert(iterator position, const size_type size, const_reference value);
+    iterator insert(iterator position, const_reference value);
+    iterator insert(iterator position, value_type&& value);
+    template <typename... Args>
+    iterator emplace(iterator position, Args&&... args);
+    iterator erase(iterator position);
+    iterator erase(iterator first, iterator last);
+    template <typename... Args>
+    void emplace_back(Args&&... args);
+    void push_back(const_reference value);
+    void push_back(value_type&& value);
+    void pop_back();
+    reference       front();
+    const_reference front() const;
+    reference       back();
+    const_reference back()  const;
+
+    void      resize(const size_type newSize);
+    void      resize(const size_type newSize, const_reference initialValue);
+    void      reserve(const size_type newCapacity);
+    size_type capacity() const;
+    void      shrink_to_fit();
+    size_type max_size() const;
+    size_type size()     const;
+    bool      empty()    const;
+    void      clear();
+    void      swap(BlockVector<T, Allocator>& rhv) noexcept;
+    allocator_type get_allocator() const;
+
+    size_type     segment_count() const;
+    pointer       segment_data(const size_type segment);
+    const_pointer segment_data(const size_type segment) const;
+    size_type     segment_size(const size_type segment) const;
+
+    const_iterator begin() const;
+    const_iterator end()   const;
+    iterator       begin();
+    iterator       end();
+
+private:
+    typedef std::allocator_traits<Allocator> traits;
+    typedef typename traits::template rebind_alloc<pointer> map_allocator;
+    /// As for std::vector: a move assignment that cannot adopt the blocks
+    /// moves the elements one by one, which may allocate and throw.
+    typedef std::integral_constant<bool, traits::propagate_on_container_move_assignment::value
+                                      || traits::is_always_equal::value> nothrow_move_assignment;
+
+    pointer allocate_block();
+    void    append_block();
+    void    reserve_blocks(const size_type newSize);
+    void    deallocate_blocks();
+    void    take(BlockVector<T, Allocator>& rhv);
+    void    adopt_allocator(const Allocator& allocator, std::true_type);
+    void    adopt_allocator(const Allocator& allocator, std::false_type);
+    void    assign_from(const BlockVector<T, Allocator>& rhv);
+    void    construct_run(pointer destination, const_pointer source, const size_type count, std::true_type);
+    void    construct_run(pointer destination, const_pointer source, const size_type count, std::false_type);
+    template <typename ForwardIterator>
+    void    insert_range(const size_type index, ForwardIterator first, ForwardIterator last, std::true_type);
+    template <typename InputIterator>
+    void    insert_range(const size_type index, InputIterator first, InputIterator last, std::false_type);
+    void    insert_fill(const size_type index, const size_type count, const_reference value, std::true_type);
+    void    insert_fill(const size_type index, const size_type count, const_reference value, std::false_type);
+    void    append_default(const size_type count, std::true_type);
+    void    append_default(const size_type count, std::false_type);
+    void    erase_range(const size_type index, const size_type count, std::true_type);
+    void    erase_range(const size_type index, const size_type count, std::false_type);
+    void    destroy_from(const size_type newSize, std::true_type);
+    void    destroy_from(const size_type newSize, std::false_type);
+    void    open_gap(const size_type index, const size_type count);
+    void    move_elements(size_type to, size_type from, size_type count);
+    void    fill_elements(size_type index, size_type count, const_reference value);
+    static void fill_run(pointer destination, const size_type count, const_reference value);
+
+private:
+    Allocator allocator_;
+    std::vector<pointer, map_allocator> map_;
+    size_type size_;
+};
+
+#include "../templates/BlockVector.cpp"
+
+#endif /// __BLOCK_VECTOR_HPP__
+
@@ -0,0 +1,99 @@
+#ifndef __CIRCULAR_DEQUE_HPP__
+#define __CIRCULAR_DEQUE_HPP__
+
+#include "RingIterator.hpp"
+
+#include <cstdlib>
+#include <iterator>
+#include <utility>
+
+/// Bounded double-ended queue for sliding windows: the last capacity()
+/// elements pushed. The buffer is allocated once by the constructor; a push
+/// into a full deque overwrites the element at the opposite end in O(1)
+/// (push_back evicts the front, push_front the back) and never allocates.
+/// The push overloads taking `evicted` move the overwritten element there
+/// and return whether there was one. max_size() is the largest capacity
+/// the constructor accepts; size() never exceeds capacity().
+template <typename T>
+class CircularDeque
+{
+public:
+    typedef size_t         size_type;
+    typedef T              value_type;
+    typedef T&             reference;
+    typedef const T&       const_reference;
+    typedef T*             pointer;
+    typedef const T*       const_pointer;
+    typedef std::ptrdiff_t difference_type;
+    typedef RingConstIterator<T, CapacityWrap, CircularDeque<T> > const_iterator;
+    typedef RingIterator<T, CapacityWrap, CircularDeque<T> >      iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef std::reverse_iterator<iterator>       reverse_iterator;
+
+            ///======CIRCULAR_DEQUE======
+public:
+    explicit CircularDeque(const size_type capacity);
+    CircularDeque(const CircularDeque<T>& rhv);
+    CircularDeque(CircularDeque<T>&& rhv) noexcept;
+    ~CircularDeque();
+
+    CircularDeque<T>& operator=(const CircularDeque<T>& rhv);
+    CircularDeque<T>& operator=(CircularDeque<T>&& rhv) noexcept;
+    bool              operator==(const CircularDeque<T>& rhv) const;
+    bool              operator!=(const CircularDeque<T>& rhv) const;
+    reference         operator[](const size_type index);
+    const_reference   operator[](const size_type index) const;
+
+    template <typename... Args>
+    reference emplace_front(Args&&... args);
+    template <typename... Args>
+    reference emplace_back(Args&&... args);
+    void push_front(const_reference value);
+    void push_front(value_type&& value);
+    void push_back(const_reference value);
+    void push_back(value_type&& value);
+    bool push_front(const_reference value, value_type& evicted);
+    bool push_front(value_type&& value, value_type& evicted);
+    bool push_back(const_reference value, value_type& evicted);
+    bool push_back(value_type&& value, value_type& evicted);
+    void pop_front();
+    void pop_back();
+    reference       front();
+    const_reference front() const;
+    reference       back();
+    const_reference back()  const;
+
+    size_type capacity() const;
+    size_type max_size() const;
+    size_type size()     const;
+    bool      empty()    const;
+    bool      full()     const;
+    void      clear();
+    void      swap(CircularDeque<T>& rhv) noexcept;
+
+    const_iterator         begin()  const;
+    const_iterator         end()    const;
+    const_reverse_iterator rbegin() const;
+    const_reverse_iterator rend()   const;
+
+    iterator         begin();
+    iterator         end();
+    reverse_iterator rbegin();
+    reverse_iterator rend();
+
+private:
+    size_type slot(const size_type index) const;
+    void      rotate_front();
+    void      rotate_back();
+
+private:
+    pointer   buffer_;
+    size_type capacity_;
+    size_type head_;
+    size_type size_;
+};
+
+#include "../templates/CircularDeque.cpp"
+
+#endif /// __CIRCULAR_DEQUE_HPP__
+
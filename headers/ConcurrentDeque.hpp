@@ -0,0 +1,75 @@
+#ifndef __CONCURRENT_DEQUE_HPP__
+#define __CONCURRENT_DEQUE_HPP__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+
+/// Thread-safe deque for many producers and consumers, kept in two halves
+/// like Deque: front_ (reversed) under frontMutex_ and back_ under
+/// backMutex_. Operations at one end take only that end's lock. Only a pop
+/// that finds its half empty takes both, always front first, to move half
+/// of the other side over. Blocked poppers sleep on ready_ and are woken by
+/// pushes at either end.
+template <typename T>
+class ConcurrentDeque
+{
+public:
+    typedef size_t         size_type;
+    typedef T              value_type;
+    typedef T&             reference;
+    typedef const T&       const_reference;
+    typedef std::ptrdiff_t difference_type;
+
+    static const size_type CACHE_LINE = 64;
+
+public:
+    ConcurrentDeque();
+    ~ConcurrentDeque();
+
+    void push_front(const_reference value);
+    void push_front(value_type&& value);
+    void push_back(const_reference value);
+    void push_back(value_type&& value);
+
+    bool try_pop_front(reference value);
+    bool try_pop_back(reference value);
+    void pop_front_wait(reference value);
+    void pop_back_wait(reference value);
+    template <typename Rep, typename Period>
+    bool pop_front_wait(reference value, const std::chrono::duration<Rep, Period>& timeout);
+    template <typename Rep, typename Period>
+    bool pop_back_wait(reference value, const std::chrono::duration<Rep, Period>& timeout);
+
+    size_type size()  const;
+    bool      empty() const;
+
+private:
+    typedef bool (ConcurrentDeque<T>::*pop_function)(reference);
+    typedef std::chrono::steady_clock clock;
+
+    ConcurrentDeque(const ConcurrentDeque<T>& rhv);
+    ConcurrentDeque<T>& operator=(const ConcurrentDeque<T>& rhv);
+
+    void notify();
+    bool wait_and_pop(pop_function pop, reference value, const clock::time_point* deadline);
+
+private:
+    alignas(CACHE_LINE) mutable std::mutex frontMutex_;
+    std::vector<T> front_;
+
+    alignas(CACHE_LINE) mutable std::mutex backMutex_;
+    std::vector<T> back_;
+
+    alignas(CACHE_LINE) std::mutex waitMutex_;
+    std::condition_variable ready_;
+    std::atomic<size_type>  waiters_;
+};
+
+#include "../templates/ConcurrentDeque.cpp"
+
+#endif /// __CONCURRENT_DEQUE_HPP__
+
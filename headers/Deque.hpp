@@ -1,13 +1,32 @@
 #ifndef __DEQUE_HPP__
 #define __DEQUE_HPP__
 
+#include "DequeStatistics.hpp"
+
 #include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
 #include <vector>
+#if __cplusplus >= 201703L
+#include <memory_resource>
+#endif
 
-template <typename T>
-class Deque
+/// Double-ended queue kept in two halves: front_ holds the front elements in
+/// reverse order and back_ the back elements in order. Storage is the
+/// container used for each half; it defaults to std::vector<T, Allocator> and
+/// can be any vector-like sequence constructible from an Allocator, e.g.
+/// BlockVector<T, Allocator> for segmented storage. Statistics is the
+/// instrumentation policy: NoStatistics costs nothing, DequeStatistics
+/// counts reallocations, rebalances, element moves and the peak size.
+template <typename T, typename Allocator = std::allocator<T>, typename Storage = std::vector<T, Allocator>,
+          typename Statistics = NoStatistics>
+class Deque : private Statistics
 {
 public:
+    typedef Allocator      allocator_type;
+    typedef Storage        storage_type;
     typedef size_t         size_type;
     typedef T              value_type;
     typedef T&             reference;
@@ -18,81 +37,106 @@ public:
                                           ///====CONST_ITERATOR====
 public:
     class const_iterator {
-    friend class Deque<T>;
+    friend class Deque<T, Allocator, Storage, Statistics>;
     public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef T                               value_type;
+        typedef std::ptrdiff_t                  difference_type;
+        typedef const T*                        pointer;
+        typedef const T&                        reference;
+
         const_iterator();
         const_iterator(const const_iterator& rhv);
         ~const_iterator();
     
         const_iterator& operator=(const const_iterator& rhv);    
-        const_reference operator*()                            const;
-        const_pointer   operator->()                           const;
-        const_reference operator[](const size_type index)    const;
+        const_reference operator*()                                const;
+        const_pointer   operator->()                               const;
+        const_reference operator[](const difference_type index)    const;
         const_iterator& operator++();
         const_iterator  operator++(int);
         const_iterator& operator--();
         const_iterator  operator--(int);
-        const_iterator  operator+(const size_type size)   const;
-        const_iterator  operator-(const size_type size)   const;
-        const_iterator& operator+=(const size_type size);
-        const_iterator& operator-=(const size_type size);
-        bool            operator==(const const_iterator& rhv)  const;
-        bool            operator!=(const const_iterator& rhv)  const;
-        bool            operator<(const const_iterator& rhv)   const;
-        bool            operator>(const const_iterator& rhv)   const;
-        bool            operator<=(const const_iterator& rhv)  const;
-        bool            operator>=(const const_iterator& rhv)  const;
+        const_iterator  operator+(const difference_type size)      const;
+        const_iterator  operator-(const difference_type size)      const;
+        const_iterator& operator+=(const difference_type size);
+        const_iterator& operator-=(const difference_type size);
+        difference_type operator-(const const_iterator& rhv)       const;
+        bool            operator==(const const_iterator& rhv)      const;
+        bool            operator!=(const const_iterator& rhv)      const;
+        bool            operator<(const const_iterator& rhv)       const;
+        bool            operator>(const const_iterator& rhv)       const;
+        bool            operator<=(const const_iterator& rhv)      const;
+        bool            operator>=(const const_iterator& rhv)      const;
 
     protected:
-        const Deque<T>* getDeque() const;
-        const_pointer   getPtr()   const;
+        const Deque<T, Allocator, Storage, Statistics>* getDeque() const;
+        size_type       getIndex() const;
 
     private:
-        explicit const_iterator(const Deque<T>* deque, const_pointer index);
+        explicit const_iterator(const Deque<T, Allocator, Storage, Statistics>* deque, const size_type index);
 
     private:
         const Deque* deque_;
-        const_pointer ptr_;
+        size_type index_;
     };
                                         /// ====ITERATOR====
 public:
     class iterator : public const_iterator {
-    friend class Deque<T>;
+    friend class Deque<T, Allocator, Storage, Statistics>;
     public:
+        typedef T* pointer;
+        typedef T& reference;
+
         iterator();
         iterator(const iterator& rhv);
         ~iterator();
-        
-        reference       operator*()                       const;
-        pointer         operator->()                      const;
-        reference       operator[](const size_type index) const;
-        iterator        operator+(const size_type size)   const;
-        iterator        operator-(const size_type size)   const;
+
+        using const_iterator::operator-;
+        iterator& operator=(const iterator& rhv);
+        reference operator*()                             const;
+        pointer   operator->()                            const;
+        reference operator[](const difference_type index) const;
+        iterator& operator++();
+        iterator  operator++(int);
+        iterator& operator--();
+        iterator  operator--(int);
+        iterator  operator+(const difference_type size)   const;
+        iterator  operator-(const difference_type size)   const;
+        iterator& operator+=(const difference_type size);
+        iterator& operator-=(const difference_type size);
 
     private:
-        explicit iterator(const Deque<T>* deque, pointer ptr);
+        explicit iterator(const Deque<T, Allocator, Storage, Statistics>* deque, const size_type index);
     };
                             ///====CONST_REVERSE_ITERATOR====
 public:
     class const_reverse_iterator {
-    friend class Deque<T>;
+    friend class Deque<T, Allocator, Storage, Statistics>;
     public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef T                               value_type;
+        typedef std::ptrdiff_t                  difference_type;
+        typedef const T*                        pointer;
+        typedef const T&                        reference;
+
         const_reverse_iterator();
         const_reverse_iterator(const const_reverse_iterator& rhv);
         ~const_reverse_iterator();
     
         const_reverse_iterator& operator=(const const_reverse_iterator& rhv);    
-        const_reference         operator*()                            const;
-        const_pointer           operator->()                           const;
-        const_reference         operator[](const size_type index)    const;
+        const_reference         operator*()                                    const;
+        const_pointer           operator->()                                   const;
+        const_reference         operator[](const difference_type index)        const;
         const_reverse_iterator& operator++();
         const_reverse_iterator  operator++(int);
         const_reverse_iterator& operator--();
         const_reverse_iterator  operator--(int);
-        const_reverse_iterator  operator+(const size_type size)   const;
-        const_reverse_iterator  operator-(const size_type size)   const;
-        const_reverse_iterator& operator+=(const size_type size);
-        const_reverse_iterator& operator-=(const size_type size);
+        const_reverse_iterator  operator+(const difference_type size)          const;
+        const_reverse_iterator  operator-(const difference_type size)          const;
+        const_reverse_iterator& operator+=(const difference_type size);
+        const_reverse_iterator& operator-=(const difference_type size);
+        difference_type         operator-(const const_reverse_iterator& rhv)   const;
         bool                    operator==(const const_reverse_iterator& rhv)  const;
         bool                    operator!=(const const_reverse_iterator& rhv)  const;
         bool                    operator<(const const_reverse_iterator& rhv)   const;
@@ -101,63 +145,93 @@ public:
         bool                    operator>=(const const_reverse_iterator& rhv)  const;
 
     protected:
-        const Deque<T>* getDeque() const;
-        const_pointer   getPtr()   const;
+        const Deque<T, Allocator, Storage, Statistics>* getDeque() const;
+        size_type       getIndex() const;
 
     private:
-        explicit const_reverse_iterator(const Deque<T>* deque, const_pointer index);
+        explicit const_reverse_iterator(const Deque<T, Allocator, Storage, Statistics>* deque, const size_type index);
 
     private:
         const Deque* deque_;
-        const_pointer ptr_;
+        size_type index_; /// one past the referenced element, as in std::reverse_iterator
     };
                                         /// ====REVERSE_ITERATOR====
 public:
     class reverse_iterator : public const_reverse_iterator {
-    friend class Deque<T>;
+    friend class Deque<T, Allocator, Storage, Statistics>;
     public:
+        typedef T* pointer;
+        typedef T& reference;
+
         reverse_iterator();
         reverse_iterator(const reverse_iterator& rhv);
         ~reverse_iterator();
-        
-        reference        operator*()                       const;
-        pointer          operator->()                      const;
-        reference        operator[](const size_type index) const;
-        reverse_iterator operator+(const size_type size)   const;
-        reverse_iterator operator-(const size_type size)   const;
+
+        using const_reverse_iterator::operator-;
+        reverse_iterator& operator=(const reverse_iterator& rhv);
+        reference         operator*()                             const;
+        pointer           operator->()                            const;
+        reference         operator[](const difference_type index) const;
+        reverse_iterator& operator++();
+        reverse_iterator  operator++(int);
+        reverse_iterator& operator--();
+        reverse_iterator  operator--(int);
+        reverse_iterator  operator+(const difference_type size)   const;
+        reverse_iterator  operator-(const difference_type size)   const;
+        reverse_iterator& operator+=(const difference_type size);
+        reverse_iterator& operator-=(const difference_type size);
 
     private:
-        explicit reverse_iterator(const Deque<T>* deque, pointer ptr);
+        explicit reverse_iterator(const Deque<T, Allocator, Storage, Statistics>* deque, const size_type index);
     };
 
             ///======DEQUE======
 public:
     Deque();
-    Deque(const size_type newSize, const_reference initialValue = T()); 
-    Deque(const int newSize, const_reference initialValue = T()); 
-    Deque(const Deque<T>& rhv);
+    explicit Deque(const Allocator& allocator);
+    Deque(const size_type newSize, const_reference initialValue = T(), const Allocator& allocator = Allocator());
+    Deque(const int newSize, const_reference initialValue = T(), const Allocator& allocator = Allocator());
+    Deque(const Deque<T, Allocator, Storage, Statistics>& rhv);
+    Deque(Deque<T, Allocator, Storage, Statistics>&& rhv) noexcept(nothrow_move_construction::value);
     template <typename InputIterator>
-    Deque(InputIterator first, InputIterator last);
+    Deque(InputIterator first, InputIterator last, const Allocator& allocator = Allocator());
     ~Deque();
 
-    Deque<T>&       operator=(const Deque<T>& rhv);
-    bool            operator==(const Deque<T>& rhv)   const;
-    bool            operator!=(const Deque<T>& rhv)   const;
-    bool            operator<(const Deque<T>& rhv)    const;
-    bool            operator>(const Deque<T>& rhv)    const;
-    bool            operator<=(const Deque<T>& rhv)   const;
-    bool            operator>=(const Deque<T>& rhv)   const;
+    Deque<T, Allocator, Storage, Statistics>& operator=(const Deque<T, Allocator, Storage, Statistics>& rhv);
+    Deque<T, Allocator, Storage, Statistics>& operator=(Deque<T, Allocator, Storage, Statistics>&& rhv)
+        noexcept(nothrow_move_assignment::value);
+    bool            operator==(const Deque<T, Allocator, Storage, Statistics>& rhv)   const;
+    bool            operator!=(const Deque<T, Allocator, Storage, Statistics>& rhv)   const;
+    bool            operator<(const Deque<T, Allocator, Storage, Statistics>& rhv)    const;
+    bool            operator>(const Deque<T, Allocator, Storage, Statistics>& rhv)    const;
+    bool            operator<=(const Deque<T, Allocator, Storage, Statistics>& rhv)   const;
+    bool            operator>=(const Deque<T, Allocator, Storage, Statistics>& rhv)   const;
     reference       operator[](const size_type index);
     const_reference operator[](const size_type index) const;
     
-    template <typename InputIterator>
+    template <typename InputIterator, typename = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
     void     insert(iterator position, InputIterator first, InputIterator last);
     iterator insert(iterator position, const_reference value);
+    iterator insert(iterator position, value_type&& value);
     void     insert(iterator position, size_type size, const_reference value);
     iterator erase(iterator position);
     iterator erase(iterator first, iterator last);
+    template <typename... Args>
+    iterator  emplace(iterator position, Args&&... args);
+    template <typename... Args>
+    reference emplace_front(Args&&... args);
+    template <typename... Args>
+    reference emplace_back(Args&&... args);
     void push_front(const_reference value);
-    void push_back(const_reference value); 
+    void push_front(value_type&& value);
+    void push_back(const_reference value);
+    void push_back(value_type&& value);
+    template <typename InputIterator, typename = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
+    void append(InputIterator first, InputIterator last);
+    template <typename InputIterator, typename = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
+    void prepend(InputIterator first, InputIterator last);
+    void push_back_n(const size_type count, const_reference value);
+    void push_front_n(const size_type count, const_reference value);
     void pop_front();
     void pop_back();
     reference       front();
@@ -165,12 +239,28 @@ public:
     reference       back();
     const_reference back()  const; 
 
-    void      resize(const size_type newSize, const_reference initialValue = T());
+    void      resize(const size_type newSize);
+    void      resize(const size_type newSize, const_reference initialValue);
+    void      reserve_front(const size_type newCapacity);
+    void      reserve_back(const size_type newCapacity);
+    size_type capacity_front() const;
+    size_type capacity_back()  const;
+    void      shrink_to_fit();
     size_type max_size() const;
     size_type size()     const;
     bool      empty()    const;
     void      clear();
-    void      swap(Deque<T>& rhv);
+    void      swap(Deque<T, Allocator, Storage, Statistics>& rhv) noexcept(nothrow_swap::value);
+    allocator_type get_allocator() const;
+
+    template <typename Function>
+    void for_each_segment(Function function) const;
+    template <typename Function>
+    void for_each_segment(Function function);
+    void normalize();
+
+    const Statistics& statistics() const;
+    Statistics&       statistics();
 
     const_iterator         begin()  const; 
     const_iterator         end()    const;
@@ -183,15 +273,108 @@ public:
     reverse_iterator rend();
 
 private:
+    /// As for std::deque: a move assignment that cannot adopt the storage
+    /// moves the elements one by one, which may allocate and throw. A move
+    /// also starts fresh statistics, and DequeStatistics registers itself.
+    typedef std::integral_constant<bool, (std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value
+                                       || std::allocator_traits<Allocator>::is_always_equal::value)
+                                      && std::is_nothrow_move_assignable<Storage>::value> nothrow_move_assignment;
+    typedef std::integral_constant<bool, std::is_nothrow_default_constructible<Statistics>::value
+                                      && std::is_nothrow_move_constructible<Storage>::value> nothrow_move_construction;
+    typedef std::integral_constant<bool, noexcept(std::declval<Storage&>().swap(std::declval<Storage&>()))> nothrow_swap;
+    /// Integers, enums and pointers compare equal exactly when their bytes do.
+    typedef std::integral_constant<bool, std::is_integral<T>::value
+                                      || std::is_enum<T>::value
+                                      || std::is_pointer<T>::value> trivially_comparable;
+    /// Elements compared per memcmp call, and so rescanned after a mismatch.
+    static const size_type COMPARE_CHUNK = 1024;
+
+    /// Records, when Statistics is enabled, whether the half reallocated
+    /// while the probe was alive, and the deque's size afterwards.
+    class growth_probe {
+    public:
+        growth_probe(Deque& deque, const Storage& half);
+        ~growth_probe();
+
+    private:
+        Deque&         deque_;
+        const Storage& half_;
+        size_type      capacity_;
+        size_type      size_;
+        const void*    address_;
+    };
+
+    /// Walks the contiguous runs of a deque in logical order.
+    class run_cursor {
+    public:
+        explicit run_cursor(const Deque<T, Allocator, Storage, Statistics>& deque);
+
+        const_pointer current()   const;
+        size_type     available() const;
+        bool          reversed()  const;
+        const_pointer chunk(const size_type count) const;
+        const_reference at(const size_type offset) const;
+        void          advance(const size_type count);
+
+    private:
+        void load();
+
+    private:
+        const Deque* deque_;
+        bool          inFront_;
+        size_type     run_;    /// runs left in front_, or next run of back_
+        const_pointer data_;
+        size_type     size_;
+        size_type     offset_;
+    };
+
+private:
+     size_type       first_mismatch(const Deque<T, Allocator, Storage, Statistics>& rhv, const size_type count, std::true_type)  const;
+     size_type       first_mismatch(const Deque<T, Allocator, Storage, Statistics>& rhv, const size_type count, std::false_type) const;
      reference       at_index(const size_type index);
      const_reference at_index(const size_type index) const;
+     void            rebalance_front();
+     void            rebalance_back();
+     template <typename BidirectionalIterator>
+     void            prepend_range(BidirectionalIterator first, BidirectionalIterator last, std::true_type);
+     template <typename InputIterator>
+     void            prepend_range(InputIterator first, InputIterator last, std::false_type);
+
+     template <typename Half, typename Function>
+     static void visit_front_runs(Half& half, Function& function);
+     template <typename Half, typename Function>
+     static void visit_back_runs(Half& half, Function& function);
+     template <typename Half>
+     static auto run_count(Half& half, int) -> decltype(half.segment_count());
+     template <typename Half>
+     static size_type run_count(Half& half, long);
+     template <typename Half>
+     static auto run_data(Half& half, const size_type run, int) -> decltype(half.segment_data(run));
+     template <typename Half>
+     static auto run_data(Half& half, const size_type run, long) -> decltype(half.data());
+     template <typename Half>
+     static auto run_size(Half& half, const size_type run, int) -> decltype(half.segment_size(run));
+     template <typename Half>
+     static size_type run_size(Half& half, const size_type run, long);
+     template <typename Half>
+     static auto storage_address(const Half& half, int) -> decltype(static_cast<const void*>(half.data()));
+     template <typename Half>
+     static const void* storage_address(const Half& half, long);
 
 private:
-    std::vector<T> front_; 
-    std::vector<T> back_; 
+    Storage front_;
+    Storage back_;
 
 };
 
+#if __cplusplus >= 201703L
+namespace pmr {
+/// Deque whose halves draw memory from a std::pmr::memory_resource.
+template <typename T>
+using Deque = ::Deque<T, std::pmr::polymorphic_allocator<T> >;
+} /// namespace pmr
+#endif
+
 #include "../templates/Deque.cpp"
 
 #endif /// __DEQUE_HPP__
@@ -0,0 +1,60 @@
+#ifndef __DEQUE_PARALLEL_HPP__
+#define __DEQUE_PARALLEL_HPP__
+
+#include "Deque.hpp"
+#include "ThreadPool.hpp"
+
+#include <cstddef>
+#include <functional>
+
+/// Parallel loops over a Deque. The logical range is cut into chunks of
+/// grain elements, and each chunk walks the contiguous runs reported by
+/// for_each_segment with plain pointers, so neither half is copied and no
+/// iterator branches per element. Chunks run on a ThreadPool; a grain much
+/// below some thousand elements costs more in scheduling than it saves.
+namespace deque_parallel {
+
+const size_t DEFAULT_GRAIN = 1 << 16;
+
+/// Calls function on every element, in no particular order.
+template <typename T, typename Allocator, typename Storage, typename Statistics, typename Function>
+void for_each(ThreadPool& pool, Deque<T, Allocator, Storage, Statistics>& deque, Function function,
+              const size_t grain = DEFAULT_GRAIN);
+template <typename T, typename Allocator, typename Storage, typename Statistics, typename Function>
+void for_each(ThreadPool& pool, const Deque<T, Allocator, Storage, Statistics>& deque, Function function,
+              const size_t grain = DEFAULT_GRAIN);
+
+/// Resizes destination to the size of source and stores function(source[i])
+/// in destination[i]. destination may be source itself.
+template <typename T, typename Allocator, typename Storage, typename Statistics,
+          typename U, typename OutAllocator, typename OutStorage, typename OutStatistics, typename Function>
+void transform(ThreadPool& pool, const Deque<T, Allocator, Storage, Statistics>& source,
+               Deque<U, OutAllocator, OutStorage, OutStatistics>& destination, Function function,
+               const size_t grain = DEFAULT_GRAIN);
+
+/// Folds each chunk in logical order, then the chunk results into init in
+/// chunk order. operation must be associative; it need not be commutative.
+template <typename T, typename Allocator, typename Storage, typename Statistics,
+          typename Result, typename BinaryOperation>
+Result reduce(ThreadPool& pool, const Deque<T, Allocator, Storage, Statistics>& deque, Result init,
+              BinaryOperation operation, const size_t grain = DEFAULT_GRAIN);
+template <typename T, typename Allocator, typename Storage, typename Statistics, typename Result>
+Result reduce(ThreadPool& pool, const Deque<T, Allocator, Storage, Statistics>& deque, Result init);
+
+/// Sorts in place. The runs of both halves are sorted in pieces of about
+/// size / threads elements, the reversed front runs with the comparison
+/// flipped, and the pieces are then merged pairwise through one scratch
+/// buffer of default-constructed T. A merge wider than its share of the
+/// threads is split by merge path, so the last rounds stay parallel too.
+/// Not stable.
+template <typename T, typename Allocator, typename Storage, typename Statistics, typename Compare>
+void sort(ThreadPool& pool, Deque<T, Allocator, Storage, Statistics>& deque, Compare compare);
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+void sort(ThreadPool& pool, Deque<T, Allocator, Storage, Statistics>& deque);
+
+} /// namespace deque_parallel
+
+#include "../templates/DequeParallel.cpp"
+
+#endif /// __DEQUE_PARALLEL_HPP__
+
@@ -0,0 +1,147 @@
+#ifndef __DEQUE_SERIALIZATION_HPP__
+#define __DEQUE_SERIALIZATION_HPP__
+
+#include "Deque.hpp"
+#include "MappedFile.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/// Binary snapshots of a Deque. A snapshot is a 64-byte header followed by
+/// the front half as it is stored (logically reversed) and then the back
+/// half, each in native byte order:
+///     save(orders, out);            /// std::ostream, or a file descriptor
+///     load(restored, in);           /// replaces the contents
+///     DequeView<Order> view(path);  /// maps the file read-only, no copy
+/// Trivially copyable elements are written raw, one write call per stored
+/// run, and read straight into the deque's storage. Other element types
+/// go through Serializer<T>. Malformed input throws std::runtime_error,
+/// failed system calls std::system_error.
+
+/// Encodes a non-trivially copyable T. Specialize it with
+///     static void write(std::ostream& out, const T& value);
+///     static T    read(std::istream& in);
+/// std::string is provided.
+template <typename T>
+struct Serializer;
+
+template <>
+struct Serializer<std::string>
+{
+    static void        write(std::ostream& out, const std::string& value);
+    static std::string read(std::istream& in);
+};
+
+struct DequeSnapshotHeader
+{
+    static const uint32_t VERSION = 1;
+    enum Encoding { RAW = 0, SERIALIZER = 1 };
+
+    char     magic[8];
+    uint32_t version;
+    uint32_t elementSize;
+    uint32_t encoding;
+    uint32_t reserved;
+    uint64_t frontSize; /// elements of the front half, stored reversed
+    uint64_t backSize;
+    char     padding[24];
+
+    static DequeSnapshotHeader make(const uint32_t elementSize, const Encoding encoding,
+                                    const uint64_t frontSize, const uint64_t backSize);
+    void check(const uint32_t expectedSize, const Encoding expectedEncoding) const;
+    /// frontSize + backSize, or std::runtime_error if the sum overflows or
+    /// exceeds maxSize.
+    uint64_t elements(const uint64_t maxSize) const;
+};
+
+static_assert(sizeof(DequeSnapshotHeader) == 64, "elements after the header stay aligned");
+
+/// Buffered std::streambuf over a file descriptor, so Serializer types can
+/// be saved to and loaded from descriptors too. It does not own the
+/// descriptor.
+class FdStreamBuffer : public std::streambuf
+{
+public:
+    explicit FdStreamBuffer(const int descriptor);
+    ~FdStreamBuffer();
+
+protected:
+    int_type overflow(int_type character);
+    int_type underflow();
+    int      sync();
+
+private:
+    FdStreamBuffer(const FdStreamBuffer& rhv);
+    FdStreamBuffer& operator=(const FdStreamBuffer& rhv);
+
+    bool flush_output();
+
+private:
+    int               descriptor_;
+    std::vector<char> output_;
+    std::vector<char> input_;
+};
+
+namespace deque_io {
+void write_all(const int descriptor, const void* data, const size_t bytes);
+void read_all(const int descriptor, void* data, const size_t bytes);
+void write_all(std::ostream& out, const void* data, const size_t bytes);
+void read_all(std::istream& in, void* data, const size_t bytes);
+/// Bytes left to read, when the input has a known end (a regular file, a
+/// seekable stream). Returns false for pipes, sockets and the like.
+bool remaining(const int descriptor, uint64_t& bytes);
+bool remaining(std::istream& in, uint64_t& bytes);
+} /// namespace deque_io
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+void save(const Deque<T, Allocator, Storage, Statistics>& deque, std::ostream& out);
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+void save(const Deque<T, Allocator, Storage, Statistics>& deque, const int descriptor);
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+void load(Deque<T, Allocator, Storage, Statistics>& deque, std::istream& in);
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+void load(Deque<T, Allocator, Storage, Statistics>& deque, const int descriptor);
+
+/// Read-only view of a snapshot file of trivially copyable T, mapped in
+/// place: opening it costs no copy and pages are read on first touch.
+template <typename T>
+class DequeView
+{
+    static_assert(std::is_trivially_copyable<T>::value, "DequeView reads elements as raw bytes");
+
+public:
+    typedef size_t   size_type;
+    typedef T        value_type;
+    typedef const T& const_reference;
+    typedef const T* const_pointer;
+
+public:
+    explicit DequeView(const std::string& path);
+
+    const_reference operator[](const size_type index) const;
+    const_reference front() const;
+    const_reference back()  const;
+    size_type       size()  const;
+    bool            empty() const;
+
+    template <typename Function>
+    void for_each_segment(Function function) const;
+
+private:
+    MappedFile    file_;
+    const_pointer front_;
+    size_type     frontSize_;
+    const_pointer back_;
+    size_type     backSize_;
+};
+
+#include "../templates/DequeSerialization.cpp"
+
+#endif /// __DEQUE_SERIALIZATION_HPP__
+
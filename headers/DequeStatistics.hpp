@@ -0,0 +1,146 @@
+#ifndef __DEQUE_STATISTICS_HPP__
+#define __DEQUE_STATISTICS_HPP__
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/// Statistics policy of Deque. The hooks are called from the hot paths
+/// behind `if (Statistics::enabled)`, so with this default they compile to
+/// nothing and, being an empty base, the policy takes no space.
+class NoStatistics
+{
+public:
+    static const bool enabled = false;
+
+    void record_reallocation(const size_t /*moved*/, const size_t /*elementSize*/) {}
+    void record_rebalance(const size_t /*moved*/, const size_t /*elementSize*/) {}
+    void record_moves(const size_t /*moved*/, const size_t /*elementSize*/) {}
+    void record_size(const size_t /*size*/) {}
+};
+
+/// Snapshot of the counters of one deque, or a sum over many.
+struct DequeCounters
+{
+    unsigned long long reallocations; /// a half grew its buffer
+    unsigned long long rebalances;    /// a pop found its half empty and refilled it from the other
+    unsigned long long elementsMoved; /// by reallocation, rebalancing, and shifts in middle edits
+    unsigned long long bytesMoved;
+    unsigned long long peakSize;
+};
+
+/// Statistics policy that counts per deque and lists every instance in
+/// DequeStatisticsRegistry:
+///     Deque<int, std::allocator<int>, std::vector<int>, DequeStatistics> queue;
+/// Counters are written only by the owning thread and may be read by any
+/// thread dumping the registry.
+class DequeStatistics
+{
+public:
+    static const bool enabled = true;
+
+    DequeStatistics();
+    DequeStatistics(const DequeStatistics& rhv);
+    ~DequeStatistics();
+
+    DequeStatistics& operator=(const DequeStatistics& rhv);
+
+    void record_reallocation(const size_t moved, const size_t elementSize);
+    void record_rebalance(const size_t moved, const size_t elementSize);
+    void record_moves(const size_t moved, const size_t elementSize);
+    void record_size(const size_t size);
+
+    DequeCounters counters() const;
+    unsigned long id() const;
+    std::string   name() const;
+    void          set_name(const std::string& name);
+
+private:
+    friend class DequeStatisticsRegistry;
+
+    static void add(std::atomic<unsigned long long>& counter, const unsigned long long amount);
+
+private:
+    std::atomic<unsigned long long> reallocations_;
+    std::atomic<unsigned long long> rebalances_;
+    std::atomic<unsigned long long> elementsMoved_;
+    std::atomic<unsigned long long> bytesMoved_;
+    std::atomic<unsigned long long> peakSize_;
+    unsigned long id_;
+    std::string name_;
+    size_t slot_; /// index in the registry's live list, under its lock
+};
+
+/// Process-wide list of live DequeStatistics instances. Counters of
+/// destroyed instances are folded into a retired total. Each instance
+/// knows its index in the list, so attach and detach are O(1).
+class DequeStatisticsRegistry
+{
+public:
+    static DequeStatisticsRegistry& instance();
+
+    void          dump(std::ostream& out) const;
+    DequeCounters totals() const;
+    size_t        live() const;
+
+private:
+    friend class DequeStatistics;
+
+    DequeStatisticsRegistry();
+    DequeStatisticsRegistry(const DequeStatisticsRegistry&);
+    DequeStatisticsRegistry& operator=(const DequeStatisticsRegistry&);
+
+    unsigned long attach(DequeStatistics* statistics);
+    void          detach(DequeStatistics* statistics);
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<DequeStatistics*> live_;
+    DequeCounters retired_;
+    unsigned long nextId_;
+};
+
+/// The hooks run on every push, so they are defined here to be inlined.
+
+/// Only the owning thread writes, so a relaxed load and store suffice and
+/// cost no more than a plain increment; readers never see a torn value.
+inline void
+DequeStatistics::add(std::atomic<unsigned long long>& counter, const unsigned long long amount)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+inline void
+DequeStatistics::record_reallocation(const size_t moved, const size_t elementSize)
+{
+    add(reallocations_, 1);
+    record_moves(moved, elementSize);
+}
+
+inline void
+DequeStatistics::record_rebalance(const size_t moved, const size_t elementSize)
+{
+    add(rebalances_, 1);
+    record_moves(moved, elementSize);
+}
+
+inline void
+DequeStatistics::record_moves(const size_t moved, const size_t elementSize)
+{
+    add(elementsMoved_, moved);
+    add(bytesMoved_, static_cast<unsigned long long>(moved) * elementSize);
+}
+
+inline void
+DequeStatistics::record_size(const size_t size)
+{
+    if (size > peakSize_.load(std::memory_order_relaxed)) {
+        peakSize_.store(size, std::memory_order_relaxed);
+    }
+}
+
+#endif /// __DEQUE_STATISTICS_HPP__
+
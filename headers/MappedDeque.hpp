@@ -0,0 +1,89 @@
+#ifndef __MAPPED_DEQUE_HPP__
+#define __MAPPED_DEQUE_HPP__
+
+#include "MappedFile.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <type_traits>
+
+/// Double-ended queue of trivially copyable elements kept in a memory-mapped
+/// file, for queues larger than RAM. The file is a one-page header followed
+/// by a ring of capacity() slots; the kernel pages elements in and out. A
+/// full ring grows the file by at least one chunk (and by half its size
+/// once it is larger), so growth is amortized O(1). Slots drained by
+/// pop_front are dropped from memory a chunk at a time.
+///
+/// Opening an existing file resumes the queue where it was left, with no
+/// deserialization. Changes reach the file when the kernel writes the pages
+/// back; sync() waits for that. Not thread-safe.
+template <typename T>
+class MappedDeque
+{
+    static_assert(std::is_trivially_copyable<T>::value, "MappedDeque stores elements as raw bytes");
+
+public:
+    typedef size_t         size_type;
+    typedef T              value_type;
+    typedef T&             reference;
+    typedef const T&       const_reference;
+    typedef T*             pointer;
+    typedef const T*       const_pointer;
+    typedef std::ptrdiff_t difference_type;
+
+    static const size_type DEFAULT_CHUNK_BYTES = 64 << 20;
+    static const uint32_t  VERSION = 1;
+
+public:
+    explicit MappedDeque(const std::string& path, const size_type chunkBytes = DEFAULT_CHUNK_BYTES);
+    ~MappedDeque();
+
+    reference       operator[](const size_type index);
+    const_reference operator[](const size_type index) const;
+
+    void push_front(const_reference value);
+    void push_back(const_reference value);
+    void pop_front();
+    void pop_back();
+    reference       front();
+    const_reference front() const;
+    reference       back();
+    const_reference back()  const;
+
+    size_type capacity() const;
+    size_type size()     const;
+    bool      empty()    const;
+    void      clear();
+    void      sync();
+
+private:
+    struct header {
+        char     magic[8];
+        uint32_t version;
+        uint32_t elementSize;
+        uint64_t capacity;
+        uint64_t head;
+        uint64_t size;
+    };
+
+    static const size_type HEADER_BYTES = 4096;
+
+    MappedDeque(const MappedDeque<T>& rhv);
+    MappedDeque<T>& operator=(const MappedDeque<T>& rhv);
+
+    void      attach();
+    void      grow();
+    size_type slot(const size_type index) const;
+
+private:
+    MappedFile file_;
+    size_type  chunkElements_;
+    header*    header_;   /// inside the mapping, so moved by grow()
+    pointer    elements_;
+};
+
+#include "../templates/MappedDeque.cpp"
+
+#endif /// __MAPPED_DEQUE_HPP__
+
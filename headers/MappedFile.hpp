@@ -0,0 +1,52 @@
+#ifndef __MAPPED_FILE_HPP__
+#define __MAPPED_FILE_HPP__
+
+#include <cstdlib>
+#include <string>
+
+/// A file mapped into memory in full with MAP_SHARED, so stores reach the
+/// file without write calls. A read-write file is created if missing and
+/// can be resized, which remaps it and so moves data(). System call
+/// failures throw std::system_error and leave the mapping as it was. Not
+/// thread-safe.
+class MappedFile
+{
+public:
+    typedef size_t size_type;
+
+    enum Mode { READ_ONLY, READ_WRITE };
+
+public:
+    MappedFile(const std::string& path, const Mode mode);
+    ~MappedFile();
+
+    char*       data();
+    const char* data() const;
+    size_type   size() const;
+    Mode        mode() const;
+
+    void resize(const size_type bytes);
+    void advise_sequential();
+    void release(const size_type offset, const size_type bytes);
+    void sync();
+    void sync(const size_type offset, const size_type bytes);
+
+    static size_type page_size();
+
+private:
+    MappedFile(const MappedFile& rhv);
+    MappedFile& operator=(const MappedFile& rhv);
+
+    char* map(const size_type bytes) const;
+    void  unmap();
+
+private:
+    std::string path_;
+    Mode        mode_;
+    int         descriptor_;
+    char*       data_;
+    size_type   size_;
+};
+
+#endif /// __MAPPED_FILE_HPP__
+
@@ -0,0 +1,41 @@
+#ifndef __MONOTONIC_ARENA_HPP__
+#define __MONOTONIC_ARENA_HPP__
+
+#include <cstdlib>
+#include <vector>
+
+/// Bump allocator for short-lived containers. Memory is carved out of
+/// large chunks and never freed piece by piece; release() makes all of it
+/// available again at once. Not thread-safe.
+class MonotonicArena
+{
+public:
+    typedef size_t size_type;
+
+    static const size_type DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+public:
+    explicit MonotonicArena(const size_type chunkSize = DEFAULT_CHUNK_SIZE);
+    ~MonotonicArena();
+
+    void*     allocate(const size_type bytes, const size_type alignment);
+    void      release();
+    size_type bytesAllocated() const;
+
+private:
+    MonotonicArena(const MonotonicArena& rhv);
+    MonotonicArena& operator=(const MonotonicArena& rhv);
+
+    void addChunk(const size_type minimumBytes);
+
+private:
+    std::vector<char*>    chunks_;
+    std::vector<size_type> chunkSizes_;
+    size_type chunkSize_;
+    char*     cursor_;
+    char*     limit_;
+    size_type bytesAllocated_;
+};
+
+#endif /// __MONOTONIC_ARENA_HPP__
+
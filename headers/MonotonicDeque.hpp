@@ -0,0 +1,59 @@
+#ifndef __MONOTONIC_DEQUE_HPP__
+#define __MONOTONIC_DEQUE_HPP__
+
+#include "Deque.hpp"
+
+#include <cstdlib>
+#include <functional>
+
+/// Sliding-window minimum and maximum in amortized O(1) per element. Two
+/// Deques keep only the candidates: minimums_ holds values increasing under
+/// Compare from front to back, maximums_ values decreasing, each tagged with
+/// the stamp it was pushed with. A push drops from the back every candidate
+/// it makes obsolete; expiry drops from the front.
+///
+/// Count windows use push(value), which stamps with the number of earlier
+/// pushes, and keep_last(count). Time windows use push(value, time) with
+/// non-decreasing times and expire_older_than(time). Do not mix the two.
+template <typename T, typename Compare = std::less<T>, typename Stamp = unsigned long long>
+class MonotonicDeque
+{
+public:
+    typedef size_t   size_type;
+    typedef T        value_type;
+    typedef const T& const_reference;
+    typedef Stamp    stamp_type;
+
+public:
+    explicit MonotonicDeque(const Compare& compare = Compare());
+
+    void push(const_reference value);
+    void push(const_reference value, const Stamp stamp);
+    void expire_older_than(const Stamp stamp);
+    void keep_last(const size_type count);
+    void clear();
+
+    const_reference min() const;
+    const_reference max() const;
+    bool            empty()  const;
+    size_type       pushed() const;
+
+private:
+    struct entry {
+        T     value;
+        Stamp stamp;
+    };
+
+    static void expire(Deque<entry>& candidates, const Stamp stamp);
+
+private:
+    Compare      compare_;
+    Deque<entry> minimums_;
+    Deque<entry> maximums_;
+    size_type    pushed_;
+};
+
+#include "../templates/MonotonicDeque.cpp"
+
+#endif /// __MONOTONIC_DEQUE_HPP__
+
@@ -0,0 +1,99 @@
+#ifndef __RING_DEQUE_HPP__
+#define __RING_DEQUE_HPP__
+
+#include "RingIterator.hpp"
+
+#include <cstdlib>
+#include <iterator>
+#include <utility>
+
+/// Double-ended queue kept in one circular buffer. The capacity is always a
+/// power of two, so the slot of a logical index is (head_ + index) & mask_
+/// and neither element access nor iteration needs a branch. When the ring is
+/// full it is unrolled into a buffer twice the size.
+template <typename T>
+class RingDeque
+{
+public:
+    typedef size_t         size_type;
+    typedef T              value_type;
+    typedef T&             reference;
+    typedef const T&       const_reference;
+    typedef T*             pointer;
+    typedef const T*       const_pointer;
+    typedef std::ptrdiff_t difference_type;
+    typedef RingConstIterator<T, MaskWrap, RingDeque<T> > const_iterator;
+    typedef RingIterator<T, MaskWrap, RingDeque<T> >      iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef std::reverse_iterator<iterator>       reverse_iterator;
+
+            ///======RING_DEQUE======
+public:
+    RingDeque();
+    RingDeque(const size_type newSize, const_reference initialValue = T());
+    RingDeque(const int newSize, const_reference initialValue = T());
+    RingDeque(const RingDeque<T>& rhv);
+    RingDeque(RingDeque<T>&& rhv) noexcept;
+    template <typename InputIterator>
+    RingDeque(InputIterator first, InputIterator last);
+    ~RingDeque();
+
+    RingDeque<T>&   operator=(const RingDeque<T>& rhv);
+    RingDeque<T>&   operator=(RingDeque<T>&& rhv) noexcept;
+    bool            operator==(const RingDeque<T>& rhv) const;
+    bool            operator!=(const RingDeque<T>& rhv) const;
+    bool            operator<(const RingDeque<T>& rhv)  const;
+    bool            operator>(const RingDeque<T>& rhv)  const;
+    bool            operator<=(const RingDeque<T>& rhv) const;
+    bool            operator>=(const RingDeque<T>& rhv) const;
+    reference       operator[](const size_type index);
+    const_reference operator[](const size_type index) const;
+
+    template <typename... Args>
+    reference emplace_front(Args&&... args);
+    template <typename... Args>
+    reference emplace_back(Args&&... args);
+    void push_front(const_reference value);
+    void push_front(value_type&& value);
+    void push_back(const_reference value);
+    void push_back(value_type&& value);
+    void pop_front();
+    void pop_back();
+    reference       front();
+    const_reference front() const;
+    reference       back();
+    const_reference back()  const;
+
+    void      resize(const size_type newSize, const_reference initialValue = T());
+    void      reserve(const size_type newCapacity);
+    size_type capacity() const;
+    size_type max_size() const;
+    size_type size()     const;
+    bool      empty()    const;
+    void      clear();
+    void      swap(RingDeque<T>& rhv) noexcept;
+
+    const_iterator         begin()  const;
+    const_iterator         end()    const;
+    const_reverse_iterator rbegin() const;
+    const_reverse_iterator rend()   const;
+
+    iterator         begin();
+    iterator         end();
+    reverse_iterator rbegin();
+    reverse_iterator rend();
+
+private:
+    void grow(const size_type newCapacity);
+
+private:
+    pointer   buffer_;
+    size_type mask_;     /// capacity - 1
+    size_type head_;
+    size_type size_;
+};
+
+#include "../templates/RingDeque.cpp"
+
+#endif /// __RING_DEQUE_HPP__
+
@@ -0,0 +1,106 @@
+#ifndef __RING_ITERATOR_HPP__
+#define __RING_ITERATOR_HPP__
+
+#include <cstdlib>
+#include <iterator>
+
+/// Random-access iterators over a circular buffer, shared by RingDeque and
+/// CircularDeque. position_ is the unwrapped head + index, so ordering
+/// survives the wrap; Wrap::slot(position, bound) turns it into a buffer
+/// slot. Only Container makes iterators that point into a buffer.
+
+/// RingDeque: the capacity is a power of two and bound is capacity - 1.
+struct MaskWrap
+{
+    static size_t slot(const size_t position, const size_t mask);
+};
+
+/// CircularDeque: bound is the capacity and positions stay below twice
+/// it, so one compare replaces a modulo.
+struct CapacityWrap
+{
+    static size_t slot(const size_t position, const size_t capacity);
+};
+                                          ///====CONST_ITERATOR====
+template <typename T, typename Wrap, typename Container>
+class RingConstIterator {
+    friend Container;
+public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef T                               value_type;
+    typedef std::ptrdiff_t                  difference_type;
+    typedef size_t                          size_type;
+    typedef const T*                        pointer;
+    typedef const T&                        reference;
+
+    RingConstIterator();
+    RingConstIterator(const RingConstIterator& rhv);
+    ~RingConstIterator();
+
+    RingConstIterator& operator=(const RingConstIterator& rhv);
+    reference          operator*()                                const;
+    pointer            operator->()                               const;
+    reference          operator[](const difference_type index)    const;
+    RingConstIterator& operator++();
+    RingConstIterator  operator++(int);
+    RingConstIterator& operator--();
+    RingConstIterator  operator--(int);
+    RingConstIterator  operator+(const difference_type size)      const;
+    RingConstIterator  operator-(const difference_type size)      const;
+    RingConstIterator& operator+=(const difference_type size);
+    RingConstIterator& operator-=(const difference_type size);
+    difference_type    operator-(const RingConstIterator& rhv)    const;
+    bool               operator==(const RingConstIterator& rhv)   const;
+    bool               operator!=(const RingConstIterator& rhv)   const;
+    bool               operator<(const RingConstIterator& rhv)    const;
+    bool               operator>(const RingConstIterator& rhv)    const;
+    bool               operator<=(const RingConstIterator& rhv)   const;
+    bool               operator>=(const RingConstIterator& rhv)   const;
+
+protected:
+    explicit RingConstIterator(const T* buffer, const size_type bound, const size_type position);
+
+    T* element(const size_type position) const;
+
+protected:
+    T*        buffer_;
+    size_type bound_;
+    size_type position_;
+};
+                                        /// ====ITERATOR====
+template <typename T, typename Wrap, typename Container>
+class RingIterator : public RingConstIterator<T, Wrap, Container> {
+    friend Container;
+    typedef RingConstIterator<T, Wrap, Container> const_iterator;
+public:
+    typedef typename const_iterator::difference_type difference_type;
+    typedef typename const_iterator::size_type       size_type;
+    typedef T*                                       pointer;
+    typedef T&                                       reference;
+
+    RingIterator();
+    RingIterator(const RingIterator& rhv);
+    ~RingIterator();
+
+    using const_iterator::operator-;
+    RingIterator& operator=(const RingIterator& rhv);
+    reference     operator*()                             const;
+    pointer       operator->()                            const;
+    reference     operator[](const difference_type index) const;
+    RingIterator& operator++();
+    RingIterator  operator++(int);
+    RingIterator& operator--();
+    RingIterator  operator--(int);
+    RingIterator  operator+(const difference_type size)   const;
+    RingIterator  operator-(const difference_type size)   const;
+    RingIterator& operator+=(const difference_type size);
+    RingIterator& operator-=(const difference_type size);
+
+private:
+    explicit RingIterator(T* buffer, const size_type bound, const size_type position);
+};
+
+#include "../templates/RingIterator.cpp"
+
+#endif /// __RING_ITERATOR_HPP__
+
@@ -0,0 +1,16 @@
+#ifndef __SMALL_DEQUE_HPP__
+#define __SMALL_DEQUE_HPP__
+
+#include "Deque.hpp"
+#include "SmallVector.hpp"
+
+#include <memory>
+
+/// Deque whose halves each keep up to N elements inside the object, so a
+/// deque that never holds more than N elements at either end never
+/// allocates. Past that a half spills to Allocator like a std::vector.
+template <typename T, size_t N, typename Allocator = std::allocator<T> >
+using SmallDeque = Deque<T, Allocator, SmallVector<T, N, Allocator> >;
+
+#endif /// __SMALL_DEQUE_HPP__
+
@@ -0,0 +1,124 @@
+#ifndef __SMALL_VECTOR_HPP__
+#define __SMALL_VECTOR_HPP__
+
+#include <cstdlib>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/// Vector-like sequence that keeps its first N elements in a buffer inside
+/// the object and moves to an Allocator buffer only when it outgrows it.
+/// Elements stay contiguous either way, so iterators are plain pointers.
+/// Plug it into a deque as Deque<T, Allocator, SmallVector<T, N, Allocator> >,
+/// or use SmallDeque<T, N> from headers/SmallDeque.hpp.
+template <typename T, size_t N, typename Allocator = std::allocator<T> >
+class SmallVector
+{
+    static_assert(N > 0, "SmallVector needs room for at least one inline element");
+
+public:
+    typedef Allocator      allocator_type;
+    typedef size_t         size_type;
+    typedef T              value_type;
+    typedef T&             reference;
+    typedef const T&       const_reference;
+    typedef T*             pointer;
+    typedef const T*       const_pointer;
+    typedef T*             iterator;
+    typedef const T*       const_iterator;
+    typedef std::ptrdiff_t difference_type;
+
+    static const size_type INLINE_CAPACITY = N;
+
+public:
+    SmallVector();
+    explicit SmallVector(const Allocator& allocator);
+    SmallVector(const SmallVector<T, N, Allocator>& rhv);
+    SmallVector(SmallVector<T, N, Allocator>&& rhv) noexcept(nothrow_move_construction::value);
+    ~SmallVector();
+
+    SmallVector<T, N, Allocator>& operator=(const SmallVector<T, N, Allocator>& rhv);
+    SmallVector<T, N, Allocator>& operator=(SmallVector<T, N, Allocator>&& rhv) noexcept(nothrow_move_assignment::value);
+    reference       operator[](const size_type index);
+    const_reference operator[](const size_type index) const;
+
+    template <typename InputIterator>
+    void     assign(InputIterator first, InputIterator last);
+    template <typename InputIterator, typename = typename std::enable_if<!std::is_integral<InputIterator>::value>::type>
+    void     insert(iterator position, InputIterator first, InputIterator last);
+    void     insert(iterator position, const size_type size, const_reference value);
+    iterator insert(iterator position, const_reference value);
+    iterator insert(iterator position, value_type&& value);
+    template <typename... Args>
+    iterator emplace(iterator position, Args&&... args);
+    iterator erase(iterator position);
+    iterator erase(iterator first, iterator last);
+    template <typename... Args>
+    void emplace_back(Args&&... args);
+    void push_back(const_reference value);
+    void push_back(value_type&& value);
+    void pop_back();
+    reference       front();
+    const_reference front() const;
+    reference       back();
+    const_reference back()  const;
+
+    void      resize(const size_type newSize);
+    void      resize(const size_type newSize, const_reference initialValue);
+    void      reserve(const size_type newCapacity);
+    size_type capacity() const;
+    void      shrink_to_fit();
+    size_type max_size() const;
+    size_type size()     const;
+    bool      empty()    const;
+    bool      is_inline() const;
+    void      clear();
+    void      swap(SmallVector<T, N, Allocator>& rhv) noexcept(nothrow_move_assignment::value);
+    allocator_type get_allocator() const;
+
+    pointer       data();
+    const_pointer data() const;
+
+    const_iterator begin() const;
+    const_iterator end()   const;
+    iterator       begin();
+    iterator       end();
+
+private:
+    typedef std::allocator_traits<Allocator> traits;
+    /// Inline elements are moved one by one, and a move assignment that
+    /// cannot adopt a spilled buffer moves them into its own, which may
+    /// allocate. swap is three moves when either side is inline.
+    typedef std::is_nothrow_move_constructible<T> nothrow_move_construction;
+    typedef std::integral_constant<bool, nothrow_move_construction::value
+                                      && (traits::propagate_on_container_move_assignment::value
+                                       || traits::is_always_equal::value)> nothrow_move_assignment;
+
+    pointer   inline_data();
+    size_type grown_capacity(const size_type wanted) const;
+    void      relocate(pointer buffer, const size_type newCapacity);
+    template <typename ForwardIterator>
+    void      insert_range(const size_type index, ForwardIterator first, ForwardIterator last, std::true_type);
+    template <typename InputIterator>
+    void      insert_range(const size_type index, InputIterator first, InputIterator last, std::false_type);
+    template <typename ForwardIterator>
+    void      construct_range(pointer destination, ForwardIterator first, const size_type count);
+    void      construct_run(pointer destination, const_pointer source, const size_type count, std::true_type);
+    void      construct_run(pointer destination, const_pointer source, const size_type count, std::false_type);
+    void      relocate_run(pointer destination, pointer source, const size_type count, std::true_type);
+    void      relocate_run(pointer destination, pointer source, const size_type count, std::false_type);
+    void      release();
+    void      destroy_from(const size_type newSize);
+
+private:
+    Allocator allocator_;
+    pointer   data_;     /// inline_ until the first spill
+    size_type size_;
+    size_type capacity_;
+    alignas(T) unsigned char inline_[N * sizeof(T)];
+};
+
+#include "../templates/SmallVector.cpp"
+
+#endif /// __SMALL_VECTOR_HPP__
+
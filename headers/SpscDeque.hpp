@@ -0,0 +1,71 @@
+#ifndef __SPSC_DEQUE_HPP__
+#define __SPSC_DEQUE_HPP__
+
+#include <atomic>
+#include <cstdlib>
+
+/// Bounded single-producer/single-consumer queue on a power-of-two ring.
+/// One thread pushes at the back and one other thread pops at the front;
+/// neither ever blocks or retries, so every call is wait-free. head_ and
+/// tail_ live on separate cache lines, each next to the owner's cached copy
+/// of the other index, and are published with release and read with acquire.
+template <typename T>
+class SpscDeque
+{
+public:
+    typedef size_t         size_type;
+    typedef T              value_type;
+    typedef T&             reference;
+    typedef const T&       const_reference;
+    typedef T*             pointer;
+    typedef const T*       const_pointer;
+    typedef std::ptrdiff_t difference_type;
+
+    static const size_type CACHE_LINE = 64;
+
+public:
+    explicit SpscDeque(const size_type capacity);
+    ~SpscDeque();
+
+                                      ///====PRODUCER====
+    bool try_push_back(const_reference value);
+    bool try_push_back(value_type&& value);
+    template <typename... Args>
+    bool try_emplace_back(Args&&... args);
+    template <typename InputIterator>
+    size_type try_push_back_n(InputIterator first, const size_type count);
+
+                                      ///====CONSUMER====
+    bool try_pop_front(reference value);
+    template <typename OutputIterator>
+    size_type try_pop_front_n(OutputIterator out, const size_type count);
+    reference front();
+    void      pop_front();
+
+    size_type capacity() const;
+    size_type max_size() const;
+    size_type size()     const;
+    bool      empty()    const;
+
+private:
+    SpscDeque(const SpscDeque<T>& rhv);
+    SpscDeque<T>& operator=(const SpscDeque<T>& rhv);
+
+    size_type free_slots(const size_type tail, const size_type wanted);
+    size_type filled_slots(const size_type head, const size_type wanted);
+
+private:
+    pointer   buffer_;
+    size_type mask_;     /// capacity - 1
+
+    alignas(CACHE_LINE) std::atomic<size_type> head_; /// next slot to pop, written by the consumer
+    size_type tailCache_;
+
+    alignas(CACHE_LINE) std::atomic<size_type> tail_; /// next slot to push, written by the producer
+    size_type headCache_;
+};
+
+#include "../templates/SpscDeque.cpp"
+
+#endif /// __SPSC_DEQUE_HPP__
+
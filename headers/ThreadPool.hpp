@@ -0,0 +1,49 @@
+#ifndef __THREAD_POOL_HPP__
+#define __THREAD_POOL_HPP__
+
+#include "ConcurrentDeque.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <vector>
+
+/// Fixed set of worker threads fed from a ConcurrentDeque of jobs. run()
+/// is a blocking parallel loop: the calling thread takes part, so a pool
+/// of n workers runs a loop on n + 1 threads and a pool of none runs it
+/// inline.
+class ThreadPool
+{
+public:
+    typedef size_t size_type;
+
+public:
+    explicit ThreadPool(const size_type workers = default_workers());
+    ~ThreadPool();
+
+    /// Calls task(i) once for every i in [0, tasks), each on some thread,
+    /// and returns when all have finished. The first exception thrown by a
+    /// task is rethrown here after the rest have run. A task must not call
+    /// run() on the same pool: its helpers could wait for busy workers.
+    void run(const size_type tasks, const std::function<void(size_type)>& task);
+
+    size_type workers() const;
+    size_type threads() const;
+
+    static size_type default_workers();
+
+private:
+    typedef std::function<void()> job;
+
+    ThreadPool(const ThreadPool& rhv);
+    ThreadPool& operator=(const ThreadPool& rhv);
+
+    void work();
+
+private:
+    ConcurrentDeque<job> jobs_;
+    std::vector<std::thread> workers_;
+};
+
+#endif /// __THREAD_POOL_HPP__
+
@@ -0,0 +1,70 @@
+#ifndef __WORK_STEALING_DEQUE_HPP__
+#define __WORK_STEALING_DEQUE_HPP__
+
+#include <atomic>
+#include <cstdlib>
+#include <vector>
+
+/// Chase-Lev work-stealing deque. The owning thread pushes and pops at the
+/// back without locks; any other thread may steal() from the front. The
+/// elements live in a growable circular array; arrays outgrown by the owner
+/// are kept until destruction, since a thief may still be reading one.
+/// T is copied in and out through std::atomic<T>, so it must be trivially
+/// copyable; task pointers are the usual choice.
+template <typename T>
+class WorkStealingDeque
+{
+public:
+    typedef size_t         size_type;
+    typedef T              value_type;
+    typedef const T&       const_reference;
+    typedef std::ptrdiff_t difference_type;
+
+    static const size_type CACHE_LINE = 64;
+
+public:
+    explicit WorkStealingDeque(const size_type capacity = 64);
+    ~WorkStealingDeque();
+
+    void push_back(const_reference value);
+    bool pop_back(value_type& value);
+    bool steal(value_type& value);
+
+    size_type capacity() const;
+    size_type size()     const;
+    bool      empty()    const;
+
+private:
+    WorkStealingDeque(const WorkStealingDeque<T>& rhv);
+    WorkStealingDeque<T>& operator=(const WorkStealingDeque<T>& rhv);
+
+    class Array {
+    public:
+        explicit Array(const size_type capacity);
+        ~Array();
+
+        size_type capacity() const;
+        T         get(const difference_type index) const;
+        void      put(const difference_type index, const_reference value);
+        Array*    grow(const difference_type top, const difference_type bottom) const;
+
+    private:
+        Array(const Array& rhv);
+        Array& operator=(const Array& rhv);
+
+    private:
+        size_type mask_;
+        std::atomic<T>* slots_;
+    };
+
+private:
+    alignas(CACHE_LINE) std::atomic<difference_type> top_;    /// next to steal, advanced by CAS
+    alignas(CACHE_LINE) std::atomic<difference_type> bottom_; /// next free slot, written by the owner
+    std::atomic<Array*> array_;
+    std::vector<Array*> retired_;
+};
+
+#include "../templates/WorkStealingDeque.cpp"
+
+#endif /// __WORK_STEALING_DEQUE_HPP__
+
@@ -0,0 +1,68 @@
+#include "benchmarks/Benchmark.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+struct Benchmark
+{
+    const char* name;
+    void (*run)();
+};
+
+const Benchmark BENCHMARKS[] = {
+    { "FifoDrain",        benchFifoDrain },
+    { "SegmentedStorage", benchSegmentedStorage },
+    { "RingStorage",      benchRingStorage },
+    { "MoveSemantics",    benchMoveSemantics },
+    { "Allocators",       benchAllocators },
+    { "BulkEdit",         benchBulkEdit },
+    { "Snapshot",         benchSnapshot },
+    { "Reserve",          benchReserve },
+    { "SpscHandoff",      benchSpscHandoff },
+    { "ForkJoin",         benchForkJoin },
+    { "Contention",       benchContention },
+    { "Traversal",        benchTraversal },
+    { "Segments",         benchSegments },
+    { "Compare",          benchCompare },
+    { "TrivialCopy",      benchTrivialCopy },
+    { "SmallBuffer",      benchSmallBuffer },
+    { "Suite",            benchSuite },
+    { "Statistics",       benchStatistics },
+    { "RollingWindow",    benchRollingWindow },
+    { "SlidingMinMax",    benchSlidingMinMax },
+    { "MappedStorage",    benchMappedStorage },
+    { "Serialization",    benchSerialization },
+    { "Parallel",         benchParallel },
+    { "ParallelSort",     benchParallelSort },
+    { "BatchIngest",      benchBatchIngest },
+};
+
+} /// namespace
+
+/// Runs every benchmark, or only those named on the command line.
+int
+main(int argc, char** argv)
+{
+    bool ran = false;
+    for (size_t i = 0; i < sizeof(BENCHMARKS) / sizeof(BENCHMARKS[0]); ++i) {
+        bool selected = argc < 2;
+        for (int arg = 1; arg < argc && !selected; ++arg) {
+            selected = 0 == std::strcmp(argv[arg], BENCHMARKS[i].name);
+        }
+        if (selected) {
+            BENCHMARKS[i].run();
+            ran = true;
+        }
+    }
+    if (!ran) {
+        std::fprintf(stderr, "no benchmark matches; available:");
+        for (size_t i = 0; i < sizeof(BENCHMARKS) / sizeof(BENCHMARKS[0]); ++i) {
+            std::fprintf(stderr, " %s", BENCHMARKS[i].name);
+        }
+        std::fprintf(stderr, "\n");
+        return 1;
+    }
+    return 0;
+}
@@ -1,5 +1,36 @@
 #include "gtest/gtest.h"
 #include "headers/Deque.hpp"
+#include "headers/BlockVector.hpp"
+#include "headers/RingDeque.hpp"
+#include "headers/ArenaAllocator.hpp"
+#include "headers/ConcurrentDeque.hpp"
+#include "headers/SpscDeque.hpp"
+#include "headers/WorkStealingDeque.hpp"
+#include "headers/SmallDeque.hpp"
+#include "headers/DequeStatistics.hpp"
+#include "headers/CircularDeque.hpp"
+#include "headers/MonotonicDeque.hpp"
+#include "headers/MappedDeque.hpp"
+#include "headers/DequeSerialization.hpp"
+#include "headers/DequeParallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <unistd.h>
 
 TEST(DequeBasicTest, EmptyDeque)
 {
@@ -511,6 +542,1959 @@ TEST(DequeTest, InsertIntoEmpty) {
     EXPECT_EQ(d.back(), 42);
 }
 
+TEST(DequeTest, FifoDrainKeepsOrder)
+{
+    Deque<int> d;
+    for (int i = 0; i < 1000; ++i) {
+        d.push_back(i);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(d.front(), i);
+        ASSERT_EQ(d.back(), 999);
+        d.pop_front();
+    }
+    EXPECT_TRUE(d.empty());
+}
+
+TEST(DequeTest, LifoFromFrontKeepsOrder)
+{
+    Deque<int> d;
+    for (int i = 0; i < 1000; ++i) {
+        d.push_front(i);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(d.back(), i);
+        d.pop_back();
+    }
+    EXPECT_TRUE(d.empty());
+}
+
+TEST(DequeTest, MixedEndsAfterRebalance)
+{
+    Deque<int> d;
+    for (int i = 0; i < 10; ++i) {
+        d.push_back(i);
+    }
+    d.pop_front();
+    d.push_front(100);
+    d.push_back(10);
+    EXPECT_EQ(d.size(), 11u);
+    EXPECT_EQ(d[0], 100);
+    for (int i = 1; i < 11; ++i) {
+        EXPECT_EQ(d[i], i);
+    }
+    for (int i = 10; i >= 1; --i) {
+        EXPECT_EQ(d.back(), i);
+        d.pop_back();
+    }
+    EXPECT_EQ(d.front(), 100);
+    EXPECT_EQ(d.back(), 100);
+}
+
+TEST(BlockVectorTest, PushBackAcrossBlocksKeepsAddresses)
+{
+    const size_t count = BlockVector<int>::BLOCK_SIZE * 3 + 5;
+    BlockVector<int> v;
+    v.push_back(0);
+    const int* first = &v.front();
+    for (size_t i = 1; i < count; ++i) {
+        v.push_back(static_cast<int>(i));
+    }
+    EXPECT_EQ(v.size(), count);
+    EXPECT_EQ(first, &v.front());
+    for (size_t i = 0; i < count; ++i) {
+        ASSERT_EQ(v[i], static_cast<int>(i));
+    }
+}
+
+TEST(BlockVectorTest, InsertEraseInMiddle)
+{
+    BlockVector<int> v;
+    for (int i = 0; i < 10; ++i) {
+        v.push_back(i);
+    }
+    v.insert(v.begin() + 5, 100);
+    EXPECT_EQ(v.size(), 11u);
+    EXPECT_EQ(v[5], 100);
+    EXPECT_EQ(v[6], 5);
+    v.erase(v.begin() + 2, v.begin() + 6);
+    EXPECT_EQ(v.size(), 7u);
+    EXPECT_EQ(v[1], 1);
+    EXPECT_EQ(v[2], 5);
+    EXPECT_EQ(v.back(), 9);
+}
+
+TEST(DequeBlockStorageTest, MatchesVectorStorage)
+{
+    Deque<int> expected;
+    Deque<int, std::allocator<int>, BlockVector<int> > d;
+    for (int i = 0; i < 5000; ++i) {
+        if (i % 3 == 0) {
+            expected.push_front(i);
+            d.push_front(i);
+        } else {
+            expected.push_back(i);
+            d.push_back(i);
+        }
+        if (i % 7 == 0) {
+            expected.pop_front();
+            d.pop_front();
+        }
+    }
+    ASSERT_EQ(d.size(), expected.size());
+    for (size_t i = 0; i < d.size(); ++i) {
+        ASSERT_EQ(d[i], expected[i]);
+    }
+}
+
+TEST(DequeBlockStorageTest, IteratorsAndInsert)
+{
+    Deque<int, std::allocator<int>, BlockVector<int> > d;
+    d.push_back(1);
+    d.push_back(3);
+    d.push_front(0);
+
+    Deque<int, std::allocator<int>, BlockVector<int> >::iterator it = d.insert(d.begin() + 2, 2);
+    EXPECT_EQ(*it, 2);
+
+    int expected = 0;
+    for (Deque<int, std::allocator<int>, BlockVector<int> >::const_iterator ci = d.begin(); ci != d.end(); ++ci) {
+        EXPECT_EQ(*ci, expected++);
+    }
+    EXPECT_EQ(expected, 4);
+
+    for (Deque<int, std::allocator<int>, BlockVector<int> >::reverse_iterator ri = d.rbegin(); ri != d.rend(); ++ri) {
+        EXPECT_EQ(*ri, --expected);
+    }
+    EXPECT_EQ(expected, 0);
+}
+
+TEST(DequeTest, ReverseIteration)
+{
+    Deque<int> d;
+    d.push_back(2);
+    d.push_front(1);
+    d.push_back(3);
+
+    Deque<int>::const_reverse_iterator it = d.rbegin();
+    EXPECT_EQ(*it, 3); ++it;
+    EXPECT_EQ(*it, 2); ++it;
+    EXPECT_EQ(*it, 1); ++it;
+    EXPECT_TRUE(it == d.rend());
+}
+
+TEST(DequeTest, EraseAcrossHalves)
+{
+    Deque<int> d;
+    d.push_front(1);
+    d.push_front(0);
+    d.push_back(2);
+    d.push_back(3);
+
+    d.erase(d.begin() + 1, d.begin() + 3);
+    EXPECT_EQ(d.size(), 2u);
+    EXPECT_EQ(d.front(), 0);
+    EXPECT_EQ(d.back(), 3);
+}
+
+/// Builds 0..7 with four elements in each half.
+template <typename DequeType>
+DequeType
+splitSample()
+{
+    DequeType d;
+    for (int i = 3; i >= 0; --i) {
+        d.push_front(i);
+    }
+    for (int i = 4; i < 8; ++i) {
+        d.push_back(i);
+    }
+    return d;
+}
+
+TEST(DequeBulkTest, InsertCopiesIntoEitherHalf)
+{
+    Deque<int> d = splitSample<Deque<int> >();
+    d.insert(d.begin() + 1, 3u, -1);
+    d.insert(d.end() - 1, 2u, -2);
+    const int expected[] = { 0, -1, -1, -1, 1, 2, 3, 4, 5, 6, -2, -2, 7 };
+    ASSERT_EQ(d.size(), 13u);
+    for (size_t i = 0; i < d.size(); ++i) {
+        EXPECT_EQ(d[i], expected[i]);
+    }
+}
+
+TEST(DequeBulkTest, InsertRangeKeepsOrder)
+{
+    Deque<int> d = splitSample<Deque<int> >();
+    const std::list<int> forward = { 10, 11, 12 };
+    d.insert(d.begin() + 2, forward.begin(), forward.end());
+    std::istringstream stream("20 21");
+    d.insert(d.begin() + 9, std::istream_iterator<int>(stream), std::istream_iterator<int>());
+    const int expected[] = { 0, 1, 10, 11, 12, 2, 3, 4, 5, 20, 21, 6, 7 };
+    ASSERT_EQ(d.size(), 13u);
+    for (size_t i = 0; i < d.size(); ++i) {
+        EXPECT_EQ(d[i], expected[i]);
+    }
+}
+
+TEST(DequeBulkTest, EraseRangeWithinAndAcrossHalves)
+{
+    Deque<int> d = splitSample<Deque<int> >();
+    Deque<int>::iterator it = d.erase(d.begin() + 1, d.begin() + 3);
+    EXPECT_EQ(*it, 3);
+    d.erase(d.begin() + 1, d.end() - 1);
+    ASSERT_EQ(d.size(), 2u);
+    EXPECT_EQ(d.front(), 0);
+    EXPECT_EQ(d.back(), 7);
+}
+
+/// Random bulk edits checked against std::deque.
+template <typename DequeType>
+void
+checkBulkAgainstStd()
+{
+    DequeType d;
+    std::deque<size_t> reference;
+    std::srand(7);
+    for (int round = 0; round < 300; ++round) {
+        const size_t position = reference.empty() ? 0 : std::rand() % (reference.size() + 1);
+        const size_t count = std::rand() % 20;
+        switch (std::rand() % 4) {
+        case 0:
+            d.insert(d.begin() + position, count, static_cast<size_t>(round));
+            reference.insert(reference.begin() + position, count, static_cast<size_t>(round));
+            break;
+        case 1: {
+            std::vector<size_t> values(count);
+            for (size_t i = 0; i < count; ++i) values[i] = round * 100 + i;
+            d.insert(d.begin() + position, values.begin(), values.end());
+            reference.insert(reference.begin() + position, values.begin(), values.end());
+            break;
+        }
+        case 2: {
+            const size_t last = std::min(reference.size(), position + count);
+            d.erase(d.begin() + position, d.begin() + last);
+            reference.erase(reference.begin() + position, reference.begin() + last);
+            break;
+        }
+        default:
+            d.push_front(round);
+            reference.push_front(round);
+            d.pop_back();
+            reference.pop_back();
+            break;
+        }
+        ASSERT_EQ(d.size(), reference.size());
+        for (size_t i = 0; i < reference.size(); ++i) {
+            ASSERT_EQ(d[i], reference[i]);
+        }
+    }
+}
+
+TEST(DequeBulkTest, MatchesStdDeque)
+{
+    checkBulkAgainstStd<Deque<size_t> >();
+    checkBulkAgainstStd<Deque<size_t, std::allocator<size_t>, BlockVector<size_t> > >();
+}
+
+/// Edits spanning several blocks, checked against std::vector; trivially
+/// copyable values take the memmove paths, strings the element-wise ones.
+template <typename Value>
+void
+checkBlockBulkEdits(Value (*make)(size_t))
+{
+    BlockVector<Value> v;
+    std::vector<Value> reference;
+    const size_t block = BlockVector<Value>::BLOCK_SIZE;
+    std::srand(11);
+    for (int round = 0; round < 60; ++round) {
+        const size_t position = std::rand() % (reference.size() + 1);
+        const size_t count = std::rand() % (3 * block);
+        switch (std::rand() % 4) {
+        case 0:
+            v.insert(v.begin() + position, count, make(round));
+            reference.insert(reference.begin() + position, count, make(round));
+            break;
+        case 1: {
+            std::vector<Value> values;
+            for (size_t i = 0; i < count; ++i) values.push_back(make(round * 10000 + i));
+            v.insert(v.begin() + position, values.begin(), values.end());
+            reference.insert(reference.begin() + position, values.begin(), values.end());
+            break;
+        }
+        case 2: {
+            const size_t last = std::min(reference.size(), position + count);
+            v.erase(v.begin() + position, v.begin() + last);
+            reference.erase(reference.begin() + position, reference.begin() + last);
+            break;
+        }
+        default:
+            v.resize(position + count);
+            reference.resize(position + count);
+            break;
+        }
+        ASSERT_EQ(v.size(), reference.size());
+        ASSERT_TRUE(std::equal(reference.begin(), reference.end(), v.begin()));
+    }
+    v.resize(v.size() + block, make(1));
+    v.resize(1);
+    v.clear();
+    EXPECT_TRUE(v.empty());
+}
+
+int
+makeInt(const size_t i)
+{
+    return static_cast<int>(i);
+}
+
+std::string
+makeString(const size_t i)
+{
+    return std::to_string(i);
+}
+
+TEST(BlockVectorTest, BulkEditsMatchVector)
+{
+    checkBlockBulkEdits<int>(makeInt);
+    checkBlockBulkEdits<std::string>(makeString);
+}
+
+TEST(DequeBulkTest, ResizeAcrossHalves)
+{
+    Deque<int> d = splitSample<Deque<int> >();
+    d.resize(6);
+    EXPECT_EQ(d.back(), 5);
+    d.resize(2);
+    ASSERT_EQ(d.size(), 2u);
+    EXPECT_EQ(d[0], 0);
+    EXPECT_EQ(d[1], 1);
+    d.resize(5, 9);
+    EXPECT_EQ(d[4], 9);
+    d.resize(7);
+    EXPECT_EQ(d[6], 0);
+
+    const std::vector<int> values = { 4, 5, 6 };
+    Deque<int, std::allocator<int>, BlockVector<int> > blocks(values.begin(), values.end());
+    blocks.resize(BlockVector<int>::BLOCK_SIZE * 3, 7);
+    EXPECT_EQ(blocks[2], 6);
+    EXPECT_EQ(blocks.back(), 7);
+    blocks.resize(1);
+    EXPECT_EQ(blocks.back(), 4);
+}
+
+TEST(DequeCopyTest, CopyKeepsBothHalves)
+{
+    Deque<int> d = splitSample<Deque<int> >();
+    Deque<int> copy(d);
+    EXPECT_TRUE(copy == d);
+    copy.pop_front();
+    EXPECT_EQ(copy.front(), 1);
+    EXPECT_EQ(d.front(), 0);
+}
+
+TEST(DequeCopyTest, BlockStorageCopyAndAssign)
+{
+    typedef Deque<std::string, std::allocator<std::string>, BlockVector<std::string> > StringDeque;
+    const size_t count = BlockVector<std::string>::BLOCK_SIZE * 2 + 3;
+    StringDeque d;
+    for (size_t i = 0; i < count; ++i) {
+        d.push_back(std::to_string(i));
+        d.push_front(std::to_string(i));
+    }
+    StringDeque copy(d);
+    EXPECT_TRUE(copy == d);
+
+    StringDeque smaller;
+    smaller.push_back("x");
+    copy = smaller;
+    EXPECT_TRUE(copy == smaller);
+    copy = d;
+    EXPECT_TRUE(copy == d);
+    copy = copy;
+    EXPECT_EQ(copy.size(), 2 * count);
+}
+
+/// Reserves each end, fills it and checks the first element never moved.
+template <typename DequeType>
+void
+checkReserveAvoidsReallocation()
+{
+    const size_t count = 10000;
+    DequeType d;
+    d.reserve_back(count);
+    d.reserve_front(count);
+    const size_t capacityBack = d.capacity_back();
+    const size_t capacityFront = d.capacity_front();
+    EXPECT_GE(capacityBack, count);
+    EXPECT_GE(capacityFront, count);
+
+    d.push_back(0);
+    d.push_front(-1);
+    const int* first = &d.back();
+    const int* last = &d.front();
+    for (size_t i = 1; i < count; ++i) {
+        d.push_back(static_cast<int>(i));
+        d.push_front(-static_cast<int>(i) - 1);
+    }
+    EXPECT_EQ(first, &d[count]);
+    EXPECT_EQ(last, &d[count - 1]);
+    EXPECT_EQ(d.capacity_back(), capacityBack);
+    EXPECT_EQ(d.capacity_front(), capacityFront);
+}
+
+TEST(DequeCapacityTest, ReserveAvoidsReallocation)
+{
+    checkReserveAvoidsReallocation<Deque<int> >();
+    checkReserveAvoidsReallocation<Deque<int, std::allocator<int>, BlockVector<int> > >();
+}
+
+TEST(DequeCapacityTest, ShrinkToFit)
+{
+    Deque<int, std::allocator<int>, BlockVector<int> > d;
+    d.reserve_back(BlockVector<int>::BLOCK_SIZE * 8);
+    d.push_back(1);
+    d.push_front(0);
+    d.shrink_to_fit();
+    EXPECT_EQ(d.capacity_back(), BlockVector<int>::BLOCK_SIZE);
+    EXPECT_EQ(d.front(), 0);
+    EXPECT_EQ(d.back(), 1);
+
+    Deque<int> v;
+    v.reserve_front(100);
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity_front(), 0u);
+}
+
+TEST(SpscDequeTest, BoundedFifo)
+{
+    SpscDeque<std::string> q(5);
+    EXPECT_EQ(q.capacity(), 8u);
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_TRUE(q.try_push_back(std::to_string(i)));
+    }
+    EXPECT_FALSE(q.try_push_back("full"));
+    EXPECT_EQ(q.size(), 8u);
+    EXPECT_EQ(q.front(), "0");
+    q.pop_front();
+
+    std::string value;
+    EXPECT_TRUE(q.try_pop_front(value));
+    EXPECT_EQ(value, "1");
+
+    const std::string batch[] = { "a", "b", "c" };
+    EXPECT_EQ(q.try_push_back_n(batch, 3), 2u);
+    std::vector<std::string> out;
+    EXPECT_EQ(q.try_pop_front_n(std::back_inserter(out), 100), 8u);
+    EXPECT_EQ(out.front(), "2");
+    EXPECT_EQ(out.back(), "b");
+    EXPECT_TRUE(q.empty());
+    EXPECT_FALSE(q.try_pop_front(value));
+}
+
+/// Output iterator that throws on the assignment after limit of them.
+struct LimitedSink
+{
+    typedef std::output_iterator_tag iterator_category;
+    typedef void value_type;
+    typedef void difference_type;
+    typedef void pointer;
+    typedef void reference;
+
+    std::vector<std::string>* out;
+    size_t limit;
+
+    LimitedSink& operator*() { return *this; }
+    LimitedSink& operator++() { return *this; }
+    LimitedSink& operator=(std::string&& value)
+    {
+        if (out->size() == limit) throw std::runtime_error("sink full");
+        out->push_back(std::move(value));
+        return *this;
+    }
+};
+
+/// Converts to std::string, or throws if it has no text.
+struct Word
+{
+    const char* text;
+
+    operator std::string() const
+    {
+        if (NULL == text) throw std::runtime_error("no text");
+        return text;
+    }
+};
+
+TEST(SpscDequeTest, BatchesPublishWhatTheyFinishedWhenThrowing)
+{
+    SpscDeque<std::string> q(8);
+    for (int i = 0; i < 6; ++i) {
+        q.try_push_back(std::to_string(i));
+    }
+    std::vector<std::string> out;
+    LimitedSink sink = { &out, 2 };
+    EXPECT_THROW(q.try_pop_front_n(sink, 5), std::runtime_error);
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_EQ(q.size(), 4u);
+    EXPECT_EQ(q.front(), "2");
+
+    std::istringstream text("a b");
+    std::istream_iterator<std::string> first(text);
+    EXPECT_EQ(q.try_push_back_n(first, 2), 2u);
+    EXPECT_EQ(q.size(), 6u);
+    out.clear();
+    LimitedSink all = { &out, 100 };
+    EXPECT_EQ(q.try_pop_front_n(all, 100), 6u);
+    EXPECT_EQ(out.front(), "2");
+    EXPECT_EQ(out.back(), "b");
+
+    const Word words[] = { { "x" }, { "y" }, { NULL }, { "z" } };
+    EXPECT_THROW(q.try_push_back_n(words, 4), std::runtime_error);
+    EXPECT_EQ(q.size(), 2u);
+    EXPECT_EQ(q.front(), "x");
+}
+
+TEST(SpscDequeTest, TwoThreadsKeepOrder)
+{
+    const long count = 1000000;
+    SpscDeque<long> q(1024);
+    std::thread producer([&q, count]() {
+        long next = 0;
+        while (next < count) {
+            if (0 == next % 3) {
+                long batch[16];
+                for (long i = 0; i < 16; ++i) batch[i] = next + i;
+                const long limit = count - next < 16 ? count - next : 16;
+                next += static_cast<long>(q.try_push_back_n(batch, static_cast<size_t>(limit)));
+            } else if (q.try_push_back(next)) {
+                ++next;
+            }
+        }
+    });
+    long expected = 0;
+    bool ordered = true;
+    while (expected < count) {
+        long batch[7];
+        const size_t popped = q.try_pop_front_n(batch, 7);
+        for (size_t i = 0; i < popped; ++i) {
+            ordered = ordered && batch[i] == expected;
+            ++expected;
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(ordered);
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(WorkStealingDequeTest, OwnerLifoThiefFifo)
+{
+    WorkStealingDeque<int> d(2);
+    for (int i = 0; i < 100; ++i) {
+        d.push_back(i);
+    }
+    EXPECT_GE(d.capacity(), 100u);
+    EXPECT_EQ(d.size(), 100u);
+    int value = -1;
+    EXPECT_TRUE(d.pop_back(value));
+    EXPECT_EQ(value, 99);
+    EXPECT_TRUE(d.steal(value));
+    EXPECT_EQ(value, 0);
+    while (d.pop_back(value)) {}
+    EXPECT_EQ(value, 1);
+    EXPECT_TRUE(d.empty());
+    EXPECT_FALSE(d.steal(value));
+}
+
+TEST(WorkStealingDequeTest, EveryElementTakenOnce)
+{
+    const int count = 200000;
+    const int thieves = 3;
+    WorkStealingDeque<int> d;
+    std::vector<std::atomic<int> > taken(count);
+    std::atomic<bool> done(false);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thieves; ++t) {
+        threads.push_back(std::thread([&d, &taken, &done]() {
+            int value;
+            while (!done.load()) {
+                if (d.steal(value)) {
+                    ++taken[value];
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        }));
+    }
+    int value;
+    for (int i = 0; i < count; ++i) {
+        d.push_back(i);
+        if (0 == i % 3 && d.pop_back(value)) {
+            ++taken[value];
+        }
+    }
+    while (d.pop_back(value)) {
+        ++taken[value];
+    }
+    done.store(true);
+    for (int t = 0; t < thieves; ++t) {
+        threads[t].join();
+    }
+    int wrong = 0;
+    for (int i = 0; i < count; ++i) {
+        wrong += 1 != taken[i].load();
+    }
+    EXPECT_EQ(wrong, 0);
+}
+
+TEST(ConcurrentDequeTest, BothEndsAndRebalance)
+{
+    ConcurrentDeque<std::string> d;
+    d.push_back("1");
+    d.push_back("2");
+    d.push_front("0");
+    d.push_back("3");
+    EXPECT_EQ(d.size(), 4u);
+    std::string value;
+    EXPECT_TRUE(d.try_pop_front(value));
+    EXPECT_EQ(value, "0");
+    EXPECT_TRUE(d.try_pop_front(value));
+    EXPECT_EQ(value, "1");
+    EXPECT_TRUE(d.try_pop_back(value));
+    EXPECT_EQ(value, "3");
+    EXPECT_TRUE(d.try_pop_back(value));
+    EXPECT_EQ(value, "2");
+    EXPECT_FALSE(d.try_pop_back(value));
+    EXPECT_FALSE(d.pop_front_wait(value, std::chrono::milliseconds(5)));
+}
+
+TEST(ConcurrentDequeTest, ProducersAndWaitingConsumers)
+{
+    const int perProducer = 50000;
+    ConcurrentDeque<int> d;
+    std::vector<std::atomic<int> > taken(4 * perProducer);
+    std::vector<std::thread> threads;
+    for (int p = 0; p < 4; ++p) {
+        threads.push_back(std::thread([&d, p, perProducer]() {
+            for (int i = 0; i < perProducer; ++i) {
+                if (0 == p % 2) {
+                    d.push_back(p * perProducer + i);
+                } else {
+                    d.push_front(p * perProducer + i);
+                }
+            }
+        }));
+    }
+    for (int c = 0; c < 4; ++c) {
+        threads.push_back(std::thread([&d, &taken, c, perProducer]() {
+            int value;
+            for (int i = 0; i < perProducer; ++i) {
+                if (0 == c % 2) {
+                    d.pop_front_wait(value);
+                } else {
+                    d.pop_back_wait(value);
+                }
+                ++taken[value];
+            }
+        }));
+    }
+    for (size_t t = 0; t < threads.size(); ++t) {
+        threads[t].join();
+    }
+    int wrong = 0;
+    for (size_t i = 0; i < taken.size(); ++i) {
+        wrong += 1 != taken[i].load();
+    }
+    EXPECT_EQ(wrong, 0);
+    EXPECT_TRUE(d.empty());
+}
+
+TEST(DequeIteratorTest, RandomAccessAlgorithms)
+{
+    typedef Deque<int>::iterator Iterator;
+    static_assert(std::is_same<std::iterator_traits<Iterator>::iterator_category,
+                               std::random_access_iterator_tag>::value, "random access");
+    static_assert(std::is_same<std::iterator_traits<Deque<int>::const_reverse_iterator>::difference_type,
+                               std::ptrdiff_t>::value, "signed distance");
+
+    Deque<int> d;
+    for (int i = 0; i < 500; ++i) {
+        d.push_back((i * 7919) % 1000);
+        d.push_front((i * 104729) % 1000);
+    }
+    std::sort(d.begin(), d.end());
+    EXPECT_TRUE(std::is_sorted(d.begin(), d.end()));
+    EXPECT_EQ(std::distance(d.begin(), d.end()), 1000);
+    EXPECT_EQ(d.end() - d.begin(), 1000);
+
+    Deque<int>::const_iterator found = std::lower_bound(d.begin(), d.end(), d[600]);
+    EXPECT_EQ(*found, d[600]);
+    EXPECT_LE(found - d.begin(), 600);
+
+    std::sort(d.rbegin(), d.rend());
+    EXPECT_TRUE(std::is_sorted(d.rbegin(), d.rend()));
+    EXPECT_EQ(d.rend() - d.rbegin(), 1000);
+    Iterator it = d.begin();
+    it += 10;
+    it -= 3;
+    EXPECT_EQ(&*it, &d[7]);
+    EXPECT_EQ(&it[-2], &d[5]);
+}
+
+/// Rebuilds the logical sequence from for_each_segment and counts the runs.
+template <typename DequeType>
+std::vector<int>
+flattenSegments(const DequeType& d, size_t& runs, size_t& reversedRuns)
+{
+    std::vector<int> out;
+    runs = reversedRuns = 0;
+    d.for_each_segment([&](const int* data, size_t size, bool reversed) {
+        ++runs;
+        reversedRuns += reversed;
+        for (size_t i = 0; i < size; ++i) {
+            out.push_back(reversed ? data[size - 1 - i] : data[i]);
+        }
+    });
+    return out;
+}
+
+template <typename DequeType>
+void
+checkSegments()
+{
+    DequeType d;
+    for (int i = 0; i < 3000; ++i) {
+        d.push_back(i);
+        d.push_front(-i - 1);
+    }
+    size_t runs = 0;
+    size_t reversedRuns = 0;
+    std::vector<int> flat = flattenSegments(d, runs, reversedRuns);
+    EXPECT_TRUE(std::equal(flat.begin(), flat.end(), d.begin()));
+    EXPECT_EQ(flat.size(), d.size());
+    EXPECT_GT(reversedRuns, 0u);
+
+    d.normalize();
+    flat = flattenSegments(d, runs, reversedRuns);
+    EXPECT_TRUE(std::equal(flat.begin(), flat.end(), d.begin()));
+    EXPECT_EQ(reversedRuns, 0u);
+    EXPECT_EQ(d.front(), -3000);
+    EXPECT_EQ(d.back(), 2999);
+
+    d.for_each_segment([](int* data, size_t size, bool) {
+        for (size_t i = 0; i < size; ++i) data[i] *= 2;
+    });
+    EXPECT_EQ(d.front(), -6000);
+}
+
+TEST(DequeSegmentTest, RunsCoverElementsInOrder)
+{
+    checkSegments<Deque<int> >();
+    checkSegments<Deque<int, std::allocator<int>, BlockVector<int> > >();
+
+    Deque<int> single;
+    single.push_back(1);
+    size_t runs = 0;
+    size_t reversedRuns = 0;
+    flattenSegments(single, runs, reversedRuns);
+    EXPECT_EQ(runs, 1u);
+}
+
+/// Builds values as a deque whose first split elements sit in front_.
+template <typename DequeType, typename Value>
+DequeType
+splitAt(const std::vector<Value>& values, const size_t split)
+{
+    DequeType d;
+    for (size_t i = split; i > 0; --i) {
+        d.push_front(values[i - 1]);
+    }
+    for (size_t i = split; i < values.size(); ++i) {
+        d.push_back(values[i]);
+    }
+    return d;
+}
+
+/// Compares every pair of layouts of two sequences that differ in one slot.
+template <typename DequeType, typename Value>
+void
+checkComparisons(const std::vector<Value>& base, const Value& changed)
+{
+    const size_t n = base.size();
+    const size_t splits[] = { 0, 1, n / 3, n / 2, n - 1, n };
+    const size_t slots[] = { 0, n / 4, n / 2, n - 1 };
+    for (size_t slot : slots) {
+        std::vector<Value> other = base;
+        other[slot] = changed;
+        std::vector<Value> shorter(base.begin(), base.end() - 1);
+        for (size_t lhsSplit : splits) {
+            const DequeType lhs = splitAt<DequeType>(base, lhsSplit);
+            for (size_t rhsSplit : splits) {
+                const DequeType same = splitAt<DequeType>(base, rhsSplit);
+                const DequeType rhs  = splitAt<DequeType>(other, rhsSplit);
+                const DequeType prefix = splitAt<DequeType>(shorter, rhsSplit < n ? rhsSplit : n - 1);
+                EXPECT_TRUE(lhs == same);
+                EXPECT_FALSE(lhs < same);
+                EXPECT_FALSE(lhs == rhs);
+                EXPECT_EQ(lhs < rhs, base < other);
+                EXPECT_EQ(rhs < lhs, other < base);
+                EXPECT_FALSE(lhs == prefix);
+                EXPECT_TRUE(prefix < lhs);
+                EXPECT_FALSE(lhs < prefix);
+            }
+        }
+    }
+}
+
+TEST(DequeCompareTest, MatchesVectorAcrossLayouts)
+{
+    std::vector<unsigned char> bytes;
+    std::vector<int> ints;
+    std::vector<std::string> strings;
+    for (int i = 0; i < 9000; ++i) {
+        bytes.push_back(static_cast<unsigned char>(1 + i % 200));
+        ints.push_back(i - 4500);
+        strings.push_back(std::to_string(i % 97));
+    }
+    checkComparisons<Deque<unsigned char> >(bytes, static_cast<unsigned char>(255));
+    checkComparisons<Deque<unsigned char> >(bytes, static_cast<unsigned char>(0));
+    checkComparisons<Deque<int> >(ints, -1000000);
+    checkComparisons<Deque<int, std::allocator<int>, BlockVector<int> > >(ints, 1000000);
+    checkComparisons<Deque<std::string> >(strings, std::string("zz"));
+    checkComparisons<Deque<std::string, std::allocator<std::string>, BlockVector<std::string> > >(strings, std::string());
+}
+
+TEST(RingDequeTest, PushPopBothEnds)
+{
+    RingDeque<int> d;
+    EXPECT_TRUE(d.empty());
+    d.push_back(2);
+    d.push_front(1);
+    d.push_back(3);
+    EXPECT_EQ(d.size(), 3u);
+    EXPECT_EQ(d.front(), 1);
+    EXPECT_EQ(d.back(), 3);
+    EXPECT_EQ(d[1], 2);
+
+    d.pop_front();
+    d.pop_back();
+    EXPECT_EQ(d.size(), 1u);
+    EXPECT_EQ(d.front(), 2);
+}
+
+TEST(RingDequeTest, CapacityIsPowerOfTwo)
+{
+    RingDeque<int> d;
+    for (int i = 0; i < 100; ++i) {
+        d.push_front(i);
+        const size_t capacity = d.capacity();
+        EXPECT_EQ(capacity & (capacity - 1), 0u);
+    }
+    d.reserve(1000);
+    EXPECT_EQ(d.capacity(), 1024u);
+}
+
+TEST(RingDequeTest, GrowUnrollsWrappedRing)
+{
+    RingDeque<int> d;
+    d.reserve(8);
+    for (int i = 4; i < 8; ++i) {
+        d.push_back(i);
+    }
+    for (int i = 3; i >= 0; --i) {
+        d.push_front(i);
+    }
+    EXPECT_EQ(d.capacity(), 8u);
+    d.push_back(8);
+    EXPECT_EQ(d.capacity(), 16u);
+    for (int i = 0; i < 9; ++i) {
+        EXPECT_EQ(d[i], i);
+    }
+}
+
+TEST(RingDequeTest, IteratorsAcrossWrap)
+{
+    RingDeque<int> d;
+    for (int i = 0; i < 5; ++i) {
+        d.push_back(i);
+        d.push_front(-i - 1);
+    }
+
+    int expected = -5;
+    for (RingDeque<int>::const_iterator it = d.begin(); it != d.end(); ++it) {
+        EXPECT_EQ(*it, expected);
+        ++expected;
+    }
+    EXPECT_EQ(d.end() - d.begin(), 10);
+    EXPECT_EQ(*d.rbegin(), 4);
+    EXPECT_EQ(d.begin()[5], 0);
+}
+
+TEST(RingDequeTest, CopyAndCompare)
+{
+    RingDeque<int> d1(3, 7);
+    RingDeque<int> d2(d1);
+    EXPECT_TRUE(d1 == d2);
+    d2.push_back(8);
+    EXPECT_TRUE(d1 < d2);
+    d1 = d2;
+    EXPECT_TRUE(d1 == d2);
+}
+
+struct CopyCounter
+{
+    static int copies;
+
+    CopyCounter() {}
+    CopyCounter(const CopyCounter&) { ++copies; }
+    CopyCounter(CopyCounter&&) noexcept {}
+    CopyCounter& operator=(const CopyCounter&) { ++copies; return *this; }
+    CopyCounter& operator=(CopyCounter&&) noexcept { return *this; }
+};
+
+int CopyCounter::copies = 0;
+
+TEST(DequeMoveTest, MoveOnlyElements)
+{
+    Deque<std::unique_ptr<int> > d;
+    d.push_back(std::unique_ptr<int>(new int(2)));
+    d.emplace_back(new int(3));
+    d.emplace_front(new int(1));
+    d.insert(d.begin() + 1, std::unique_ptr<int>(new int(10)));
+    d.emplace(d.end(), new int(4));
+
+    EXPECT_EQ(d.size(), 5u);
+    EXPECT_EQ(*d.front(), 1);
+    EXPECT_EQ(*d[1], 10);
+    d.erase(d.begin() + 1);
+    for (int i = 1; i <= 4; ++i) {
+        EXPECT_EQ(*d.front(), i);
+        d.pop_front();
+    }
+    EXPECT_TRUE(d.empty());
+}
+
+TEST(DequeMoveTest, MoveConstructAndAssign)
+{
+    Deque<std::string> d1;
+    d1.push_back("a");
+    d1.push_front("b");
+
+    Deque<std::string> d2(std::move(d1));
+    EXPECT_EQ(d2.size(), 2u);
+    EXPECT_EQ(d2.front(), "b");
+    EXPECT_TRUE(d1.empty());
+
+    Deque<std::string> d3;
+    d3.push_back("c");
+    d3 = std::move(d2);
+    EXPECT_EQ(d3.size(), 2u);
+    EXPECT_EQ(d3.back(), "a");
+}
+
+TEST(DequeMoveTest, RvaluePushesAndRebalanceDoNotCopy)
+{
+    CopyCounter::copies = 0;
+    Deque<CopyCounter> d;
+    for (int i = 0; i < 100; ++i) {
+        d.push_back(CopyCounter());
+        d.emplace_front();
+    }
+    while (!d.empty()) {
+        d.pop_back();
+    }
+    d.resize(10);
+    EXPECT_EQ(CopyCounter::copies, 0);
+}
+
+TEST(DequeMoveTest, BlockStorageMoveOnly)
+{
+    Deque<std::unique_ptr<int>, std::allocator<std::unique_ptr<int> >, BlockVector<std::unique_ptr<int> > > d;
+    for (int i = 0; i < 2000; ++i) {
+        d.emplace_back(new int(i));
+    }
+    d.emplace(d.begin() + 1000, new int(-1));
+    EXPECT_EQ(*d[1000], -1);
+    EXPECT_EQ(*d[1001], 1000);
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(*d.front(), i);
+        d.pop_front();
+    }
+}
+
+TEST(RingDequeTest, MoveOnlyElements)
+{
+    RingDeque<std::unique_ptr<int> > d;
+    for (int i = 0; i < 20; ++i) {
+        d.emplace_back(new int(i));
+        d.push_front(std::unique_ptr<int>(new int(-i)));
+    }
+    RingDeque<std::unique_ptr<int> > moved(std::move(d));
+    EXPECT_TRUE(d.empty());
+    EXPECT_EQ(moved.size(), 40u);
+    EXPECT_EQ(*moved.front(), -19);
+    EXPECT_EQ(*moved.back(), 19);
+}
+
+/// Allocator counting the bytes it has outstanding, shared by all copies.
+template <typename T>
+struct CountingAllocator
+{
+    typedef T value_type;
+
+    explicit CountingAllocator(long* live) : live_(live) {}
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>& rhv) : live_(rhv.live_) {}
+
+    T* allocate(const size_t count)
+    {
+        *live_ += static_cast<long>(count * sizeof(T));
+        return std::allocator<T>().allocate(count);
+    }
+
+    void deallocate(T* pointer, const size_t count)
+    {
+        *live_ -= static_cast<long>(count * sizeof(T));
+        std::allocator<T>().deallocate(pointer, count);
+    }
+
+    bool operator==(const CountingAllocator& rhv) const { return live_ == rhv.live_; }
+    bool operator!=(const CountingAllocator& rhv) const { return live_ != rhv.live_; }
+
+    long* live_;
+};
+
+TEST(DequeAllocatorTest, AllocatorReachesBothHalves)
+{
+    long live = 0;
+    {
+        typedef CountingAllocator<int> Alloc;
+        Deque<int, Alloc> d((Alloc(&live)));
+        for (int i = 0; i < 100; ++i) {
+            d.push_back(i);
+            d.push_front(-i);
+        }
+        EXPECT_GT(live, 0);
+        Deque<int, Alloc> copy(d);
+        EXPECT_TRUE(copy.get_allocator() == d.get_allocator());
+        EXPECT_TRUE(copy == d);
+    }
+    EXPECT_EQ(live, 0);
+}
+
+TEST(DequeAllocatorTest, BlockStorageUsesAllocator)
+{
+    long live = 0;
+    {
+        typedef CountingAllocator<int> Alloc;
+        Deque<int, Alloc, BlockVector<int, Alloc> > d((Alloc(&live)));
+        for (int i = 0; i < 5000; ++i) {
+            d.push_back(i);
+        }
+        EXPECT_GE(live, static_cast<long>(5000 * sizeof(int)));
+        Deque<int, Alloc, BlockVector<int, Alloc> > moved(std::move(d));
+        EXPECT_EQ(moved.size(), 5000u);
+        while (!moved.empty()) {
+            moved.pop_front();
+        }
+    }
+    EXPECT_EQ(live, 0);
+}
+
+TEST(DequeAllocatorTest, ArenaAllocator)
+{
+    MonotonicArena arena(256);
+    {
+        Deque<std::string, ArenaAllocator<std::string> > d((ArenaAllocator<std::string>(arena)));
+        for (int i = 0; i < 100; ++i) {
+            d.push_back(std::to_string(i));
+            d.push_front(std::to_string(-i));
+        }
+        EXPECT_EQ(d.front(), "-99");
+        EXPECT_EQ(d.back(), "99");
+        EXPECT_TRUE(d.get_allocator().getArena() == &arena);
+    }
+    EXPECT_GT(arena.bytesAllocated(), 0u);
+    arena.release();
+    EXPECT_EQ(arena.bytesAllocated(), 0u);
+}
+
+TEST(DequeAllocatorTest, PolymorphicAllocator)
+{
+    char buffer[4096];
+    std::pmr::monotonic_buffer_resource resource(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+    pmr::Deque<int> d(&resource);
+    for (int i = 0; i < 50; ++i) {
+        d.push_back(i);
+        d.push_front(-i);
+    }
+    EXPECT_EQ(d.size(), 100u);
+    EXPECT_EQ(d.front(), -49);
+    EXPECT_TRUE(d.get_allocator().resource() == &resource);
+}
+
+TEST(DequeAllocatorTest, MoveIsNoexceptOnlyWhenStorageIsAdopted)
+{
+    typedef Deque<int, std::allocator<int>, BlockVector<int> > BlockDeque;
+    typedef Deque<int, std::pmr::polymorphic_allocator<int>, BlockVector<int, std::pmr::polymorphic_allocator<int> > >
+        PmrBlockDeque;
+    typedef Deque<int, std::allocator<int>, std::vector<int>, DequeStatistics> CountedDeque;
+    EXPECT_TRUE(std::is_nothrow_move_assignable<Deque<int> >::value);
+    EXPECT_TRUE(std::is_nothrow_move_constructible<Deque<int> >::value);
+    EXPECT_TRUE(std::is_nothrow_move_assignable<BlockDeque>::value);
+    EXPECT_FALSE(std::is_nothrow_move_assignable<pmr::Deque<int> >::value);
+    EXPECT_FALSE(std::is_nothrow_move_assignable<PmrBlockDeque>::value);
+    EXPECT_FALSE(std::is_nothrow_move_constructible<CountedDeque>::value);
+
+    std::pmr::unsynchronized_pool_resource first;
+    std::pmr::unsynchronized_pool_resource second;
+    PmrBlockDeque source(&first);
+    for (int i = 0; i < 3000; ++i) source.push_back(i);
+    PmrBlockDeque target(&second);
+    target = std::move(source);
+    EXPECT_EQ(target.size(), 3000u);
+    EXPECT_EQ(target.back(), 2999);
+    EXPECT_TRUE(target.get_allocator().resource() == &second);
+}
+
+struct ThrowingMove
+{
+    ThrowingMove() {}
+    ThrowingMove(const ThrowingMove&) {}
+    ThrowingMove(ThrowingMove&&) {}
+    ThrowingMove& operator=(const ThrowingMove&) { return *this; }
+    ThrowingMove& operator=(ThrowingMove&&) { return *this; }
+};
+
+TEST(SmallDequeTest, MoveIsNoexceptOnlyWhenElementsAndAllocatorAllow)
+{
+    typedef SmallVector<int, 4> Ints;
+    typedef SmallVector<ThrowingMove, 4> Throwing;
+    typedef SmallVector<int, 4, ArenaAllocator<int> > ArenaInts;
+    typedef SmallDeque<int, 4> SmallInts;
+    typedef SmallDeque<ThrowingMove, 4> SmallThrowing;
+    EXPECT_TRUE(std::is_nothrow_move_constructible<Ints>::value);
+    EXPECT_TRUE(std::is_nothrow_move_assignable<Ints>::value);
+    EXPECT_TRUE(noexcept(std::declval<Ints&>().swap(std::declval<Ints&>())));
+    EXPECT_FALSE(std::is_nothrow_move_constructible<Throwing>::value);
+    EXPECT_FALSE(std::is_nothrow_move_assignable<Throwing>::value);
+    EXPECT_FALSE(noexcept(std::declval<Throwing&>().swap(std::declval<Throwing&>())));
+    EXPECT_TRUE(std::is_nothrow_move_constructible<ArenaInts>::value);
+    EXPECT_FALSE(std::is_nothrow_move_assignable<ArenaInts>::value);
+
+    EXPECT_TRUE(std::is_nothrow_move_constructible<SmallInts>::value);
+    EXPECT_TRUE(std::is_nothrow_move_assignable<SmallInts>::value);
+    EXPECT_FALSE(std::is_nothrow_move_constructible<SmallThrowing>::value);
+    EXPECT_FALSE(std::is_nothrow_move_assignable<SmallThrowing>::value);
+    EXPECT_FALSE(noexcept(std::declval<SmallThrowing&>().swap(std::declval<SmallThrowing&>())));
+    EXPECT_TRUE(noexcept(std::declval<Deque<int>&>().swap(std::declval<Deque<int>&>())));
+}
+
+TEST(SmallDequeTest, StaysInlineUntilOverflow)
+{
+    long live = 0;
+    {
+        typedef CountingAllocator<int> Alloc;
+        typedef SmallDeque<int, 4, Alloc> Small;
+        Small d((Alloc(&live)));
+        for (int i = 0; i < 4; ++i) {
+            d.push_back(i);
+            d.push_front(-i - 1);
+        }
+        EXPECT_EQ(live, 0);
+        EXPECT_EQ(d.front(), -4);
+        EXPECT_EQ(d.back(), 3);
+        Small copy(d);
+        EXPECT_EQ(live, 0);
+        EXPECT_TRUE(copy == d);
+
+        d.push_back(4);
+        EXPECT_GT(live, 0);
+        for (int i = -4; i <= 4; ++i) {
+            EXPECT_EQ(d.front(), i);
+            d.pop_front();
+        }
+        EXPECT_TRUE(d.empty());
+        d.shrink_to_fit();
+        EXPECT_EQ(live, 0);
+
+        for (int i = 0; i < 20; ++i) {
+            d.push_back(i);
+        }
+        Small moved(std::move(d));
+        EXPECT_EQ(moved.size(), 20u);
+        moved.swap(copy);
+        EXPECT_EQ(moved.size(), 8u);
+        EXPECT_EQ(copy.back(), 19);
+        copy = moved;
+        EXPECT_TRUE(copy == moved);
+    }
+    EXPECT_EQ(live, 0);
+}
+
+TEST(SmallDequeTest, BehavesLikeDeque)
+{
+    checkBulkAgainstStd<SmallDeque<size_t, 8> >();
+    checkSegments<SmallDeque<int, 16> >();
+
+    SmallDeque<std::unique_ptr<int>, 2> d;
+    for (int i = 0; i < 10; ++i) {
+        d.emplace_back(new int(i));
+    }
+    d.emplace(d.begin() + 5, new int(-1));
+    EXPECT_EQ(*d[5], -1);
+    SmallDeque<std::unique_ptr<int>, 2> moved(std::move(d));
+    EXPECT_EQ(*moved.front(), 0);
+    EXPECT_EQ(moved.size(), 11u);
+
+    SmallDeque<std::string, 3> strings;
+    strings.push_back("a");
+    strings.push_front("b");
+    SmallDeque<std::string, 3> other = strings;
+    other.push_back("c");
+    EXPECT_TRUE(strings < other);
+    strings.swap(other);
+    EXPECT_EQ(strings.size(), 3u);
+    EXPECT_EQ(other.back(), "a");
+}
+
+TEST(SmallDequeTest, ForwardRangesGrowOnce)
+{
+    typedef Deque<int, std::allocator<int>, SmallVector<int, 4>, DequeStatistics> Small;
+    Small d;
+    std::vector<int> batch(1000);
+    for (size_t i = 0; i < batch.size(); ++i) batch[i] = static_cast<int>(i);
+    d.append(batch.begin(), batch.end());
+    d.prepend(batch.begin(), batch.end());
+    EXPECT_EQ(d.statistics().counters().reallocations, 2u);
+    EXPECT_EQ(d.size(), 2000u);
+    EXPECT_EQ(d.front(), 0);
+    EXPECT_EQ(d[999], 999);
+    EXPECT_EQ(d.back(), 999);
+
+    SmallVector<std::string, 2> strings;
+    strings.push_back("a");
+    strings.push_back("b");
+    strings.insert(strings.begin() + 1, strings.begin(), strings.end());
+    ASSERT_EQ(strings.size(), 4u);
+    EXPECT_EQ(strings[0] + strings[1] + strings[2] + strings[3], "aabb");
+
+    std::istringstream in("1 2 3");
+    SmallVector<int, 2> parsed;
+    parsed.push_back(9);
+    parsed.insert(parsed.begin(), std::istream_iterator<int>(in), std::istream_iterator<int>());
+    ASSERT_EQ(parsed.size(), 4u);
+    EXPECT_EQ(parsed[0], 1);
+    EXPECT_EQ(parsed[3], 9);
+}
+
+TEST(DequeStatisticsTest, DisabledPolicyTakesNoSpace)
+{
+    EXPECT_EQ(sizeof(Deque<int>), 2 * sizeof(std::vector<int>));
+    EXPECT_EQ(sizeof(Deque<int, std::allocator<int>, BlockVector<int> >), 2 * sizeof(BlockVector<int>));
+}
+
+TEST(DequeStatisticsTest, CountsGrowthRebalancesAndMoves)
+{
+    typedef Deque<int, std::allocator<int>, std::vector<int>, DequeStatistics> CountedDeque;
+    CountedDeque d;
+    std::vector<int> reference;
+    size_t reallocations = 0;
+    size_t moved = 0;
+    for (int i = 0; i < 100; ++i) {
+        if (reference.size() == reference.capacity()) {
+            ++reallocations;
+            moved += reference.size();
+        }
+        reference.push_back(i);
+        d.push_back(i);
+    }
+    DequeCounters counters = d.statistics().counters();
+    EXPECT_EQ(counters.reallocations, reallocations);
+    EXPECT_EQ(counters.elementsMoved, moved);
+    EXPECT_EQ(counters.bytesMoved, moved * sizeof(int));
+    EXPECT_EQ(counters.rebalances, 0u);
+    EXPECT_EQ(counters.peakSize, 100u);
+
+    d.pop_front();
+    counters = d.statistics().counters();
+    EXPECT_EQ(counters.rebalances, 1u);
+    EXPECT_EQ(counters.elementsMoved, moved + 100);
+    EXPECT_EQ(d.front(), 1);
+
+    d.erase(d.begin() + 10);
+    d.insert(d.end() - 5, 3, -1);
+    EXPECT_EQ(d.statistics().counters().elementsMoved, moved + 100 + 10 + 5);
+    d.clear();
+    EXPECT_EQ(d.statistics().counters().peakSize, 101u);
+}
+
+TEST(DequeStatisticsTest, BlockStorageGrowsWithoutMoving)
+{
+    Deque<int, std::allocator<int>, BlockVector<int>, DequeStatistics> d;
+    for (int i = 0; i < 10000; ++i) {
+        d.push_front(i);
+    }
+    const DequeCounters counters = d.statistics().counters();
+    EXPECT_GT(counters.reallocations, 0u);
+    EXPECT_EQ(counters.elementsMoved, 0u);
+    EXPECT_EQ(counters.peakSize, 10000u);
+}
+
+TEST(DequeStatisticsTest, RegistryListsLiveDeques)
+{
+    typedef Deque<int, std::allocator<int>, std::vector<int>, DequeStatistics> CountedDeque;
+    DequeStatisticsRegistry& registry = DequeStatisticsRegistry::instance();
+    const size_t live = registry.live();
+    const DequeCounters before = registry.totals();
+    {
+        CountedDeque first;
+        first.statistics().set_name("orders");
+        first.push_back(1);
+        CountedDeque second(first);
+        EXPECT_EQ(registry.live(), live + 2);
+        EXPECT_NE(first.statistics().id(), second.statistics().id());
+        EXPECT_EQ(second.statistics().counters().reallocations, 0u);
+        EXPECT_EQ(first.statistics().name(), "orders");
+
+        std::ostringstream dump;
+        registry.dump(dump);
+        std::ostringstream line;
+        line << "deque #" << first.statistics().id() << " (orders) reallocations=1 rebalances=0";
+        EXPECT_NE(dump.str().find(line.str()), std::string::npos);
+        EXPECT_NE(dump.str().find("\ntotal reallocations="), std::string::npos);
+    }
+    EXPECT_EQ(registry.live(), live);
+    EXPECT_EQ(registry.totals().reallocations, before.reallocations + 1);
+}
+
+TEST(DequeStatisticsTest, RegistryDetachesInAnyOrder)
+{
+    typedef Deque<int, std::allocator<int>, std::vector<int>, DequeStatistics> CountedDeque;
+    DequeStatisticsRegistry& registry = DequeStatisticsRegistry::instance();
+    const size_t live = registry.live();
+    const DequeCounters before = registry.totals();
+    std::vector<std::unique_ptr<CountedDeque> > deques;
+    for (int i = 0; i < 100; ++i) {
+        deques.push_back(std::unique_ptr<CountedDeque>(new CountedDeque()));
+        deques.back()->push_back(i);
+    }
+    for (size_t step = 0; step < 100; ++step) {
+        deques[(step * 37) % 100].reset();
+        EXPECT_EQ(registry.live(), live + 99 - step);
+        EXPECT_EQ(registry.totals().reallocations, before.reallocations + 100);
+    }
+}
+
+TEST(CircularDequeTest, KeepsTheLastCapacityElements)
+{
+    CircularDeque<int> window(5);
+    std::deque<int> reference;
+    for (int i = 0; i < 23; ++i) {
+        window.push_back(i);
+        reference.push_back(i);
+        if (reference.size() > 5) {
+            reference.pop_front();
+        }
+        ASSERT_EQ(window.size(), reference.size());
+        EXPECT_TRUE(std::equal(window.begin(), window.end(), reference.begin()));
+    }
+    EXPECT_TRUE(window.full());
+    EXPECT_EQ(window.capacity(), 5u);
+    EXPECT_EQ(window.front(), 18);
+    EXPECT_EQ(window.back(), 22);
+    EXPECT_EQ(window[2], 20);
+    EXPECT_EQ(*(window.rbegin() + 1), 21);
+    EXPECT_EQ(window.end() - window.begin(), 5);
+
+    window.push_front(-1); /// evicts the back
+    EXPECT_EQ(window.front(), -1);
+    EXPECT_EQ(window.back(), 21);
+    window.pop_back();
+    window.pop_front();
+    EXPECT_EQ(window.size(), 3u);
+    window.push_front(17);
+    window.push_back(21);
+    window.push_back(22);
+    EXPECT_EQ(window.front(), 18);
+    std::sort(window.begin(), window.end(), std::greater<int>());
+    EXPECT_EQ(window.front(), 22);
+    EXPECT_EQ(window.back(), 18);
+}
+
+TEST(CircularDequeTest, ReportsEvictedElement)
+{
+    CircularDeque<std::string> window(3);
+    std::string evicted;
+    EXPECT_FALSE(window.push_back("a", evicted));
+    EXPECT_FALSE(window.push_back("b", evicted));
+    EXPECT_FALSE(window.push_back("c", evicted));
+    EXPECT_TRUE(window.push_back("d", evicted));
+    EXPECT_EQ(evicted, "a");
+    EXPECT_TRUE(window.push_front("z", evicted));
+    EXPECT_EQ(evicted, "d");
+    EXPECT_EQ(window.front(), "z");
+    EXPECT_EQ(window.back(), "c");
+    const std::string named("y");
+    EXPECT_TRUE(window.push_front(named, evicted));
+    EXPECT_EQ(evicted, "c");
+    EXPECT_EQ(window.front(), "y");
+    EXPECT_EQ(window.back(), "b");
+    EXPECT_TRUE(window.push_back(named, evicted));
+    EXPECT_EQ(evicted, "y");
+    EXPECT_EQ(window.front(), "z");
+    window.pop_back();
+    window.push_back("c");
+
+    window.push_back(window.front()); /// the argument is the element evicted
+    EXPECT_EQ(window.back(), "z");
+    EXPECT_EQ(window.front(), "b");
+
+    CircularDeque<std::string> copy(window);
+    EXPECT_TRUE(copy == window);
+    copy.push_back("e");
+    EXPECT_TRUE(copy != window);
+    CircularDeque<std::string> moved(std::move(copy));
+    EXPECT_EQ(moved.back(), "e");
+    window = moved;
+    EXPECT_TRUE(window == moved);
+    window.clear();
+    EXPECT_TRUE(window.empty());
+}
+
+TEST(CircularDequeTest, MoveOnlyElements)
+{
+    CircularDeque<std::unique_ptr<int> > window(2);
+    window.emplace_back(new int(1));
+    window.emplace_back(new int(2));
+    std::unique_ptr<int> evicted;
+    EXPECT_TRUE(window.push_back(std::unique_ptr<int>(new int(3)), evicted));
+    EXPECT_EQ(*evicted, 1);
+    EXPECT_EQ(*window.front(), 2);
+    EXPECT_EQ(*window.back(), 3);
+}
+
+struct MoveCounter
+{
+    static int moves;
+
+    MoveCounter() {}
+    MoveCounter(const MoveCounter&) {}
+    MoveCounter(MoveCounter&&) noexcept { ++moves; }
+    MoveCounter& operator=(const MoveCounter&) { return *this; }
+    MoveCounter& operator=(MoveCounter&&) noexcept { ++moves; return *this; }
+};
+
+int MoveCounter::moves = 0;
+
+TEST(CircularDequeTest, EvictingPushesConstructInPlace)
+{
+    CircularDeque<MoveCounter> window(3);
+    for (int i = 0; i < 3; ++i) window.emplace_back();
+    MoveCounter::moves = 0;
+    for (int i = 0; i < 10; ++i) {
+        window.emplace_back();
+        window.emplace_front();
+    }
+    EXPECT_EQ(MoveCounter::moves, 0);
+    window.push_back(MoveCounter());
+    window.push_front(MoveCounter());
+    EXPECT_EQ(MoveCounter::moves, 2);
+    MoveCounter evicted;
+    window.push_back(MoveCounter(), evicted);
+    EXPECT_EQ(MoveCounter::moves, 4);
+    EXPECT_EQ(window.size(), 3u);
+
+    CircularDeque<int> ints(3);
+    for (int i = 0; i < 3; ++i) ints.push_back(i);
+    ints.push_front(ints.back()); /// the argument is the element evicted
+    EXPECT_EQ(ints.front(), 2);
+    EXPECT_EQ(ints.back(), 1);
+    int dropped = -1;
+    EXPECT_TRUE(ints.push_front(ints.back(), dropped));
+    EXPECT_EQ(dropped, 1);
+    EXPECT_EQ(ints.front(), 1);
+    EXPECT_EQ(ints[1], 2);
+    EXPECT_EQ(ints.max_size(), std::numeric_limits<size_t>::max() / sizeof(int));
+}
+
+TEST(MonotonicDequeTest, CountWindowMatchesRescan)
+{
+    const size_t windows[] = { 1, 2, 7, 64 };
+    for (size_t w = 0; w < sizeof(windows) / sizeof(windows[0]); ++w) {
+        MonotonicDeque<int> window;
+        std::vector<int> stream;
+        size_t state = 7;
+        for (size_t i = 0; i < 2000; ++i) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            const int value = static_cast<int>((state >> 33) % 100);
+            stream.push_back(value);
+            window.push(value);
+            window.keep_last(windows[w]);
+
+            const size_t first = stream.size() > windows[w] ? stream.size() - windows[w] : 0;
+            ASSERT_EQ(window.min(), *std::min_element(stream.begin() + first, stream.end()));
+            ASSERT_EQ(window.max(), *std::max_element(stream.begin() + first, stream.end()));
+        }
+        EXPECT_EQ(window.pushed(), 2000u);
+    }
+}
+
+TEST(MonotonicDequeTest, TimeWindowExpires)
+{
+    MonotonicDeque<double, std::less<double>, long> prices;
+    EXPECT_TRUE(prices.empty());
+    prices.push(10.0, 100);
+    prices.push(12.5, 105);
+    prices.push(9.0, 110);
+    prices.push(11.0, 111);
+    EXPECT_EQ(prices.min(), 9.0);
+    EXPECT_EQ(prices.max(), 12.5);
+
+    prices.expire_older_than(106);
+    EXPECT_EQ(prices.min(), 9.0);
+    EXPECT_EQ(prices.max(), 11.0);
+    prices.expire_older_than(111);
+    EXPECT_EQ(prices.min(), 11.0);
+    EXPECT_EQ(prices.max(), 11.0);
+    prices.expire_older_than(200);
+    EXPECT_TRUE(prices.empty());
+
+    prices.push(5.0, 300);
+    prices.push(5.0, 301);
+    prices.expire_older_than(301);
+    EXPECT_EQ(prices.min(), 5.0);
+    prices.clear();
+    EXPECT_TRUE(prices.empty());
+    EXPECT_EQ(prices.pushed(), 0u);
+}
+
+TEST(MonotonicDequeTest, CustomCompare)
+{
+    MonotonicDeque<std::string, std::greater<std::string> > words;
+    words.push("pear");
+    words.push("apple");
+    words.push("fig");
+    EXPECT_EQ(words.min(), "pear");
+    EXPECT_EQ(words.max(), "apple");
+    words.keep_last(1);
+    EXPECT_EQ(words.min(), "fig");
+    EXPECT_EQ(words.max(), "fig");
+}
+
+TEST(MappedDequeTest, MatchesStdDequeAcrossGrowth)
+{
+    const std::string path = ::testing::TempDir() + "mapped_deque_growth.bin";
+    std::remove(path.c_str());
+    {
+        MappedDeque<long> queue(path, 4096);
+        std::deque<long> reference;
+        for (long i = 0; i < 20000; ++i) {
+            switch (i % 7) {
+            case 0: case 1: case 2: queue.push_back(i);  reference.push_back(i);  break;
+            case 3: case 4:         queue.push_front(i); reference.push_front(i); break;
+            case 5:                 queue.pop_front();   reference.pop_front();   break;
+            default:                queue.pop_back();    reference.pop_back();    break;
+            }
+        }
+        ASSERT_EQ(queue.size(), reference.size());
+        EXPECT_GT(queue.capacity(), 4096 / sizeof(long));
+        for (size_t i = 0; i < reference.size(); ++i) {
+            ASSERT_EQ(queue[i], reference[i]);
+        }
+        EXPECT_EQ(queue.front(), reference.front());
+        EXPECT_EQ(queue.back(), reference.back());
+        queue.push_back(queue.front()); /// may grow while the argument lives in the mapping
+        EXPECT_EQ(queue.back(), reference.front());
+    }
+    std::remove(path.c_str());
+}
+
+TEST(MappedDequeTest, ReopenResumesQueue)
+{
+    const std::string path = ::testing::TempDir() + "mapped_deque_reopen.bin";
+    std::remove(path.c_str());
+    {
+        MappedDeque<int> queue(path, 1024);
+        for (int i = 0; i < 1000; ++i) {
+            queue.push_back(i);
+        }
+        for (int i = 0; i < 300; ++i) {
+            queue.pop_front();
+        }
+        queue.push_front(-1);
+        queue.sync();
+    }
+    {
+        MappedDeque<int> queue(path, 1024);
+        ASSERT_EQ(queue.size(), 701u);
+        EXPECT_EQ(queue.front(), -1);
+        EXPECT_EQ(queue[1], 300);
+        EXPECT_EQ(queue.back(), 999);
+        queue.clear();
+    }
+    {
+        MappedDeque<int> queue(path);
+        EXPECT_TRUE(queue.empty());
+    }
+    EXPECT_THROW(MappedDeque<double> wrongType(path), std::runtime_error);
+    std::remove(path.c_str());
+    EXPECT_THROW(MappedDeque<int> missingDirectory(::testing::TempDir() + "no/such/dir/queue.bin"), std::system_error);
+}
+
+TEST(MappedDequeTest, GrowsFromEveryHeadAndReopensLongerFiles)
+{
+    const std::string path = ::testing::TempDir() + "mapped_deque_wrap.bin";
+    for (int head = 0; head < 48; ++head) {
+        std::remove(path.c_str());
+        {
+            MappedDeque<int> queue(path, 16 * sizeof(int));
+            for (int i = 0; i < 48; ++i) queue.push_back(i);
+            ASSERT_EQ(queue.capacity(), 48u);
+            for (int i = 0; i < head; ++i) {
+                queue.pop_front();
+                queue.push_back(48 + i);
+            }
+            queue.push_back(48 + head);
+            ASSERT_EQ(queue.size(), 49u);
+            for (int i = 0; i < 49; ++i) {
+                ASSERT_EQ(queue[i], head + i);
+            }
+            queue.sync();
+        }
+        /// A crash after the file was extended leaves it longer than the ring.
+        ASSERT_EQ(0, ::truncate(path.c_str(), 4096 + 1000 * sizeof(int)));
+        MappedDeque<int> queue(path, 16 * sizeof(int));
+        ASSERT_EQ(queue.size(), 49u);
+        EXPECT_EQ(queue.front(), head);
+        EXPECT_EQ(queue.back(), 48 + head);
+    }
+    std::remove(path.c_str());
+}
+
+template <typename Queue>
+Queue
+makeSplitDeque(const int count)
+{
+    Queue d;
+    for (int i = 0; i < count; ++i) {
+        if (i % 3 == 0) d.push_front(i);
+        else            d.push_back(i);
+    }
+    return d;
+}
+
+TEST(DequeSerializationTest, RoundTripsThroughStreams)
+{
+    const Deque<int> d = makeSplitDeque<Deque<int> >(1000);
+    std::stringstream stream;
+    save(d, stream);
+    EXPECT_EQ(stream.str().size(), sizeof(DequeSnapshotHeader) + 1000 * sizeof(int));
+    Deque<int> restored(5, 7);
+    load(restored, stream);
+    EXPECT_TRUE(restored == d);
+
+    typedef Deque<int, std::allocator<int>, BlockVector<int> > BlockDeque;
+    const BlockDeque blocks = makeSplitDeque<BlockDeque>(5000);
+    std::stringstream blockStream;
+    save(blocks, blockStream);
+    BlockDeque restoredBlocks;
+    load(restoredBlocks, blockStream);
+    EXPECT_TRUE(restoredBlocks == blocks);
+
+    Deque<std::string> strings;
+    strings.push_back("back");
+    strings.push_front("front");
+    strings.push_front(std::string(1000, 'x'));
+    strings.push_back("");
+    std::stringstream stringStream;
+    save(strings, stringStream);
+    Deque<std::string> restoredStrings;
+    load(restoredStrings, stringStream);
+    EXPECT_TRUE(restoredStrings == strings);
+
+    std::stringstream wrongType(stream.str());
+    Deque<double> doubles;
+    EXPECT_THROW(load(doubles, wrongType), std::runtime_error);
+    std::stringstream truncated(stream.str().substr(0, 200));
+    EXPECT_THROW(load(restored, truncated), std::runtime_error);
+}
+
+TEST(DequeSerializationTest, FileDescriptorsAndMappedView)
+{
+    const std::string path = ::testing::TempDir() + "deque_snapshot.bin";
+    const Deque<long> d = makeSplitDeque<Deque<long> >(3000);
+    int descriptor = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    ASSERT_GE(descriptor, 0);
+    save(d, descriptor);
+    ASSERT_EQ(0, ::lseek(descriptor, 0, SEEK_SET));
+    Deque<long> restored;
+    load(restored, descriptor);
+    ::close(descriptor);
+    EXPECT_TRUE(restored == d);
+
+    {
+        DequeView<long> view(path);
+        ASSERT_EQ(view.size(), d.size());
+        for (size_t i = 0; i < d.size(); ++i) {
+            ASSERT_EQ(view[i], d[i]);
+        }
+        EXPECT_EQ(view.front(), d.front());
+        EXPECT_EQ(view.back(), d.back());
+        size_t runs = 0;
+        view.for_each_segment([&runs](const long*, size_t, bool) { ++runs; });
+        EXPECT_EQ(runs, 2u);
+    }
+    EXPECT_THROW(DequeView<int> wrongType(path), std::runtime_error);
+
+    Deque<std::string> strings;
+    for (int i = 0; i < 100; ++i) {
+        if (i & 1) strings.push_front(std::to_string(i));
+        else       strings.push_back(std::to_string(i));
+    }
+    descriptor = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    save(strings, descriptor);
+    ::lseek(descriptor, 0, SEEK_SET);
+    Deque<std::string> restoredStrings;
+    load(restoredStrings, descriptor);
+    ::close(descriptor);
+    EXPECT_TRUE(restoredStrings == strings);
+    std::remove(path.c_str());
+}
+
+TEST(DequeSerializationTest, RejectsCorruptSizesBeforeAllocating)
+{
+    std::stringstream wrapping;
+    DequeSnapshotHeader header = DequeSnapshotHeader::make(sizeof(int), DequeSnapshotHeader::RAW, ~0ULL, 2);
+    wrapping.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    Deque<int> d;
+    EXPECT_THROW(load(d, wrapping), std::runtime_error);
+
+    std::stringstream huge;
+    header = DequeSnapshotHeader::make(sizeof(int), DequeSnapshotHeader::RAW, 1ULL << 40, 10);
+    huge.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    huge.write(std::string(40, '\0').data(), 40);
+    EXPECT_THROW(load(d, huge), std::runtime_error);
+
+    std::stringstream hostileString;
+    header = DequeSnapshotHeader::make(sizeof(std::string), DequeSnapshotHeader::SERIALIZER, 0, 1);
+    hostileString.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    const uint64_t length = 1ULL << 50;
+    hostileString.write(reinterpret_cast<const char*>(&length), sizeof(length));
+    hostileString.write("abc", 3);
+    Deque<std::string> strings;
+    EXPECT_THROW(load(strings, hostileString), std::runtime_error);
+
+    /// A pipe has no known end, so the deque grows step by step.
+    int ends[2];
+    ASSERT_EQ(0, ::pipe(ends));
+    header = DequeSnapshotHeader::make(sizeof(long), DequeSnapshotHeader::RAW, 1ULL << 40, 10);
+    deque_io::write_all(ends[1], &header, sizeof(header));
+    deque_io::write_all(ends[1], std::string(80, '\0').data(), 80);
+    ::close(ends[1]);
+    Deque<long> longs;
+    EXPECT_THROW(load(longs, ends[0]), std::runtime_error);
+    ::close(ends[0]);
+}
+
+TEST(DequeSerializationTest, PipesLoadInSteps)
+{
+    Deque<char> d;
+    const size_t count = deque_serialization::RAW_READ_STEP + 5000;
+    for (size_t i = 0; i < count; ++i) {
+        if (i % 3 == 0) d.push_front(static_cast<char>(i));
+        else            d.push_back(static_cast<char>(i * 7));
+    }
+    int ends[2];
+    ASSERT_EQ(0, ::pipe(ends));
+    std::thread writer([&d, &ends]() {
+        save(d, ends[1]);
+        ::close(ends[1]);
+    });
+    Deque<char> restored;
+    load(restored, ends[0]);
+    writer.join();
+    ::close(ends[0]);
+    EXPECT_TRUE(restored == d);
+}
+
+TEST(ThreadPoolTest, RunsEveryTaskOnceAndRethrows)
+{
+    ThreadPool pool(3);
+    EXPECT_EQ(pool.threads(), 4u);
+    std::vector<std::atomic<int> > hits(1000);
+    for (size_t i = 0; i < hits.size(); ++i) hits[i] = 0;
+    pool.run(hits.size(), [&hits](const size_t i) { ++hits[i]; });
+    for (size_t i = 0; i < hits.size(); ++i) {
+        EXPECT_EQ(hits[i].load(), 1);
+    }
+    std::atomic<int> ran(0);
+    EXPECT_THROW(pool.run(100, [&ran](const size_t i) {
+        ++ran;
+        if (i == 42) throw std::runtime_error("task");
+    }), std::runtime_error);
+    EXPECT_EQ(ran.load(), 100);
+
+    ThreadPool inlinePool(0);
+    int sum = 0;
+    inlinePool.run(10, [&sum](const size_t i) { sum += static_cast<int>(i); });
+    EXPECT_EQ(sum, 45);
+}
+
+TEST(DequeParallelTest, MatchesSerialAlgorithms)
+{
+    ThreadPool pool(3);
+    Deque<int> d = makeSplitDeque<Deque<int> >(10000);
+    typedef Deque<int, std::allocator<int>, BlockVector<int> > BlockDeque;
+    const BlockDeque blocks = makeSplitDeque<BlockDeque>(10000);
+    const long long expected = std::accumulate(d.begin(), d.end(), 0LL);
+    const size_t grains[] = { 1, 7, 1000, 100000 };
+    for (size_t g = 0; g < sizeof(grains) / sizeof(grains[0]); ++g) {
+        EXPECT_EQ(deque_parallel::reduce(pool, d, 0LL, std::plus<long long>(), grains[g]), expected);
+        EXPECT_EQ(deque_parallel::reduce(pool, blocks, 0LL, std::plus<long long>(), grains[g]), expected);
+
+        Deque<double> halves;
+        halves.push_front(-1.0);
+        deque_parallel::transform(pool, blocks, halves, [](const int v) { return v / 2.0; }, grains[g]);
+        ASSERT_EQ(halves.size(), blocks.size());
+        for (size_t i = 0; i < blocks.size(); ++i) {
+            EXPECT_EQ(halves[i], blocks[i] / 2.0);
+        }
+    }
+    const Deque<int> before(d);
+    deque_parallel::for_each(pool, d, [](int& v) { v *= 3; }, 100);
+    for (size_t i = 0; i < d.size(); ++i) {
+        EXPECT_EQ(d[i], before[i] * 3);
+    }
+    deque_parallel::transform(pool, d, d, [](const int v) { return v + 1; }, 333);
+    for (size_t i = 0; i < d.size(); ++i) {
+        EXPECT_EQ(d[i], before[i] * 3 + 1);
+    }
+    std::atomic<long long> visited(0);
+    deque_parallel::for_each(pool, before, [&visited](const int v) { visited += v; }, 64);
+    EXPECT_EQ(visited.load(), expected);
+
+    const Deque<int> empty;
+    EXPECT_EQ(deque_parallel::reduce(pool, empty, 5), 5);
+}
+
+TEST(DequeParallelTest, ReduceKeepsLogicalOrder)
+{
+    ThreadPool pool(2);
+    Deque<std::string> letters;
+    std::string expected;
+    for (int i = 0; i < 26; ++i) {
+        const std::string letter(1, static_cast<char>('a' + i));
+        if (i % 2 == 0) letters.push_back(letter);
+        else            letters.push_front(letter);
+    }
+    for (size_t i = 0; i < letters.size(); ++i) expected += letters[i];
+    for (size_t grain = 1; grain <= 30; ++grain) {
+        EXPECT_EQ(deque_parallel::reduce(pool, letters, std::string(">"), std::plus<std::string>(), grain),
+                  ">" + expected);
+    }
+}
+
+TEST(DequeParallelTest, SortMatchesStdSort)
+{
+    ThreadPool pool(3);
+    const int sizes[] = { 0, 1, 2, 100, 20000, 100000 };
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        Deque<int> d;
+        typedef Deque<int, std::allocator<int>, BlockVector<int> > BlockDeque;
+        BlockDeque blocks;
+        std::vector<int> expected;
+        unsigned state = 7;
+        for (int i = 0; i < sizes[s]; ++i) {
+            state = state * 1103515245u + 12345u;
+            const int value = static_cast<int>(state >> 8) % 5000;
+            if (i % 3 == 0) {
+                d.push_front(value);
+                blocks.push_front(value);
+            } else {
+                d.push_back(value);
+                blocks.push_back(value);
+            }
+            expected.push_back(value);
+        }
+        std::sort(expected.begin(), expected.end());
+        deque_parallel::sort(pool, d);
+        deque_parallel::sort(pool, blocks);
+        EXPECT_TRUE(std::equal(expected.begin(), expected.end(), d.begin()));
+        EXPECT_TRUE(std::equal(expected.begin(), expected.end(), blocks.begin()));
+        EXPECT_EQ(d.size(), expected.size());
+
+        ThreadPool single(0);
+        std::reverse(d.begin(), d.end());
+        deque_parallel::sort(single, d);
+        EXPECT_TRUE(std::equal(expected.begin(), expected.end(), d.begin()));
+    }
+
+    Deque<std::string> words;
+    for (int i = 0; i < 40000; ++i) {
+        const std::string word = "word-" + std::to_string((i * 7919) % 40000);
+        if (i % 2 == 0) words.push_front(word);
+        else            words.push_back(word);
+    }
+    deque_parallel::sort(pool, words, std::greater<std::string>());
+    EXPECT_TRUE(std::is_sorted(words.begin(), words.end(), std::greater<std::string>()));
+    EXPECT_EQ(words.size(), 40000u);
+    EXPECT_EQ(words.back(), "word-0");
+}
+
+TEST(DequeTest, AppendAndPrependRanges)
+{
+    const int values[] = { 1, 2, 3, 4, 5 };
+    Deque<int> d;
+    d.push_back(10);
+    d.append(values, values + 5);
+    d.prepend(values, values + 3);
+    d.push_back_n(2, 7);
+    d.push_front_n(3, 9);
+    const int expected[] = { 9, 9, 9, 1, 2, 3, 10, 1, 2, 3, 4, 5, 7, 7 };
+    ASSERT_EQ(d.size(), sizeof(expected) / sizeof(expected[0]));
+    EXPECT_TRUE(std::equal(d.begin(), d.end(), expected));
+    d.append(values, values);
+    d.prepend(values, values);
+    d.push_back_n(0, 1);
+    EXPECT_EQ(d.size(), sizeof(expected) / sizeof(expected[0]));
+
+    std::istringstream in("4 5 6");
+    Deque<int> single;
+    single.push_front(7);
+    single.prepend(std::istream_iterator<int>(in), std::istream_iterator<int>());
+    const int singleExpected[] = { 4, 5, 6, 7 };
+    ASSERT_EQ(single.size(), 4u);
+    EXPECT_TRUE(std::equal(single.begin(), single.end(), singleExpected));
+
+    typedef Deque<std::string, std::allocator<std::string>, BlockVector<std::string> > BlockDeque;
+    std::list<std::string> words;
+    for (int i = 0; i < 3000; ++i) words.push_back(std::to_string(i));
+    BlockDeque blocks;
+    blocks.prepend(words.begin(), words.end());
+    blocks.append(words.begin(), words.end());
+    ASSERT_EQ(blocks.size(), 6000u);
+    EXPECT_TRUE(std::equal(words.begin(), words.end(), blocks.begin()));
+    EXPECT_TRUE(std::equal(words.begin(), words.end(), blocks.begin() + 3000));
+}
+
+TEST(DequeTest, BatchedPushesGrowOnce)
+{
+    Deque<int, std::allocator<int>, std::vector<int>, DequeStatistics> d;
+    std::vector<int> batch(5000);
+    for (size_t i = 0; i < batch.size(); ++i) batch[i] = static_cast<int>(i);
+    d.append(batch.begin(), batch.end());
+    d.prepend(batch.begin(), batch.end());
+    d.push_front_n(100, -1);
+    EXPECT_EQ(d.statistics().counters().reallocations, 3u);
+    EXPECT_EQ(d.statistics().counters().peakSize, 10100u);
+    EXPECT_EQ(d.front(), -1);
+    EXPECT_EQ(d[100], 0);
+    EXPECT_EQ(d[5099], 4999);
+    EXPECT_EQ(d.back(), 4999);
+}
+
 int
 main(int argc, char **argv)
 {
@@ -0,0 +1,224 @@
+#include "headers/DequeSerialization.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char MAGIC[8] = { 'D', 'E', 'Q', 'U', 'E', 'S', 'N', 'P' };
+const size_t FD_BUFFER_SIZE = 64 * 1024;
+const size_t STRING_READ_STEP = 64 * 1024;
+
+} /// namespace
+
+const uint32_t DequeSnapshotHeader::VERSION;
+
+/// Length as a uint64_t, then the bytes.
+void
+Serializer<std::string>::write(std::ostream& out, const std::string& value)
+{
+    const uint64_t size = value.size();
+    out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    out.write(value.data(), static_cast<std::streamsize>(value.size()));
+}
+
+std::string
+Serializer<std::string>::read(std::istream& in)
+{
+    uint64_t size = 0;
+    deque_io::read_all(in, &size, sizeof(size));
+    std::string value;
+    if (size > value.max_size()) throw std::runtime_error("Deque snapshot: string too long");
+    /// Grows by at most what is already read, so a corrupt length runs out
+    /// of input before it runs out of memory.
+    while (value.size() < size) {
+        const size_t done = value.size();
+        const size_t step = std::min(static_cast<size_t>(size) - done, std::max(STRING_READ_STEP, done));
+        value.resize(done + step);
+        deque_io::read_all(in, &value[done], step);
+    }
+    return value;
+}
+
+DequeSnapshotHeader
+DequeSnapshotHeader::make(const uint32_t elementSize, const Encoding encoding,
+                          const uint64_t frontSize, const uint64_t backSize)
+{
+    DequeSnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, MAGIC, sizeof(header.magic));
+    header.version = VERSION;
+    header.elementSize = elementSize;
+    header.encoding = encoding;
+    header.frontSize = frontSize;
+    header.backSize = backSize;
+    return header;
+}
+
+void
+DequeSnapshotHeader::check(const uint32_t expectedSize, const Encoding expectedEncoding) const
+{
+    if (0 != std::memcmp(magic, MAGIC, sizeof(magic))) {
+        throw std::runtime_error("Deque snapshot: bad magic");
+    }
+    if (VERSION != version) {
+        throw std::runtime_error("Deque snapshot: unsupported version");
+    }
+    if (expectedSize != elementSize || static_cast<uint32_t>(expectedEncoding) != encoding) {
+        throw std::runtime_error("Deque snapshot: saved with another element type");
+    }
+}
+
+uint64_t
+DequeSnapshotHeader::elements(const uint64_t maxSize) const
+{
+    if (frontSize > maxSize || backSize > maxSize - frontSize) {
+        throw std::runtime_error("Deque snapshot: size out of range");
+    }
+    return frontSize + backSize;
+}
+
+///==================================FD_STREAM_BUFFER======================
+
+FdStreamBuffer::FdStreamBuffer(const int descriptor)
+    : descriptor_(descriptor)
+    , output_(FD_BUFFER_SIZE)
+    , input_(FD_BUFFER_SIZE)
+{
+    setp(output_.data(), output_.data() + output_.size());
+    setg(input_.data(), input_.data(), input_.data());
+}
+
+FdStreamBuffer::~FdStreamBuffer()
+{
+    flush_output();
+}
+
+FdStreamBuffer::int_type
+FdStreamBuffer::overflow(int_type character)
+{
+    if (!flush_output()) return traits_type::eof();
+    if (!traits_type::eq_int_type(character, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(character);
+        pbump(1);
+    }
+    return traits_type::not_eof(character);
+}
+
+FdStreamBuffer::int_type
+FdStreamBuffer::underflow()
+{
+    ssize_t count;
+    do {
+        count = ::read(descriptor_, input_.data(), input_.size());
+    } while (count < 0 && EINTR == errno);
+    if (count <= 0) return traits_type::eof();
+    setg(input_.data(), input_.data(), input_.data() + count);
+    return traits_type::to_int_type(*gptr());
+}
+
+int
+FdStreamBuffer::sync()
+{
+    return flush_output() ? 0 : -1;
+}
+
+bool
+FdStreamBuffer::flush_output()
+{
+    const size_t pending = static_cast<size_t>(pptr() - pbase());
+    if (0 == pending) return true;
+    try {
+        deque_io::write_all(descriptor_, pbase(), pending);
+    } catch (const std::system_error&) {
+        return false;
+    }
+    setp(output_.data(), output_.data() + output_.size());
+    return true;
+}
+
+///==================================DEQUE_IO======================
+
+/// Loops over partial writes, so a run is one write call unless the kernel
+/// takes it in pieces.
+void
+deque_io::write_all(const int descriptor, const void* data, const size_t bytes)
+{
+    const char* cursor = static_cast<const char*>(data);
+    size_t left = bytes;
+    while (left > 0) {
+        const ssize_t written = ::write(descriptor, cursor, left);
+        if (written < 0) {
+            if (EINTR == errno) continue;
+            throw std::system_error(errno, std::generic_category(), "Deque snapshot: write");
+        }
+        cursor += written;
+        left -= static_cast<size_t>(written);
+    }
+}
+
+void
+deque_io::read_all(const int descriptor, void* data, const size_t bytes)
+{
+    char* cursor = static_cast<char*>(data);
+    size_t left = bytes;
+    while (left > 0) {
+        const ssize_t count = ::read(descriptor, cursor, left);
+        if (count < 0) {
+            if (EINTR == errno) continue;
+            throw std::system_error(errno, std::generic_category(), "Deque snapshot: read");
+        }
+        if (0 == count) throw std::runtime_error("Deque snapshot: truncated input");
+        cursor += count;
+        left -= static_cast<size_t>(count);
+    }
+}
+
+void
+deque_io::write_all(std::ostream& out, const void* data, const size_t bytes)
+{
+    out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+    if (!out) throw std::runtime_error("Deque snapshot: write failed");
+}
+
+void
+deque_io::read_all(std::istream& in, void* data, const size_t bytes)
+{
+    in.read(static_cast<char*>(data), static_cast<std::streamsize>(bytes));
+    if (static_cast<size_t>(in.gcount()) != bytes) throw std::runtime_error("Deque snapshot: truncated input");
+}
+
+bool
+deque_io::remaining(const int descriptor, uint64_t& bytes)
+{
+    struct stat status;
+    if (0 != ::fstat(descriptor, &status) || !S_ISREG(status.st_mode)) return false;
+    const off_t offset = ::lseek(descriptor, 0, SEEK_CUR);
+    if (offset < 0) return false;
+    bytes = status.st_size > offset ? static_cast<uint64_t>(status.st_size - offset) : 0;
+    return true;
+}
+
+bool
+deque_io::remaining(std::istream& in, uint64_t& bytes)
+{
+    const std::istream::pos_type offset = in.tellg();
+    if (std::istream::pos_type(-1) == offset) return false;
+    in.seekg(0, std::ios::end);
+    const std::istream::pos_type end = in.tellg();
+    in.clear();
+    in.seekg(offset);
+    if (std::istream::pos_type(-1) == end || !in) {
+        in.clear();
+        return false;
+    }
+    bytes = end > offset ? static_cast<uint64_t>(end - offset) : 0;
+    return true;
+}
+
@@ -0,0 +1,183 @@
+#include "headers/DequeStatistics.hpp"
+
+#include <cassert>
+
+const bool NoStatistics::enabled;
+const bool DequeStatistics::enabled;
+
+DequeStatistics::DequeStatistics()
+    : reallocations_(0)
+    , rebalances_(0)
+    , elementsMoved_(0)
+    , bytesMoved_(0)
+    , peakSize_(0)
+    , id_(0)
+    , name_()
+    , slot_(0)
+{
+    id_ = DequeStatisticsRegistry::instance().attach(this);
+}
+
+/// A copy is a new deque and starts counting from zero.
+DequeStatistics::DequeStatistics(const DequeStatistics&)
+    : reallocations_(0)
+    , rebalances_(0)
+    , elementsMoved_(0)
+    , bytesMoved_(0)
+    , peakSize_(0)
+    , id_(0)
+    , name_()
+    , slot_(0)
+{
+    id_ = DequeStatisticsRegistry::instance().attach(this);
+}
+
+DequeStatistics::~DequeStatistics()
+{
+    DequeStatisticsRegistry::instance().detach(this);
+}
+
+/// Assigning a deque keeps its own counters and registration.
+DequeStatistics&
+DequeStatistics::operator=(const DequeStatistics&)
+{
+    return *this;
+}
+
+DequeCounters
+DequeStatistics::counters() const
+{
+    DequeCounters counters;
+    counters.reallocations = reallocations_.load(std::memory_order_relaxed);
+    counters.rebalances = rebalances_.load(std::memory_order_relaxed);
+    counters.elementsMoved = elementsMoved_.load(std::memory_order_relaxed);
+    counters.bytesMoved = bytesMoved_.load(std::memory_order_relaxed);
+    counters.peakSize = peakSize_.load(std::memory_order_relaxed);
+    return counters;
+}
+
+unsigned long
+DequeStatistics::id() const
+{
+    return id_;
+}
+
+std::string
+DequeStatistics::name() const
+{
+    std::lock_guard<std::mutex> lock(DequeStatisticsRegistry::instance().mutex_);
+    return name_;
+}
+
+/// Labels the deque in dumps, e.g. with the connection it belongs to.
+void
+DequeStatistics::set_name(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(DequeStatisticsRegistry::instance().mutex_);
+    name_ = name;
+}
+
+///==================================REGISTRY======================
+
+/// Never destroyed, so deques that outlive main() can still detach.
+DequeStatisticsRegistry&
+DequeStatisticsRegistry::instance()
+{
+    static DequeStatisticsRegistry* registry = new DequeStatisticsRegistry();
+    return *registry;
+}
+
+DequeStatisticsRegistry::DequeStatisticsRegistry()
+    : mutex_()
+    , live_()
+    , retired_()
+    , nextId_(1)
+{}
+
+namespace {
+
+void
+accumulate(DequeCounters& total, const DequeCounters& counters)
+{
+    total.reallocations += counters.reallocations;
+    total.rebalances += counters.rebalances;
+    total.elementsMoved += counters.elementsMoved;
+    total.bytesMoved += counters.bytesMoved;
+    if (counters.peakSize > total.peakSize) {
+        total.peakSize = counters.peakSize;
+    }
+}
+
+void
+print(std::ostream& out, const DequeCounters& counters)
+{
+    out << " reallocations=" << counters.reallocations
+        << " rebalances=" << counters.rebalances
+        << " moved=" << counters.elementsMoved
+        << " bytes_moved=" << counters.bytesMoved
+        << " peak_size=" << counters.peakSize << '\n';
+}
+
+} /// namespace
+
+/// One line per live deque, then the retired and overall totals; peak_size
+/// of a total is the largest single peak.
+void
+DequeStatisticsRegistry::dump(std::ostream& out) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    DequeCounters total = retired_;
+    for (size_t i = 0; i < live_.size(); ++i) {
+        const DequeCounters counters = live_[i]->counters();
+        out << "deque #" << live_[i]->id_;
+        if (!live_[i]->name_.empty()) {
+            out << " (" << live_[i]->name_ << ")";
+        }
+        print(out, counters);
+        accumulate(total, counters);
+    }
+    out << "retired";
+    print(out, retired_);
+    out << "total";
+    print(out, total);
+}
+
+DequeCounters
+DequeStatisticsRegistry::totals() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    DequeCounters total = retired_;
+    for (size_t i = 0; i < live_.size(); ++i) {
+        accumulate(total, live_[i]->counters());
+    }
+    return total;
+}
+
+size_t
+DequeStatisticsRegistry::live() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return live_.size();
+}
+
+unsigned long
+DequeStatisticsRegistry::attach(DequeStatistics* statistics)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    statistics->slot_ = live_.size();
+    live_.push_back(statistics);
+    return nextId_++;
+}
+
+/// Moves the last entry into the freed slot.
+void
+DequeStatisticsRegistry::detach(DequeStatistics* statistics)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const size_t slot = statistics->slot_;
+    assert(slot < live_.size() && live_[slot] == statistics);
+    accumulate(retired_, statistics->counters());
+    live_[slot] = live_.back();
+    live_[slot]->slot_ = slot;
+    live_.pop_back();
+}
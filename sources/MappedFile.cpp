@@ -0,0 +1,173 @@
+#include "headers/MappedFile.hpp"
+
+#include <cassert>
+#include <cerrno>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+void
+fail(const std::string& what, const std::string& path)
+{
+    throw std::system_error(errno, std::generic_category(), what + " " + path);
+}
+
+} /// namespace
+
+MappedFile::MappedFile(const std::string& path, const Mode mode)
+    : path_(path)
+    , mode_(mode)
+    , descriptor_(-1)
+    , data_(NULL)
+    , size_(0)
+{
+    descriptor_ = READ_ONLY == mode ? ::open(path.c_str(), O_RDONLY | O_CLOEXEC)
+                                    : ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (descriptor_ < 0) fail("open", path_);
+    struct stat status;
+    if (::fstat(descriptor_, &status) != 0) {
+        ::close(descriptor_);
+        fail("fstat", path_);
+    }
+    size_ = static_cast<size_type>(status.st_size);
+    try {
+        data_ = map(size_);
+    } catch (...) {
+        ::close(descriptor_);
+        throw;
+    }
+}
+
+/// Dirty pages are written back by the kernel; call sync() first to wait.
+MappedFile::~MappedFile()
+{
+    unmap();
+    ::close(descriptor_);
+}
+
+char*
+MappedFile::data()
+{
+    return data_;
+}
+
+const char*
+MappedFile::data() const
+{
+    return data_;
+}
+
+MappedFile::size_type
+MappedFile::size() const
+{
+    return size_;
+}
+
+MappedFile::Mode
+MappedFile::mode() const
+{
+    return mode_;
+}
+
+/// Sets the file length and maps it again; the contents up to the smaller
+/// of the two sizes are kept. The old mapping is dropped only once the new
+/// one exists, so on failure data() and size() are unchanged, and a grown
+/// file is cut back to its old length.
+void
+MappedFile::resize(const size_type bytes)
+{
+    assert(READ_WRITE == mode_);
+    if (bytes > size_ && ::ftruncate(descriptor_, static_cast<off_t>(bytes)) != 0) fail("ftruncate", path_);
+    char* data = NULL;
+    try {
+        data = map(bytes);
+    } catch (...) {
+        if (bytes > size_) {
+            /// Best effort: the mmap error is the one reported.
+            const int restored = ::ftruncate(descriptor_, static_cast<off_t>(size_));
+            static_cast<void>(restored);
+        }
+        throw;
+    }
+    if (bytes < size_ && ::ftruncate(descriptor_, static_cast<off_t>(bytes)) != 0) {
+        const int error = errno;
+        if (NULL != data) ::munmap(data, bytes);
+        errno = error;
+        fail("ftruncate", path_);
+    }
+    unmap();
+    data_ = data;
+    size_ = bytes;
+}
+
+/// Asks for aggressive read-ahead and early reclaim behind the reader.
+void
+MappedFile::advise_sequential()
+{
+    if (NULL != data_) {
+        ::madvise(data_, size_, MADV_SEQUENTIAL);
+    }
+}
+
+/// Drops the whole pages inside [offset, offset + bytes) from this process.
+/// The file keeps its contents; the pages are reread if touched again.
+void
+MappedFile::release(const size_type offset, const size_type bytes)
+{
+    const size_type page = page_size();
+    const size_type first = (offset + page - 1) / page * page;
+    const size_type last = (offset + bytes) / page * page;
+    if (NULL != data_ && first < last) {
+        ::madvise(data_ + first, last - first, MADV_DONTNEED);
+    }
+}
+
+/// Blocks until every change made through data() is on disk.
+void
+MappedFile::sync()
+{
+    if (NULL != data_ && ::msync(data_, size_, MS_SYNC) != 0) fail("msync", path_);
+}
+
+/// Blocks until the changes inside [offset, offset + bytes) are on disk.
+void
+MappedFile::sync(const size_type offset, const size_type bytes)
+{
+    assert(offset + bytes <= size_);
+    const size_type first = offset / page_size() * page_size();
+    if (NULL != data_ && bytes > 0 && ::msync(data_ + first, offset + bytes - first, MS_SYNC) != 0) {
+        fail("msync", path_);
+    }
+}
+
+MappedFile::size_type
+MappedFile::page_size()
+{
+    static const size_type page = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+    return page;
+}
+
+char*
+MappedFile::map(const size_type bytes) const
+{
+    if (0 == bytes) return NULL;
+    const int protection = READ_ONLY == mode_ ? PROT_READ : PROT_READ | PROT_WRITE;
+    void* address = ::mmap(NULL, bytes, protection, MAP_SHARED, descriptor_, 0);
+    if (MAP_FAILED == address) fail("mmap", path_);
+    return static_cast<char*>(address);
+}
+
+void
+MappedFile::unmap()
+{
+    if (NULL != data_) {
+        ::munmap(data_, size_);
+        data_ = NULL;
+    }
+}
+
@@ -0,0 +1,80 @@
+#include "headers/MonotonicArena.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <new>
+
+const MonotonicArena::size_type MonotonicArena::DEFAULT_CHUNK_SIZE;
+
+MonotonicArena::MonotonicArena(const size_type chunkSize)
+    : chunks_()
+    , chunkSizes_()
+    , chunkSize_(chunkSize)
+    , cursor_(NULL)
+    , limit_(NULL)
+    , bytesAllocated_(0)
+{
+    assert(chunkSize > 0);
+}
+
+MonotonicArena::~MonotonicArena()
+{
+    for (size_type i = 0; i < chunks_.size(); ++i) {
+        ::operator delete(chunks_[i]);
+    }
+}
+
+void*
+MonotonicArena::allocate(const size_type bytes, const size_type alignment)
+{
+    assert(0 != alignment && 0 == (alignment & (alignment - 1)));
+    uintptr_t address = (reinterpret_cast<uintptr_t>(cursor_) + alignment - 1) & ~(alignment - 1);
+    if (NULL == cursor_ || address + bytes > reinterpret_cast<uintptr_t>(limit_)) {
+        addChunk(bytes + alignment);
+        address = (reinterpret_cast<uintptr_t>(cursor_) + alignment - 1) & ~(alignment - 1);
+    }
+    cursor_ = reinterpret_cast<char*>(address + bytes);
+    bytesAllocated_ += bytes;
+    return reinterpret_cast<void*>(address);
+}
+
+/// Keeps the largest chunk and rewinds into it, so an arena reused per
+/// request stops touching the heap once it has seen its peak.
+void
+MonotonicArena::release()
+{
+    if (chunks_.empty()) return;
+    for (size_type i = 0; i + 1 < chunks_.size(); ++i) {
+        ::operator delete(chunks_[i]);
+    }
+    chunks_.front() = chunks_.back();
+    chunkSizes_.front() = chunkSizes_.back();
+    chunks_.resize(1);
+    chunkSizes_.resize(1);
+    cursor_ = chunks_.front();
+    limit_ = cursor_ + chunkSizes_.front();
+    bytesAllocated_ = 0;
+}
+
+MonotonicArena::size_type
+MonotonicArena::bytesAllocated() const
+{
+    return bytesAllocated_;
+}
+
+/// Chunks double in size like a vector's buffer, so a growing container
+/// needs only logarithmically many of them.
+void
+MonotonicArena::addChunk(const size_type minimumBytes)
+{
+    size_type size = chunkSizes_.empty() ? chunkSize_ : chunkSizes_.back() * 2;
+    while (size < minimumBytes) {
+        size *= 2;
+    }
+    char* chunk = static_cast<char*>(::operator new(size));
+    chunks_.push_back(chunk);
+    chunkSizes_.push_back(size);
+    cursor_ = chunk;
+    limit_ = chunk + size;
+}
+
@@ -0,0 +1,119 @@
+#include "headers/ThreadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+
+ThreadPool::ThreadPool(const size_type workers)
+    : jobs_()
+    , workers_()
+{
+    workers_.reserve(workers);
+    for (size_type i = 0; i < workers; ++i) {
+        workers_.push_back(std::thread(&ThreadPool::work, this));
+    }
+}
+
+/// An empty job tells one worker to stop.
+ThreadPool::~ThreadPool()
+{
+    for (size_type i = 0; i < workers_.size(); ++i) {
+        jobs_.push_back(job());
+    }
+    for (size_type i = 0; i < workers_.size(); ++i) {
+        workers_[i].join();
+    }
+}
+
+ThreadPool::size_type
+ThreadPool::workers() const
+{
+    return workers_.size();
+}
+
+/// Threads a run() is spread over, the caller included.
+ThreadPool::size_type
+ThreadPool::threads() const
+{
+    return workers_.size() + 1;
+}
+
+/// One worker per core besides the calling thread.
+ThreadPool::size_type
+ThreadPool::default_workers()
+{
+    const size_type cores = std::thread::hardware_concurrency();
+    return cores > 1 ? cores - 1 : 0;
+}
+
+void
+ThreadPool::work()
+{
+    while (true) {
+        job next;
+        jobs_.pop_front_wait(next);
+        if (!next) return;
+        next();
+    }
+}
+
+namespace {
+
+/// Shared by the threads of one run(); lives on the caller's stack, so the
+/// caller waits until every helper has let go of it.
+struct Batch
+{
+    Batch(const size_t tasks, const std::function<void(size_t)>& task)
+        : tasks(tasks), task(task), next(0), helpers(0), error(), mutex(), done()
+    {}
+
+    /// Claims indices until none are left.
+    void drain()
+    {
+        for (size_t i = next.fetch_add(1); i < tasks; i = next.fetch_add(1)) {
+            try {
+                task(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) error = std::current_exception();
+            }
+        }
+    }
+
+    const size_t tasks;
+    const std::function<void(size_t)>& task;
+    std::atomic<size_t> next;
+    size_t helpers;
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable done;
+};
+
+} /// namespace
+
+/// Helpers are queued only as far as there is work for them; a helper
+/// that starts after the indices ran out returns at once.
+void
+ThreadPool::run(const size_type tasks, const std::function<void(size_type)>& task)
+{
+    if (0 == tasks) return;
+    Batch batch(tasks, task);
+    const size_type helpers = std::min(workers_.size(), tasks - 1);
+    batch.helpers = helpers;
+    for (size_type i = 0; i < helpers; ++i) {
+        jobs_.push_back([&batch]() {
+            batch.drain();
+            std::lock_guard<std::mutex> lock(batch.mutex);
+            if (0 == --batch.helpers) batch.done.notify_one();
+        });
+    }
+    batch.drain();
+    {
+        std::unique_lock<std::mutex> lock(batch.mutex);
+        batch.done.wait(lock, [&batch]() { return 0 == batch.helpers; });
+    }
+    if (batch.error) std::rethrow_exception(batch.error);
+}
+
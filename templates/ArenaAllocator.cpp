@@ -0,0 +1,51 @@
+#include "../headers/ArenaAllocator.hpp"
+#include <limits>
+#include <new>
+
+template <typename T>
+ArenaAllocator<T>::ArenaAllocator(MonotonicArena& arena)
+    : arena_(&arena)
+{}
+
+template <typename T>
+template <typename U>
+ArenaAllocator<T>::ArenaAllocator(const ArenaAllocator<U>& rhv)
+    : arena_(rhv.getArena())
+{}
+
+template <typename T>
+T*
+ArenaAllocator<T>::allocate(const size_type count)
+{
+    if (count > std::numeric_limits<size_type>::max() / sizeof(T)) {
+        throw std::bad_alloc();
+    }
+    return static_cast<T*>(arena_->allocate(count * sizeof(T), alignof(T)));
+}
+
+template <typename T>
+void
+ArenaAllocator<T>::deallocate(T* /*pointer*/, const size_type /*count*/)
+{}
+
+template <typename T>
+MonotonicArena*
+ArenaAllocator<T>::getArena() const
+{
+    return arena_;
+}
+
+template <typename T, typename U>
+bool
+operator==(const ArenaAllocator<T>& lhv, const ArenaAllocator<U>& rhv)
+{
+    return lhv.getArena() == rhv.getArena();
+}
+
+template <typename T, typename U>
+bool
+operator!=(const ArenaAllocator<T>& lhv, const ArenaAllocator<U>& rhv)
+{
+    return !(lhv == rhv);
+}
+
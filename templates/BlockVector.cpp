@@ -0,0 +1,979 @@
+#include "../headers/BlockVector.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+template <typename T, typename Allocator>
+const typename BlockVector<T, Allocator>::size_type BlockVector<T, Allocator>::BLOCK_SIZE;
+
+template <typename T, typename Allocator>
+BlockVector<T, Allocator>::BlockVector()
+    : allocator_()
+    , map_(map_allocator(allocator_))
+    , size_(0)
+{}
+
+template <typename T, typename Allocator>
+BlockVector<T, Allocator>::BlockVector(const Allocator& allocator)
+    : allocator_(allocator)
+    , map_(map_allocator(allocator_))
+    , size_(0)
+{}
+
+template <typename T, typename Allocator>
+BlockVector<T, Allocator>::BlockVector(const BlockVector<T, Allocator>& rhv)
+    : allocator_(traits::select_on_container_copy_construction(rhv.allocator_))
+    , map_(map_allocator(allocator_))
+    , size_(0)
+{
+    assign_from(rhv);
+}
+
+template <typename T, typename Allocator>
+BlockVector<T, Allocator>::BlockVector(BlockVector<T, Allocator>&& rhv) noexcept
+    : allocator_(std::move(rhv.allocator_))
+    , map_(std::move(rhv.map_))
+    , size_(rhv.size_)
+{
+    rhv.map_.clear();
+    rhv.size_ = 0;
+}
+
+template <typename T, typename Allocator>
+BlockVector<T, Allocator>::~BlockVector()
+{
+    clear();
+    deallocate_blocks();
+}
+
+template <typename T, typename Allocator>
+BlockVector<T, Allocator>&
+BlockVector<T, Allocator>::operator=(const BlockVector<T, Allocator>& rhv)
+{
+    if (this == &rhv) return *this;
+    if (traits::propagate_on_container_copy_assignment::value && !(allocator_ == rhv.allocator_)) {
+        clear();
+        deallocate_blocks();
+        adopt_allocator(rhv.allocator_, typename traits::propagate_on_container_copy_assignment());
+    }
+    assign_from(rhv);
+    return *this;
+}
+
+template <typename T, typename Allocator>
+BlockVector<T, Allocator>&
+BlockVector<T, Allocator>::operator=(BlockVector<T, Allocator>&& rhv) noexcept(nothrow_move_assignment::value)
+{
+    if (this == &rhv) return *this;
+    clear();
+    if (traits::propagate_on_container_move_assignment::value || allocator_ == rhv.allocator_) {
+        deallocate_blocks();
+        adopt_allocator(rhv.allocator_, typename traits::propagate_on_container_move_assignment());
+        take(rhv);
+        return *this;
+    }
+    /// blocks of an unequal allocator cannot be adopted, only their elements
+    for (size_type i = 0; i < rhv.size_; ++i) {
+        push_back(std::move(rhv[i]));
+    }
+    rhv.clear();
+    return *this;
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::reference
+BlockVector<T, Allocator>::operator[](const size_type index)
+{
+    return map_[index / BLOCK_SIZE][index % BLOCK_SIZE];
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::const_reference
+BlockVector<T, Allocator>::operator[](const size_type index) const
+{
+    return map_[index / BLOCK_SIZE][index % BLOCK_SIZE];
+}
+
+template <typename T, typename Allocator>
+template <typename InputIterator>
+void
+BlockVector<T, Allocator>::assign(InputIterator first, InputIterator last)
+{
+    clear();
+    insert(end(), first, last);
+}
+
+/// A forward range of trivially copyable elements is measured, a gap is
+/// opened with memmove and the range is copied in run by run. Anything else
+/// is appended and rotated into place.
+template <typename T, typename Allocator>
+template <typename InputIterator, typename>
+void
+BlockVector<T, Allocator>::insert(iterator position, InputIterator first, InputIterator last)
+{
+    typedef typename std::iterator_traits<InputIterator>::iterator_category category;
+    insert_range(position.getIndex(), first, last,
+                 std::integral_constant<bool, std::is_trivially_copyable<T>::value
+                                           && std::is_base_of<std::forward_iterator_tag, category>::value>());
+}
+
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::insert(iterator position, const size_type size, const_reference value)
+{
+    insert_fill(position.getIndex(), size, value, std::is_trivially_copyable<T>());
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::iterator
+BlockVector<T, Allocator>::insert(iterator position, const_reference value)
+{
+    return emplace(position, value);
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::iterator
+BlockVector<T, Allocator>::insert(iterator position, value_type&& value)
+{
+    return emplace(position, std::move(value));
+}
+
+/// Constructs the new element at the back, where no existing element has to
+/// move, and rotates it into place.
+template <typename T, typename Allocator>
+template <typename... Args>
+typename BlockVector<T, Allocator>::iterator
+BlockVector<T, Allocator>::emplace(iterator position, Args&&... args)
+{
+    const size_type index = position.getIndex();
+    emplace_back(std::forward<Args>(args)...);
+    std::rotate(begin() + index, end() - 1, end());
+    return begin() + index;
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::iterator
+BlockVector<T, Allocator>::erase(iterator position)
+{
+    return erase(position, position + 1);
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::iterator
+BlockVector<T, Allocator>::erase(iterator first, iterator last)
+{
+    const size_type index = first.getIndex();
+    erase_range(index, last - first, std::is_trivially_copyable<T>());
+    return begin() + index;
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+void
+BlockVector<T, Allocator>::emplace_back(Args&&... args)
+{
+    if (size_ == map_.size() * BLOCK_SIZE) {
+        append_block();
+    }
+    traits::construct(allocator_, &(*this)[size_], std::forward<Args>(args)...);
+    ++size_;
+}
+
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::push_back(const_reference value)
+{
+    emplace_back(value);
+}
+
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::push_back(value_type&& value)
+{
+    emplace_back(std::move(value));
+}
+
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::pop_back()
+{
+    assert(!empty());
+    --size_;
+    traits::destroy(allocator_, &(*this)[size_]);
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::reference
+BlockVector<T, Allocator>::front()
+{
+    assert(!empty());
+    return map_.front()[0];
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::const_reference
+BlockVector<T, Allocator>::front() const
+{
+    assert(!empty());
+    return map_.front()[0];
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::reference
+BlockVector<T, Allocator>::back()
+{
+    assert(!empty());
+    return (*this)[size_ - 1];
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::const_reference
+BlockVector<T, Allocator>::back() const
+{
+    assert(!empty());
+    return (*this)[size_ - 1];
+}
+
+/// Value-initialized elements of a trivial type are zero bytes, so they are
+/// written with memset.
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::resize(const size_type newSize)
+{
+    if (newSize < size_) {
+        destroy_from(newSize, std::is_trivially_destructible<T>());
+        return;
+    }
+    append_default(newSize - size_,
+                   std::integral_constant<bool, std::is_trivially_copyable<T>::value
+                                             && std::is_trivially_default_constructible<T>::value>());
+}
+
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::resize(const size_type newSize, const_reference initialValue)
+{
+    if (newSize < size_) {
+        destroy_from(newSize, std::is_trivially_destructible<T>());
+        return;
+    }
+    insert_fill(size_, newSize - size_, initialValue, std::is_trivially_copyable<T>());
+}
+
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::reserve(const size_type newCapacity)
+{
+    reserve_blocks(newCapacity);
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::size_type
+BlockVector<T, Allocator>::capacity() const
+{
+    return map_.size() * BLOCK_SIZE;
+}
+
+/// Frees the blocks past the last element; elements never move.
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::shrink_to_fit()
+{
+    const size_type blocks = (size_ + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    while (map_.size() > blocks) {
+        traits::deallocate(allocator_, map_.back(), BLOCK_SIZE);
+        map_.pop_back();
+    }
+    map_.shrink_to_fit();
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::size_type
+BlockVector<T, Allocator>::max_size() const
+{
+    return std::numeric_limits<size_type>::max() / sizeof(T);
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::size_type
+BlockVector<T, Allocator>::size() const
+{
+    return size_;
+}
+
+template <typename T, typename Allocator>
+bool
+BlockVector<T, Allocator>::empty() const
+{
+    return 0 == size_;
+}
+
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::clear()
+{
+    destroy_from(0, std::is_trivially_destructible<T>());
+}
+
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::swap(BlockVector<T, Allocator>& rhv) noexcept
+{
+    if (traits::propagate_on_container_swap::value) {
+        using std::swap;
+        swap(allocator_, rhv.allocator_);
+    }
+    map_.swap(rhv.map_);
+    std::swap(size_, rhv.size_);
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::allocator_type
+BlockVector<T, Allocator>::get_allocator() const
+{
+    return allocator_;
+}
+
+/// Number of blocks holding elements; each is one contiguous segment.
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::size_type
+BlockVector<T, Allocator>::segment_count() const
+{
+    return (size_ + BLOCK_SIZE - 1) / BLOCK_SIZE;
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::pointer
+BlockVector<T, Allocator>::segment_data(const size_type segment)
+{
+    assert(segment < segment_count());
+    return map_[segment];
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::const_pointer
+BlockVector<T, Allocator>::segment_data(const size_type segment) const
+{
+    assert(segment < segment_count());
+    return map_[segment];
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::size_type
+BlockVector<T, Allocator>::segment_size(const size_type segment) const
+{
+    assert(segment < segment_count());
+    const size_type remaining = size_ - segment * BLOCK_SIZE;
+    return remaining < BLOCK_SIZE ? remaining : BLOCK_SIZE;
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::const_iterator
+BlockVector<T, Allocator>::begin() const
+{
+    return const_iterator(this, 0);
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::const_iterator
+BlockVector<T, Allocator>::end() const
+{
+    return const_iterator(this, size_);
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::iterator
+BlockVector<T, Allocator>::begin()
+{
+    return iterator(this, 0);
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::iterator
+BlockVector<T, Allocator>::end()
+{
+    return iterator(this, size_);
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::pointer
+BlockVector<T, Allocator>::allocate_block()
+{
+    return traits::allocate(allocator_, BLOCK_SIZE);
+}
+
+/// Allocators that do not propagate, such as polymorphic_allocator, may not
+/// be assignable at all, so the assignment is only instantiated for those
+/// that do.
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::adopt_allocator(const Allocator& allocator, std::true_type)
+{
+    allocator_ = allocator;
+}
+
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::adopt_allocator(const Allocator&, std::false_type)
+{}
+
+/// The block is freed again if the map cannot grow to hold it.
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::append_block()
+{
+    const pointer block = allocate_block();
+    try {
+        map_.push_back(block);
+    } catch (...) {
+        traits::deallocate(allocator_, block, BLOCK_SIZE);
+        throw;
+    }
+}
+
+/// Allocates blocks up front until newSize elements fit.
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::reserve_blocks(const size_type newSize)
+{
+    const size_type blocks = (newSize + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    map_.reserve(blocks);
+    while (map_.size() < blocks) {
+        append_block();
+    }
+}
+
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::deallocate_blocks()
+{
+    for (size_type i = 0; i < map_.size(); ++i) {
+        traits::deallocate(allocator_, map_[i], BLOCK_SIZE);
+    }
+    map_.clear();
+}
+
+/// Adopts the blocks of rhv, whose allocator is known to be able to free them.
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::take(BlockVector<T, Allocator>& rhv)
+{
+    map_.swap(rhv.map_);
+    size_ = rhv.size_;
+    rhv.size_ = 0;
+}
+
+/// Makes *this a copy of rhv run by run, where a run is the longest stretch
+/// contiguous in both. Live elements are assigned over, the rest are
+/// constructed, and existing blocks are reused.
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::assign_from(const BlockVector<T, Allocator>& rhv)
+{
+    while (size_ > rhv.size_) {
+        pop_back();
+    }
+    size_type index = 0;
+    while (index < size_) {
+        const size_type offset = index % BLOCK_SIZE;
+        const size_type count = std::min(BLOCK_SIZE - offset, size_ - index);
+        const_pointer source = &rhv[index];
+        std::copy(source, source + count, &(*this)[index]);
+        index += count;
+    }
+    reserve_blocks(rhv.size_);
+    while (size_ < rhv.size_) {
+        const size_type offset = size_ % BLOCK_SIZE;
+        const size_type count = std::min(BLOCK_SIZE - offset, rhv.size_ - size_);
+        construct_run(&(*this)[size_], &rhv[size_], count, std::is_trivially_copyable<T>());
+    }
+}
+
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::construct_run(pointer destination, const_pointer source, const size_type count, std::true_type)
+{
+    std::memcpy(static_cast<void*>(destination), source, count * sizeof(T));
+    size_ += count;
+}
+
+/// size_ follows each element, so a throwing copy leaves a valid vector.
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::construct_run(pointer destination, const_pointer source, const size_type count, std::false_type)
+{
+    for (size_type i = 0; i < count; ++i) {
+        traits::construct(allocator_, destination + i, source[i]);
+        ++size_;
+    }
+}
+
+template <typename T, typename Allocator>
+template <typename ForwardIterator>
+void
+BlockVector<T, Allocator>::insert_range(const size_type index, ForwardIterator first, ForwardIterator last, std::true_type)
+{
+    size_type count = std::distance(first, last);
+    open_gap(index, count);
+    for (size_type at = index; count > 0; ) {
+        const size_type run = std::min(BLOCK_SIZE - at % BLOCK_SIZE, count);
+        ForwardIterator runEnd = first;
+        std::advance(runEnd, run);
+        std::copy(first, runEnd, &(*this)[at]);
+        first = runEnd;
+        at += run;
+        count -= run;
+    }
+}
+
+template <typename T, typename Allocator>
+template <typename InputIterator>
+void
+BlockVector<T, Allocator>::insert_range(const size_type index, InputIterator first, InputIterator last, std::false_type)
+{
+    const size_type oldSize = size_;
+    for (; first != last; ++first) {
+        push_back(*first);
+    }
+    std::rotate(begin() + index, begin() + oldSize, end());
+}
+
+/// value is copied first, since it may live in the part that moves.
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::insert_fill(const size_type index, const size_type count, const_reference value, std::true_type)
+{
+    const T copy = value;
+    open_gap(index, count);
+    fill_elements(index, count, copy);
+}
+
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::insert_fill(const size_type index, const size_type count, const_reference value, std::false_type)
+{
+    const size_type oldSize = size_;
+    for (size_type i = 0; i < count; ++i) {
+        push_back(value);
+    }
+    std::rotate(begin() + index, begin() + oldSize, end());
+}
+
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::append_default(const size_type count, std::true_type)
+{
+    insert_fill(size_, count, T(), std::true_type());
+}
+
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::append_default(const size_type count, std::false_type)
+{
+    for (size_type i = 0; i < count; ++i) {
+        emplace_back();
+    }
+}
+
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::erase_range(const size_type index, const size_type count, std::true_type)
+{
+    move_elements(index, index + count, size_ - index - count);
+    size_ -= count;
+}
+
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::erase_range(const size_type index, const size_type count, std::false_type)
+{
+    std::move(begin() + (index + count), end(), begin() + index);
+    destroy_from(size_ - count, std::is_trivially_destructible<T>());
+}
+
+/// Trivially destructible elements need no destructor calls.
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::destroy_from(const size_type newSize, std::true_type)
+{
+    assert(newSize <= size_);
+    size_ = newSize;
+}
+
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::destroy_from(const size_type newSize, std::false_type)
+{
+    assert(newSize <= size_);
+    while (size_ > newSize) {
+        pop_back();
+    }
+}
+
+/// Grows by count and shifts [index, old size) up by count, leaving the gap
+/// unconstructed. Trivially copyable T only.
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::open_gap(const size_type index, const size_type count)
+{
+    assert(index <= size_);
+    const size_type oldSize = size_;
+    reserve_blocks(size_ + count);
+    size_ += count;
+    move_elements(index + count, index, oldSize - index);
+}
+
+/// memmove of count elements from index from to index to, one run at a time,
+/// where a run ends at a block boundary of either side. Runs are taken from
+/// the far end when moving up, so overlapping ranges are safe.
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::move_elements(size_type to, size_type from, size_type count)
+{
+    if (to == from) return;
+    if (to < from) {
+        while (count > 0) {
+            const size_type run = std::min(std::min(BLOCK_SIZE - to % BLOCK_SIZE, BLOCK_SIZE - from % BLOCK_SIZE), count);
+            std::memmove(static_cast<void*>(&(*this)[to]), &(*this)[from], run * sizeof(T));
+            to += run;
+            from += run;
+            count -= run;
+        }
+        return;
+    }
+    while (count > 0) {
+        const size_type toEnd = to + count;
+        const size_type fromEnd = from + count;
+        const size_type run = std::min(std::min((toEnd - 1) % BLOCK_SIZE + 1, (fromEnd - 1) % BLOCK_SIZE + 1), count);
+        std::memmove(static_cast<void*>(&(*this)[toEnd - run]), &(*this)[fromEnd - run], run * sizeof(T));
+        count -= run;
+    }
+}
+
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::fill_elements(size_type index, size_type count, const_reference value)
+{
+    while (count > 0) {
+        const size_type run = std::min(BLOCK_SIZE - index % BLOCK_SIZE, count);
+        fill_run(&(*this)[index], run, value);
+        index += run;
+        count -= run;
+    }
+}
+
+/// A value made of one repeated byte, such as zero, is written with memset.
+template <typename T, typename Allocator>
+void
+BlockVector<T, Allocator>::fill_run(pointer destination, const size_type count, const_reference value)
+{
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+    if (std::equal(bytes + 1, bytes + sizeof(T), bytes)) {
+        std::memset(static_cast<void*>(destination), bytes[0], count * sizeof(T));
+        return;
+    }
+    std::fill_n(destination, count, value);
+}
+
+///==================================CONST_ITERATOR======================
+
+template <typename T, typename Allocator>
+BlockVector<T, Allocator>::const_iterator::const_iterator()
+    : vector_(NULL)
+    , index_(0)
+{}
+
+template <typename T, typename Allocator>
+BlockVector<T, Allocator>::const_iterator::const_iterator(const const_iterator& rhv)
+    : vector_(rhv.vector_)
+    , index_(rhv.index_)
+{}
+
+template <typename T, typename Allocator>
+BlockVector<T, Allocator>::const_iterator::~const_iterator()
+{
+    vector_ = NULL;
+}
+
+template <typename T, typename Allocator>
+BlockVector<T, Allocator>::const_iterator::const_iterator(const BlockVector<T, Allocator>* vector, const size_type index)
+    : vector_(vector)
+    , index_(index)
+{}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::const_iterator&
+BlockVector<T, Allocator>::const_iterator::operator=(const const_iterator& rhv)
+{
+    vector_ = rhv.vector_;
+    index_ = rhv.index_;
+    return *this;
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::const_reference
+BlockVector<T, Allocator>::const_iterator::operator*() const
+{
+    return (*vector_)[index_];
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::const_pointer
+BlockVector<T, Allocator>::const_iterator::operator->() const
+{
+    return &(*vector_)[index_];
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::const_reference
+BlockVector<T, Allocator>::const_iterator::operator[](const difference_type index) const
+{
+    return (*vector_)[index_ + index];
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::const_iterator&
+BlockVector<T, Allocator>::const_iterator::operator++()
+{
+    ++index_;
+    return *this;
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::const_iterator
+BlockVector<T, Allocator>::const_iterator::operator++(int)
+{
+    const_iterator temp(*this);
+    ++index_;
+    return temp;
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::const_iterator&
+BlockVector<T, Allocator>::const_iterator::operator--()
+{
+    --index_;
+    return *this;
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::const_iterator
+BlockVector<T, Allocator>::const_iterator::operator--(int)
+{
+    const_iterator temp(*this);
+    --index_;
+    return temp;
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::const_iterator
+BlockVector<T, Allocator>::const_iterator::operator+(const difference_type size) const
+{
+    return const_iterator(vector_, index_ + size);
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::const_iterator
+BlockVector<T, Allocator>::const_iterator::operator-(const difference_type size) const
+{
+    return const_iterator(vector_, index_ - size);
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::const_iterator&
+BlockVector<T, Allocator>::const_iterator::operator+=(const difference_type size)
+{
+    index_ += size;
+    return *this;
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::const_iterator&
+BlockVector<T, Allocator>::const_iterator::operator-=(const difference_type size)
+{
+    index_ -= size;
+    return *this;
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::difference_type
+BlockVector<T, Allocator>::const_iterator::operator-(const const_iterator& rhv) const
+{
+    return static_cast<difference_type>(index_) - static_cast<difference_type>(rhv.index_);
+}
+
+template <typename T, typename Allocator>
+bool
+BlockVector<T, Allocator>::const_iterator::operator==(const const_iterator& rhv) const
+{
+    return index_ == rhv.index_ && vector_ == rhv.vector_;
+}
+
+template <typename T, typename Allocator>
+bool
+BlockVector<T, Allocator>::const_iterator::operator!=(const const_iterator& rhv) const
+{
+    return !(*this == rhv);
+}
+
+template <typename T, typename Allocator>
+bool
+BlockVector<T, Allocator>::const_iterator::operator<(const const_iterator& rhv) const
+{
+    return index_ < rhv.index_;
+}
+
+template <typename T, typename Allocator>
+bool
+BlockVector<T, Allocator>::const_iterator::operator>(const const_iterator& rhv) const
+{
+    return rhv < *this;
+}
+
+template <typename T, typename Allocator>
+bool
+BlockVector<T, Allocator>::const_iterator::operator<=(const const_iterator& rhv) const
+{
+    return !(*this > rhv);
+}
+
+template <typename T, typename Allocator>
+bool
+BlockVector<T, Allocator>::const_iterator::operator>=(const const_iterator& rhv) const
+{
+    return !(*this < rhv);
+}
+
+template <typename T, typename Allocator>
+const BlockVector<T, Allocator>*
+BlockVector<T, Allocator>::const_iterator::getVector() const
+{
+    return vector_;
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::size_type
+BlockVector<T, Allocator>::const_iterator::getIndex() const
+{
+    return index_;
+}
+
+///====================================================ITERATOR==============================================
+
+template <typename T, typename Allocator>
+BlockVector<T, Allocator>::iterator::iterator()
+    : const_iterator()
+{}
+
+template <typename T, typename Allocator>
+BlockVector<T, Allocator>::iterator::iterator(const iterator& rhv)
+    : const_iterator(rhv)
+{}
+
+template <typename T, typename Allocator>
+BlockVector<T, Allocator>::iterator::~iterator()
+{}
+
+template <typename T, typename Allocator>
+BlockVector<T, Allocator>::iterator::iterator(const BlockVector<T, Allocator>* vector, const size_type index)
+    : const_iterator(vector, index)
+{}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::iterator&
+BlockVector<T, Allocator>::iterator::operator=(const iterator& rhv)
+{
+    const_iterator::operator=(rhv);
+    return *this;
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::reference
+BlockVector<T, Allocator>::iterator::operator*() const
+{
+    return const_cast<reference>(const_iterator::operator*());
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::pointer
+BlockVector<T, Allocator>::iterator::operator->() const
+{
+    return const_cast<pointer>(const_iterator::operator->());
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::reference
+BlockVector<T, Allocator>::iterator::operator[](const difference_type index) const
+{
+    return const_cast<reference>(const_iterator::operator[](index));
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::iterator&
+BlockVector<T, Allocator>::iterator::operator++()
+{
+    const_iterator::operator++();
+    return *this;
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::iterator
+BlockVector<T, Allocator>::iterator::operator++(int)
+{
+    iterator temp(*this);
+    const_iterator::operator++();
+    return temp;
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::iterator&
+BlockVector<T, Allocator>::iterator::operator--()
+{
+    const_iterator::operator--();
+    return *this;
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::iterator
+BlockVector<T, Allocator>::iterator::operator--(int)
+{
+    iterator temp(*this);
+    const_iterator::operator--();
+    return temp;
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::iterator
+BlockVector<T, Allocator>::iterator::operator+(const difference_type size) const
+{
+    return iterator(this->getVector(), this->getIndex() + size);
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::iterator
+BlockVector<T, Allocator>::iterator::operator-(const difference_type size) const
+{
+    return iterator(this->getVector(), this->getIndex() - size);
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::iterator&
+BlockVector<T, Allocator>::iterator::operator+=(const difference_type size)
+{
+    const_iterator::operator+=(size);
+    return *this;
+}
+
+template <typename T, typename Allocator>
+typename BlockVector<T, Allocator>::iterator&
+BlockVector<T, Allocator>::iterator::operator-=(const difference_type size)
+{
+    const_iterator::operator-=(size);
+    return *this;
+}
+
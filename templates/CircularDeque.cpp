@@ -0,0 +1,439 @@
+#include "../headers/CircularDeque.hpp"
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <new>
+#include <utility>
+
+template <typename T>
+CircularDeque<T>::CircularDeque(const size_type capacity)
+    : buffer_(static_cast<pointer>(::operator new(capacity * sizeof(T))))
+    , capacity_(capacity)
+    , head_(0)
+    , size_(0)
+{
+    assert(capacity > 0 && capacity <= max_size());
+}
+
+template <typename T>
+CircularDeque<T>::CircularDeque(const CircularDeque<T>& rhv)
+    : buffer_(static_cast<pointer>(::operator new(rhv.capacity_ * sizeof(T))))
+    , capacity_(rhv.capacity_)
+    , head_(0)
+    , size_(0)
+{
+    for (size_type i = 0; i < rhv.size_; ++i) {
+        new (buffer_ + i) T(rhv[i]);
+        ++size_;
+    }
+}
+
+/// Leaves rhv without a buffer; only assignment and destruction may follow.
+template <typename T>
+CircularDeque<T>::CircularDeque(CircularDeque<T>&& rhv) noexcept
+    : buffer_(rhv.buffer_)
+    , capacity_(rhv.capacity_)
+    , head_(rhv.head_)
+    , size_(rhv.size_)
+{
+    rhv.buffer_ = NULL;
+    rhv.capacity_ = 0;
+    rhv.head_ = 0;
+    rhv.size_ = 0;
+}
+
+template <typename T>
+CircularDeque<T>::~CircularDeque()
+{
+    clear();
+    ::operator delete(buffer_);
+}
+
+template <typename T>
+CircularDeque<T>&
+CircularDeque<T>::operator=(const CircularDeque<T>& rhv)
+{
+    if (this == &rhv) return *this;
+    CircularDeque<T> temp(rhv);
+    swap(temp);
+    return *this;
+}
+
+template <typename T>
+CircularDeque<T>&
+CircularDeque<T>::operator=(CircularDeque<T>&& rhv) noexcept
+{
+    if (this == &rhv) return *this;
+    CircularDeque<T> temp(std::move(rhv));
+    swap(temp);
+    return *this;
+}
+
+template <typename T>
+bool
+CircularDeque<T>::operator==(const CircularDeque<T>& rhv) const
+{
+    if (this == &rhv)       return true;
+    if (size_ != rhv.size_) return false;
+    return std::equal(begin(), end(), rhv.begin());
+}
+
+template <typename T>
+bool
+CircularDeque<T>::operator!=(const CircularDeque<T>& rhv) const
+{
+    return !(*this == rhv);
+}
+
+template <typename T>
+typename CircularDeque<T>::reference
+CircularDeque<T>::operator[](const size_type index)
+{
+    return buffer_[slot(index)];
+}
+
+template <typename T>
+typename CircularDeque<T>::const_reference
+CircularDeque<T>::operator[](const size_type index) const
+{
+    return buffer_[slot(index)];
+}
+
+/// When full, the back element is destroyed and the new one constructed in
+/// its slot, so args must not refer to it; push_front(back()) is handled.
+template <typename T>
+template <typename... Args>
+typename CircularDeque<T>::reference
+CircularDeque<T>::emplace_front(Args&&... args)
+{
+    if (size_ == capacity_) pop_back();
+    const size_type newHead = (0 == head_ ? capacity_ : head_) - 1;
+    new (buffer_ + newHead) T(std::forward<Args>(args)...);
+    head_ = newHead;
+    ++size_;
+    return buffer_[newHead];
+}
+
+/// When full, the front element is destroyed and the new one constructed
+/// in its slot, so args must not refer to it; push_back(front()) is handled.
+template <typename T>
+template <typename... Args>
+typename CircularDeque<T>::reference
+CircularDeque<T>::emplace_back(Args&&... args)
+{
+    if (size_ == capacity_) pop_front();
+    pointer element = buffer_ + slot(size_);
+    new (element) T(std::forward<Args>(args)...);
+    ++size_;
+    return *element;
+}
+
+template <typename T>
+void
+CircularDeque<T>::push_front(const_reference value)
+{
+    if (size_ == capacity_ && &value == &back()) {
+        rotate_back();
+        return;
+    }
+    emplace_front(value);
+}
+
+template <typename T>
+void
+CircularDeque<T>::push_front(value_type&& value)
+{
+    if (size_ == capacity_ && &value == &back()) {
+        rotate_back();
+        return;
+    }
+    emplace_front(std::move(value));
+}
+
+template <typename T>
+void
+CircularDeque<T>::push_back(const_reference value)
+{
+    if (size_ == capacity_ && &value == &front()) {
+        rotate_front();
+        return;
+    }
+    emplace_back(value);
+}
+
+template <typename T>
+void
+CircularDeque<T>::push_back(value_type&& value)
+{
+    if (size_ == capacity_ && &value == &front()) {
+        rotate_front();
+        return;
+    }
+    emplace_back(std::move(value));
+}
+
+template <typename T>
+bool
+CircularDeque<T>::push_front(const_reference value, value_type& evicted)
+{
+    if (size_ < capacity_) {
+        emplace_front(value);
+        return false;
+    }
+    if (&value == &back()) {
+        evicted = value;
+        rotate_back();
+        return true;
+    }
+    evicted = std::move(back());
+    emplace_front(value);
+    return true;
+}
+
+template <typename T>
+bool
+CircularDeque<T>::push_front(value_type&& value, value_type& evicted)
+{
+    if (size_ < capacity_) {
+        emplace_front(std::move(value));
+        return false;
+    }
+    if (&value == &back()) {
+        T element(std::move(value));
+        evicted = std::move(back());
+        pop_back();
+        emplace_front(std::move(element));
+        return true;
+    }
+    evicted = std::move(back());
+    emplace_front(std::move(value));
+    return true;
+}
+
+template <typename T>
+bool
+CircularDeque<T>::push_back(const_reference value, value_type& evicted)
+{
+    if (size_ < capacity_) {
+        emplace_back(value);
+        return false;
+    }
+    if (&value == &front()) {
+        evicted = value;
+        rotate_front();
+        return true;
+    }
+    evicted = std::move(front());
+    emplace_back(value);
+    return true;
+}
+
+template <typename T>
+bool
+CircularDeque<T>::push_back(value_type&& value, value_type& evicted)
+{
+    if (size_ < capacity_) {
+        emplace_back(std::move(value));
+        return false;
+    }
+    if (&value == &front()) {
+        T element(std::move(value));
+        evicted = std::move(front());
+        pop_front();
+        emplace_back(std::move(element));
+        return true;
+    }
+    evicted = std::move(front());
+    emplace_back(std::move(value));
+    return true;
+}
+
+template <typename T>
+void
+CircularDeque<T>::pop_front()
+{
+    assert(!empty());
+    buffer_[head_].~T();
+    head_ = (head_ + 1 == capacity_) ? 0 : head_ + 1;
+    --size_;
+}
+
+template <typename T>
+void
+CircularDeque<T>::pop_back()
+{
+    assert(!empty());
+    --size_;
+    buffer_[slot(size_)].~T();
+}
+
+template <typename T>
+typename CircularDeque<T>::reference
+CircularDeque<T>::front()
+{
+    assert(!empty());
+    return buffer_[head_];
+}
+
+template <typename T>
+typename CircularDeque<T>::const_reference
+CircularDeque<T>::front() const
+{
+    assert(!empty());
+    return buffer_[head_];
+}
+
+template <typename T>
+typename CircularDeque<T>::reference
+CircularDeque<T>::back()
+{
+    assert(!empty());
+    return buffer_[slot(size_ - 1)];
+}
+
+template <typename T>
+typename CircularDeque<T>::const_reference
+CircularDeque<T>::back() const
+{
+    assert(!empty());
+    return buffer_[slot(size_ - 1)];
+}
+
+template <typename T>
+typename CircularDeque<T>::size_type
+CircularDeque<T>::capacity() const
+{
+    return capacity_;
+}
+
+template <typename T>
+typename CircularDeque<T>::size_type
+CircularDeque<T>::max_size() const
+{
+    return std::numeric_limits<size_type>::max() / sizeof(T);
+}
+
+template <typename T>
+typename CircularDeque<T>::size_type
+CircularDeque<T>::size() const
+{
+    return size_;
+}
+
+template <typename T>
+bool
+CircularDeque<T>::empty() const
+{
+    return 0 == size_;
+}
+
+/// The next push_back evicts the front, the next push_front the back.
+template <typename T>
+bool
+CircularDeque<T>::full() const
+{
+    return size_ == capacity_;
+}
+
+template <typename T>
+void
+CircularDeque<T>::clear()
+{
+    while (size_ > 0) {
+        pop_back();
+    }
+    head_ = 0;
+}
+
+template <typename T>
+void
+CircularDeque<T>::swap(CircularDeque<T>& rhv) noexcept
+{
+    std::swap(buffer_, rhv.buffer_);
+    std::swap(capacity_, rhv.capacity_);
+    std::swap(head_, rhv.head_);
+    std::swap(size_, rhv.size_);
+}
+
+template <typename T>
+typename CircularDeque<T>::const_iterator
+CircularDeque<T>::begin() const
+{
+    return const_iterator(buffer_, capacity_, head_);
+}
+
+template <typename T>
+typename CircularDeque<T>::const_iterator
+CircularDeque<T>::end() const
+{
+    return const_iterator(buffer_, capacity_, head_ + size_);
+}
+
+template <typename T>
+typename CircularDeque<T>::const_reverse_iterator
+CircularDeque<T>::rbegin() const
+{
+    return const_reverse_iterator(end());
+}
+
+template <typename T>
+typename CircularDeque<T>::const_reverse_iterator
+CircularDeque<T>::rend() const
+{
+    return const_reverse_iterator(begin());
+}
+
+template <typename T>
+typename CircularDeque<T>::iterator
+CircularDeque<T>::begin()
+{
+    return iterator(buffer_, capacity_, head_);
+}
+
+template <typename T>
+typename CircularDeque<T>::iterator
+CircularDeque<T>::end()
+{
+    return iterator(buffer_, capacity_, head_ + size_);
+}
+
+template <typename T>
+typename CircularDeque<T>::reverse_iterator
+CircularDeque<T>::rbegin()
+{
+    return reverse_iterator(end());
+}
+
+template <typename T>
+typename CircularDeque<T>::reverse_iterator
+CircularDeque<T>::rend()
+{
+    return reverse_iterator(begin());
+}
+
+/// Buffer slot of a logical index; head_ + index < 2 * capacity_ always.
+template <typename T>
+typename CircularDeque<T>::size_type
+CircularDeque<T>::slot(const size_type index) const
+{
+    return CapacityWrap::slot(head_ + index, capacity_);
+}
+
+/// In a full ring the front's slot follows the back's, so moving the head
+/// turns the front into the back without touching an element.
+template <typename T>
+void
+CircularDeque<T>::rotate_front()
+{
+    assert(full());
+    head_ = (head_ + 1 == capacity_) ? 0 : head_ + 1;
+}
+
+template <typename T>
+void
+CircularDeque<T>::rotate_back()
+{
+    assert(full());
+    head_ = (0 == head_ ? capacity_ : head_) - 1;
+}
+
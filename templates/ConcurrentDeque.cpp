@@ -0,0 +1,197 @@
+#include "../headers/ConcurrentDeque.hpp"
+#include <iterator>
+#include <utility>
+
+template <typename T>
+const typename ConcurrentDeque<T>::size_type ConcurrentDeque<T>::CACHE_LINE;
+
+template <typename T>
+ConcurrentDeque<T>::ConcurrentDeque()
+    : frontMutex_()
+    , front_()
+    , backMutex_()
+    , back_()
+    , waitMutex_()
+    , ready_()
+    , waiters_(0)
+{}
+
+template <typename T>
+ConcurrentDeque<T>::~ConcurrentDeque()
+{}
+
+template <typename T>
+void
+ConcurrentDeque<T>::push_front(const_reference value)
+{
+    {
+        std::lock_guard<std::mutex> lock(frontMutex_);
+        front_.push_back(value);
+    }
+    notify();
+}
+
+template <typename T>
+void
+ConcurrentDeque<T>::push_front(value_type&& value)
+{
+    {
+        std::lock_guard<std::mutex> lock(frontMutex_);
+        front_.push_back(std::move(value));
+    }
+    notify();
+}
+
+template <typename T>
+void
+ConcurrentDeque<T>::push_back(const_reference value)
+{
+    {
+        std::lock_guard<std::mutex> lock(backMutex_);
+        back_.push_back(value);
+    }
+    notify();
+}
+
+template <typename T>
+void
+ConcurrentDeque<T>::push_back(value_type&& value)
+{
+    {
+        std::lock_guard<std::mutex> lock(backMutex_);
+        back_.push_back(std::move(value));
+    }
+    notify();
+}
+
+template <typename T>
+bool
+ConcurrentDeque<T>::try_pop_front(reference value)
+{
+    std::unique_lock<std::mutex> frontLock(frontMutex_);
+    if (front_.empty()) {
+        std::lock_guard<std::mutex> backLock(backMutex_);
+        if (back_.empty()) return false;
+        const size_type half = (back_.size() + 1) / 2;
+        typedef std::reverse_iterator<typename std::vector<T>::iterator> reversed;
+        front_.assign(std::make_move_iterator(reversed(back_.begin() + half)),
+                      std::make_move_iterator(reversed(back_.begin())));
+        back_.erase(back_.begin(), back_.begin() + half);
+    }
+    value = std::move(front_.back());
+    front_.pop_back();
+    return true;
+}
+
+/// The back lock is dropped before both are taken, to keep the front-first
+/// lock order.
+template <typename T>
+bool
+ConcurrentDeque<T>::try_pop_back(reference value)
+{
+    std::unique_lock<std::mutex> backLock(backMutex_);
+    if (back_.empty()) {
+        backLock.unlock();
+        std::lock_guard<std::mutex> frontLock(frontMutex_);
+        backLock.lock();
+        if (back_.empty()) {
+            if (front_.empty()) return false;
+            const size_type half = (front_.size() + 1) / 2;
+            typedef std::reverse_iterator<typename std::vector<T>::iterator> reversed;
+            back_.assign(std::make_move_iterator(reversed(front_.begin() + half)),
+                         std::make_move_iterator(reversed(front_.begin())));
+            front_.erase(front_.begin(), front_.begin() + half);
+        }
+    }
+    value = std::move(back_.back());
+    back_.pop_back();
+    return true;
+}
+
+template <typename T>
+void
+ConcurrentDeque<T>::pop_front_wait(reference value)
+{
+    wait_and_pop(&ConcurrentDeque<T>::try_pop_front, value, NULL);
+}
+
+template <typename T>
+void
+ConcurrentDeque<T>::pop_back_wait(reference value)
+{
+    wait_and_pop(&ConcurrentDeque<T>::try_pop_back, value, NULL);
+}
+
+/// Returns false if nothing could be popped before the timeout expired.
+template <typename T>
+template <typename Rep, typename Period>
+bool
+ConcurrentDeque<T>::pop_front_wait(reference value, const std::chrono::duration<Rep, Period>& timeout)
+{
+    const clock::time_point deadline = clock::now() + std::chrono::duration_cast<clock::duration>(timeout);
+    return wait_and_pop(&ConcurrentDeque<T>::try_pop_front, value, &deadline);
+}
+
+/// Returns false if nothing could be popped before the timeout expired.
+template <typename T>
+template <typename Rep, typename Period>
+bool
+ConcurrentDeque<T>::pop_back_wait(reference value, const std::chrono::duration<Rep, Period>& timeout)
+{
+    const clock::time_point deadline = clock::now() + std::chrono::duration_cast<clock::duration>(timeout);
+    return wait_and_pop(&ConcurrentDeque<T>::try_pop_back, value, &deadline);
+}
+
+/// A snapshot; exact only while no other thread is using the deque.
+template <typename T>
+typename ConcurrentDeque<T>::size_type
+ConcurrentDeque<T>::size() const
+{
+    std::lock_guard<std::mutex> frontLock(frontMutex_);
+    std::lock_guard<std::mutex> backLock(backMutex_);
+    return front_.size() + back_.size();
+}
+
+template <typename T>
+bool
+ConcurrentDeque<T>::empty() const
+{
+    return 0 == size();
+}
+
+/// Called after the end lock is released. A waiter registers in waiters_
+/// before its last try under the end locks, so either that try sees the new
+/// element or this load sees the waiter. Taking waitMutex_ makes sure the
+/// waiter is already asleep before it is notified.
+template <typename T>
+void
+ConcurrentDeque<T>::notify()
+{
+    if (0 == waiters_.load()) return;
+    {
+        std::lock_guard<std::mutex> lock(waitMutex_);
+    }
+    ready_.notify_one();
+}
+
+template <typename T>
+bool
+ConcurrentDeque<T>::wait_and_pop(pop_function pop, reference value, const clock::time_point* deadline)
+{
+    if ((this->*pop)(value)) return true;
+    std::unique_lock<std::mutex> lock(waitMutex_);
+    ++waiters_;
+    bool popped = (this->*pop)(value);
+    while (!popped) {
+        if (NULL == deadline) {
+            ready_.wait(lock);
+        } else if (std::cv_status::timeout == ready_.wait_until(lock, *deadline)) {
+            popped = (this->*pop)(value);
+            break;
+        }
+        popped = (this->*pop)(value);
+    }
+    --waiters_;
+    return popped;
+}
+
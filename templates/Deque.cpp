@@ -1,234 +1,431 @@
 #include "../headers/Deque.hpp"
 #include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <utility>
 
-template <typename T>
-Deque<T>::Deque()
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+Deque<T, Allocator, Storage, Statistics>::Deque()
 {}
 
-template <typename T>
-Deque<T>::Deque(const size_type newSize, const_reference initialValue)
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+Deque<T, Allocator, Storage, Statistics>::Deque(const Allocator& allocator)
+    : front_(allocator)
+    , back_(allocator)
+{}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+Deque<T, Allocator, Storage, Statistics>::Deque(const size_type newSize, const_reference initialValue, const Allocator& allocator)
+    : front_(allocator)
+    , back_(allocator)
 {
     resize(newSize, initialValue);
 }
 
-template <typename T>
-Deque<T>::Deque(const int newSize, const_reference initialValue)
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+Deque<T, Allocator, Storage, Statistics>::Deque(const int newSize, const_reference initialValue, const Allocator& allocator)
+    : front_(allocator)
+    , back_(allocator)
 {
     resize(newSize, initialValue);
 }
 
-template <typename T>
+/// One assign into back_, which sizes forward ranges once and copies
+/// trivially copyable elements with memmove.
+template <typename T, typename Allocator, typename Storage, typename Statistics>
 template <typename InputIterator>
-Deque<T>::Deque(InputIterator first, InputIterator last)
+Deque<T, Allocator, Storage, Statistics>::Deque(InputIterator first, InputIterator last, const Allocator& allocator)
+    : front_(allocator)
+    , back_(allocator)
 {
-    for (InputIterator it = first; it != last; ++it) {
-        push_back(*it);
-    }
+    back_.assign(first, last);
 }
 
-template <typename T>
-Deque<T>::Deque(const Deque<T>& rhv)
-{
-    if (this == &rhv) return;
-    for (const_iterator it = rhv.begin(); it < rhv.end(); ++it) {
-        push_back(*it);     
-    }
-}
+/// Copies each half as it is stored, so every half is allocated once at its
+/// exact size and filled in one pass (a memmove for trivially copyable T).
+/// The copy starts its own statistics.
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+Deque<T, Allocator, Storage, Statistics>::Deque(const Deque<T, Allocator, Storage, Statistics>& rhv)
+    : Statistics()
+    , front_(rhv.front_)
+    , back_(rhv.back_)
+{}
 
-template <typename T>
-Deque<T>::~Deque()
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+Deque<T, Allocator, Storage, Statistics>::Deque(Deque<T, Allocator, Storage, Statistics>&& rhv)
+    noexcept(nothrow_move_construction::value)
+    : Statistics()
+    , front_(std::move(rhv.front_))
+    , back_(std::move(rhv.back_))
+{}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+Deque<T, Allocator, Storage, Statistics>::~Deque()
 {
     clear();
 }
 
-template <typename T>
-Deque<T>&
-Deque<T>::operator=(const Deque<T>& rhv)
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+Deque<T, Allocator, Storage, Statistics>&
+Deque<T, Allocator, Storage, Statistics>::operator=(const Deque<T, Allocator, Storage, Statistics>& rhv)
 {
-    if (*this == rhv) return *this;
-    clear();
+    if (this == &rhv) return *this;
     front_ = rhv.front_;
     back_ = rhv.back_;
     return *this;
 }
 
-template <typename T>
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+Deque<T, Allocator, Storage, Statistics>&
+Deque<T, Allocator, Storage, Statistics>::operator=(Deque<T, Allocator, Storage, Statistics>&& rhv)
+    noexcept(nothrow_move_assignment::value)
+{
+    if (this == &rhv) return *this;
+    front_ = std::move(rhv.front_);
+    back_ = std::move(rhv.back_);
+    return *this;
+}
+
+/// Compares run against run; for integers, enums and pointers each pair of
+/// runs with the same direction is one memcmp.
+template <typename T, typename Allocator, typename Storage, typename Statistics>
 bool
-Deque<T>::operator==(const Deque<T>& rhv) const
+Deque<T, Allocator, Storage, Statistics>::operator==(const Deque<T, Allocator, Storage, Statistics>& rhv) const
 {
     if (this == &rhv)         return true;
     if (size() != rhv.size()) return false;
-    const size_type newSize = size();
-    for (size_type i = 0; i < newSize; ++i) {
-        if (*this[i] != rhv[i]) return false;
-    }
-    return true;
+    return size() == first_mismatch(rhv, size(), trivially_comparable());
 }
 
-template <typename T>
+template <typename T, typename Allocator, typename Storage, typename Statistics>
 bool
-Deque<T>::operator!=(const Deque<T>& rhv) const
+Deque<T, Allocator, Storage, Statistics>::operator!=(const Deque<T, Allocator, Storage, Statistics>& rhv) const
 {
     return !(*this == rhv);
 }
 
-template <typename T>
+/// For trivially comparable T the common prefix is skipped with the
+/// memcmp-based mismatch search and only the first differing pair is
+/// ordered with operator<.
+template <typename T, typename Allocator, typename Storage, typename Statistics>
 bool
-Deque<T>::operator<(const Deque<T>& rhv) const
+Deque<T, Allocator, Storage, Statistics>::operator<(const Deque<T, Allocator, Storage, Statistics>& rhv) const
 {
-    const_iterator start1 = begin();
-    const_iterator start2 = rhv.begin();
-    for (; start1 != end() && start2 != rhv.end(); ++start1, ++start2) {
-        if (*start1 < *start2) return true;
-        if (*start1 > *start2) return false;
+    if (trivially_comparable::value) {
+        const size_type common = size() < rhv.size() ? size() : rhv.size();
+        const size_type index = first_mismatch(rhv, common, trivially_comparable());
+        if (index < common) return (*this)[index] < rhv[index];
+        return size() < rhv.size();
     }
-    return start1 == end() && start2 != rhv.end();
+    return std::lexicographical_compare(begin(), end(), rhv.begin(), rhv.end());
 }
 
-template <typename T>
+template <typename T, typename Allocator, typename Storage, typename Statistics>
 bool
-Deque<T>::operator>(const Deque<T>& rhv) const
+Deque<T, Allocator, Storage, Statistics>::operator>(const Deque<T, Allocator, Storage, Statistics>& rhv) const
 {
     return rhv < *this;
 }
 
-template <typename T>
+template <typename T, typename Allocator, typename Storage, typename Statistics>
 bool
-Deque<T>::operator<=(const Deque<T>& rhv) const
+Deque<T, Allocator, Storage, Statistics>::operator<=(const Deque<T, Allocator, Storage, Statistics>& rhv) const
 {
     return !(*this > rhv);
 }
 
-template <typename T>
+template <typename T, typename Allocator, typename Storage, typename Statistics>
 bool
-Deque<T>::operator>=(const Deque<T>& rhv) const
+Deque<T, Allocator, Storage, Statistics>::operator>=(const Deque<T, Allocator, Storage, Statistics>& rhv) const
 {
     return !(*this < rhv);
 }
  
-template <typename T>
-typename Deque<T>::reference
-Deque<T>::operator[](const size_type index)
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::reference
+Deque<T, Allocator, Storage, Statistics>::operator[](const size_type index)
 {
     if (index < front_.size()) {
-        return front_[size() - index - 1];
+        return front_[front_.size() - index - 1];
     }
     return back_[index - front_.size()];
 }
 
-template <typename T>
-typename Deque<T>::const_reference
-Deque<T>::operator[](const size_type index) const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_reference
+Deque<T, Allocator, Storage, Statistics>::operator[](const size_type index) const
 {
     if (index < front_.size()) {
-        return front_[size() - index - 1];
+        return front_[front_.size() - index - 1];
     }
     return back_[index - front_.size()];
 }
 
-template <typename T>
-typename Deque<T>::iterator
-Deque<T>::insert(iterator position, const_reference value)
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::iterator
+Deque<T, Allocator, Storage, Statistics>::insert(iterator position, const_reference value)
 {
-    if (position <= front_.end() && position >= back_.end()) {
-        return front_.insert(front_.end() - position, value);
-    }
-    return back_.insert(back_.begin() + (position - front_.size()), value);
+    return emplace(position, value);
 }
 
-template <typename T>
-void
-Deque<T>::insert(iterator position, size_type size, const_reference value)
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::iterator
+Deque<T, Allocator, Storage, Statistics>::insert(iterator position, value_type&& value)
 {
-    for (size_type i = 0; i < size; ++i) {
-        insert(position, value);
+    return emplace(position, std::move(value));
+}
+
+/// Like emplace, opens the gap in one half and shifts that half only once.
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+void
+Deque<T, Allocator, Storage, Statistics>::insert(iterator position, size_type size, const_reference value)
+{
+    const size_type index = position.getIndex();
+    const size_type frontSize = front_.size();
+    if (index < frontSize || (index == frontSize && index < back_.size())) {
+        growth_probe probe(*this, front_);
+        Statistics::record_moves(index, sizeof(T));
+        front_.insert(front_.begin() + (frontSize - index), size, value);
+    } else {
+        growth_probe probe(*this, back_);
+        Statistics::record_moves(back_.size() - (index - frontSize), sizeof(T));
+        back_.insert(back_.begin() + (index - frontSize), size, value);
     }
 }
 
-template <typename T>
-template <typename InputIterator>
+/// The storage insert measures forward ranges up front. Elements entering
+/// front_ are inserted in order and then reversed in place, which works for
+/// single-pass ranges as well.
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+template <typename InputIterator, typename>
 void
-Deque<T>::insert(iterator position, InputIterator first, InputIterator last)
+Deque<T, Allocator, Storage, Statistics>::insert(iterator position, InputIterator first, InputIterator last)
+{
+    const size_type index = position.getIndex();
+    const size_type frontSize = front_.size();
+    if (index < frontSize || (index == frontSize && index < back_.size())) {
+        const size_type offset = frontSize - index;
+        growth_probe probe(*this, front_);
+        Statistics::record_moves(index, sizeof(T));
+        front_.insert(front_.begin() + offset, first, last);
+        const size_type count = front_.size() - frontSize;
+        std::reverse(front_.begin() + offset, front_.begin() + offset + count);
+    } else {
+        growth_probe probe(*this, back_);
+        Statistics::record_moves(back_.size() - (index - frontSize), sizeof(T));
+        back_.insert(back_.begin() + (index - frontSize), first, last);
+    }
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::iterator
+Deque<T, Allocator, Storage, Statistics>::erase(iterator position)
 {
-    while (first != last) {
-        position = insert(position, *first);
-        ++first;
-        ++position;
+    const size_type index = position.getIndex();
+    const size_type frontSize = front_.size();
+    assert(index < size());
+    if (index < frontSize) {
+        Statistics::record_moves(index, sizeof(T));
+        front_.erase(front_.begin() + (frontSize - index - 1));
+    } else {
+        Statistics::record_moves(back_.size() - (index - frontSize) - 1, sizeof(T));
+        back_.erase(back_.begin() + (index - frontSize));
+    }
+    return iterator(this, index);
+}
+
+/// Splits [first, last) at the boundary of the halves and erases each part
+/// with one storage call.
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::iterator
+Deque<T, Allocator, Storage, Statistics>::erase(iterator first, iterator last)
+{
+    const size_type begin = first.getIndex();
+    const size_type end = last.getIndex();
+    const size_type frontSize = front_.size();
+    assert(begin <= end && end <= size());
+    if (end > frontSize) {
+        const size_type from = (begin > frontSize ? begin : frontSize) - frontSize;
+        Statistics::record_moves(back_.size() - (end - frontSize), sizeof(T));
+        back_.erase(back_.begin() + from, back_.begin() + (end - frontSize));
+    }
+    if (begin < frontSize) {
+        const size_type to = end < frontSize ? end : frontSize;
+        Statistics::record_moves(begin, sizeof(T));
+        front_.erase(front_.begin() + (frontSize - to), front_.begin() + (frontSize - begin));
+    }
+    return iterator(this, begin);
+}
+
+/// Constructs the element in place in whichever half needs fewer elements
+/// shifted to open the slot.
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+template <typename... Args>
+typename Deque<T, Allocator, Storage, Statistics>::iterator
+Deque<T, Allocator, Storage, Statistics>::emplace(iterator position, Args&&... args)
+{
+    const size_type index = position.getIndex();
+    const size_type frontSize = front_.size();
+    if (index < frontSize || (index == frontSize && index < back_.size())) {
+        growth_probe probe(*this, front_);
+        Statistics::record_moves(index, sizeof(T));
+        front_.emplace(front_.begin() + (frontSize - index), std::forward<Args>(args)...);
+    } else {
+        growth_probe probe(*this, back_);
+        Statistics::record_moves(back_.size() - (index - frontSize), sizeof(T));
+        back_.emplace(back_.begin() + (index - frontSize), std::forward<Args>(args)...);
     }
+    return iterator(this, index);
 }
 
-template <typename T>
-typename Deque<T>::iterator
-Deque<T>::erase(iterator position)
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+template <typename... Args>
+typename Deque<T, Allocator, Storage, Statistics>::reference
+Deque<T, Allocator, Storage, Statistics>::emplace_front(Args&&... args)
 {
-    if (position <= front_.end() && position >= back_.end()) {
-        return front_.erase(front_.end() - position);
+    {
+        growth_probe probe(*this, front_);
+        front_.emplace_back(std::forward<Args>(args)...);
     }
-    return back_.erase(back_.begin() + (position - front_.size()));
+    return front_.back();
 }
 
-template <typename T>
-typename Deque<T>::iterator
-Deque<T>::erase(iterator first, iterator last)
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+template <typename... Args>
+typename Deque<T, Allocator, Storage, Statistics>::reference
+Deque<T, Allocator, Storage, Statistics>::emplace_back(Args&&... args)
 {
-    while (first != last) {
-        first = erase(first);
-        --last;
+    {
+        growth_probe probe(*this, back_);
+        back_.emplace_back(std::forward<Args>(args)...);
     }
-    return first;
+    return back_.back();
 }
 
-template <typename T>
+template <typename T, typename Allocator, typename Storage, typename Statistics>
 void
-Deque<T>::push_front(const_reference value)
+Deque<T, Allocator, Storage, Statistics>::push_front(const_reference value)
 {
-    if (!front_.empty()) {
-        front_.push_back(value);
-        return;
-    }
-    back_.insert(back_.begin(), value);
+    growth_probe probe(*this, front_);
+    front_.push_back(value);
 }
 
-template <typename T>
+template <typename T, typename Allocator, typename Storage, typename Statistics>
 void
-Deque<T>::push_back(const_reference value)
+Deque<T, Allocator, Storage, Statistics>::push_front(value_type&& value)
 {
-    if (!back_.empty()) {
-        back_.push_back(value);
-        return;
-    }
-    front_.insert(front_.begin(), value);
+    growth_probe probe(*this, front_);
+    front_.push_back(std::move(value));
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+void
+Deque<T, Allocator, Storage, Statistics>::push_back(const_reference value)
+{
+    growth_probe probe(*this, back_);
+    back_.push_back(value);
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+void
+Deque<T, Allocator, Storage, Statistics>::push_back(value_type&& value)
+{
+    growth_probe probe(*this, back_);
+    back_.push_back(std::move(value));
+}
+
+/// One storage insert at the end of back_: a forward range is measured
+/// first, so the half grows at most once and the block is copied in one
+/// pass.
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+template <typename InputIterator, typename>
+void
+Deque<T, Allocator, Storage, Statistics>::append(InputIterator first, InputIterator last)
+{
+    growth_probe probe(*this, back_);
+    back_.insert(back_.end(), first, last);
+}
+
+/// Puts [first, last) in front of the current front element, keeping the
+/// order of the range: afterwards front() is *first.
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+template <typename InputIterator, typename>
+void
+Deque<T, Allocator, Storage, Statistics>::prepend(InputIterator first, InputIterator last)
+{
+    typedef typename std::iterator_traits<InputIterator>::iterator_category category;
+    growth_probe probe(*this, front_);
+    prepend_range(first, last,
+                  std::integral_constant<bool, std::is_base_of<std::bidirectional_iterator_tag, category>::value>());
+}
+
+/// front_ is stored reversed, so the range is appended to it back to
+/// front in a single pass.
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+template <typename BidirectionalIterator>
+void
+Deque<T, Allocator, Storage, Statistics>::prepend_range(BidirectionalIterator first, BidirectionalIterator last, std::true_type)
+{
+    typedef std::reverse_iterator<BidirectionalIterator> reversed;
+    front_.insert(front_.end(), reversed(last), reversed(first));
+}
+
+/// A single-pass range can only be read forward: it is appended in order
+/// and the new tail of front_ reversed in place.
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+template <typename InputIterator>
+void
+Deque<T, Allocator, Storage, Statistics>::prepend_range(InputIterator first, InputIterator last, std::false_type)
+{
+    const size_type frontSize = front_.size();
+    front_.insert(front_.end(), first, last);
+    std::reverse(front_.begin() + frontSize, front_.end());
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+void
+Deque<T, Allocator, Storage, Statistics>::push_back_n(const size_type count, const_reference value)
+{
+    growth_probe probe(*this, back_);
+    back_.insert(back_.end(), count, value);
 }
 
-template <typename T>
+template <typename T, typename Allocator, typename Storage, typename Statistics>
 void
-Deque<T>::pop_front()
+Deque<T, Allocator, Storage, Statistics>::push_front_n(const size_type count, const_reference value)
+{
+    growth_probe probe(*this, front_);
+    front_.insert(front_.end(), count, value);
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+void
+Deque<T, Allocator, Storage, Statistics>::pop_front()
 {
     assert(!empty());
-    if (!front_.empty()) {
-        front_.pop_back();
-        return;
+    if (front_.empty()) {
+        rebalance_front();
     }
-    back_.erase(back_.begin());
+    front_.pop_back();
 }
 
-template <typename T>
+template <typename T, typename Allocator, typename Storage, typename Statistics>
 void
-Deque<T>::pop_back()
+Deque<T, Allocator, Storage, Statistics>::pop_back()
 {
     assert(!empty());
-    if (!back_.empty()) {
-        back_.pop_back();
-        return;
+    if (back_.empty()) {
+        rebalance_back();
     }
-    front_.erase(front_.begin());
+    back_.pop_back();
 }
 
-template <typename T>
-typename Deque<T>::reference
-Deque<T>::front()
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::reference
+Deque<T, Allocator, Storage, Statistics>::front()
 {
     assert(!empty());
     if (!front_.empty()) {
@@ -237,9 +434,9 @@ Deque<T>::front()
     return back_.front();
 }
 
-template <typename T>
-typename Deque<T>::const_reference
-Deque<T>::front() const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_reference
+Deque<T, Allocator, Storage, Statistics>::front() const
 {
     assert(!empty());
     if (!front_.empty()) {
@@ -248,9 +445,9 @@ Deque<T>::front() const
     return back_.front();
 }
 
-template <typename T>
-typename Deque<T>::reference
-Deque<T>::back()
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::reference
+Deque<T, Allocator, Storage, Statistics>::back()
 {
     assert(!empty());
     if (!back_.empty()) {
@@ -259,9 +456,9 @@ Deque<T>::back()
     return front_.front();
 }
 
-template <typename T>
-typename Deque<T>::const_reference
-Deque<T>::back() const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_reference
+Deque<T, Allocator, Storage, Statistics>::back() const
 {
     assert(!empty());
     if (!back_.empty()) {
@@ -270,740 +467,1136 @@ Deque<T>::back() const
     return front_.front();
 }
 
-template <typename T>
+/// One resize of back_, or a clear of back_ and one erase in front_, so the
+/// storage can fill or destroy in bulk (memset or nothing at all for
+/// trivial T).
+template <typename T, typename Allocator, typename Storage, typename Statistics>
 void
-Deque<T>::resize(const size_type newSize, const_reference initialValue)
+Deque<T, Allocator, Storage, Statistics>::resize(const size_type newSize)
 {
-    const size_type currentSize = size();
-    if (newSize == currentSize) return;
-
-    for (size_type i = newSize; i < currentSize; ++i) {
-        pop_back();
+    const size_type frontSize = front_.size();
+    if (newSize < frontSize) {
+        back_.clear();
+        front_.erase(front_.begin(), front_.begin() + (frontSize - newSize));
+        return;
     }
-    for (size_type i = currentSize; i < newSize; ++i) {
-        push_back(initialValue);
+    growth_probe probe(*this, back_);
+    back_.resize(newSize - frontSize);
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+void
+Deque<T, Allocator, Storage, Statistics>::resize(const size_type newSize, const_reference initialValue)
+{
+    const size_type frontSize = front_.size();
+    if (newSize < frontSize) {
+        back_.clear();
+        front_.erase(front_.begin(), front_.begin() + (frontSize - newSize));
+        return;
     }
+    growth_probe probe(*this, back_);
+    back_.resize(newSize - frontSize, initialValue);
+}
+
+/// Lets the front half hold newCapacity elements, so that many elements
+/// can sit in front of the split point without reallocating.
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+void
+Deque<T, Allocator, Storage, Statistics>::reserve_front(const size_type newCapacity)
+{
+    front_.reserve(newCapacity);
+}
+
+/// Lets the back half hold newCapacity elements, so that many elements
+/// can sit behind the split point without reallocating.
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+void
+Deque<T, Allocator, Storage, Statistics>::reserve_back(const size_type newCapacity)
+{
+    back_.reserve(newCapacity);
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::size_type
+Deque<T, Allocator, Storage, Statistics>::capacity_front() const
+{
+    return front_.capacity();
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::size_type
+Deque<T, Allocator, Storage, Statistics>::capacity_back() const
+{
+    return back_.capacity();
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+void
+Deque<T, Allocator, Storage, Statistics>::shrink_to_fit()
+{
+    front_.shrink_to_fit();
+    back_.shrink_to_fit();
 }
 
-template <typename T>
-typename Deque<T>::size_type
-Deque<T>::max_size() const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::size_type
+Deque<T, Allocator, Storage, Statistics>::max_size() const
 {
     return std::numeric_limits<size_type>::max() / sizeof(T);
 }
 
-template <typename T>
-typename Deque<T>::size_type
-Deque<T>::size() const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::size_type
+Deque<T, Allocator, Storage, Statistics>::size() const
 {
     return front_.size() + back_.size();
 }
 
-template <typename T>
+template <typename T, typename Allocator, typename Storage, typename Statistics>
 bool
-Deque<T>::empty() const
+Deque<T, Allocator, Storage, Statistics>::empty() const
 {
     return back_.empty() && front_.empty();
 }
 
-template <typename T>
+template <typename T, typename Allocator, typename Storage, typename Statistics>
 void
-Deque<T>::clear()
+Deque<T, Allocator, Storage, Statistics>::clear()
 {
     back_.clear();
     front_.clear();
 }
 
-template <typename T>
+template <typename T, typename Allocator, typename Storage, typename Statistics>
 void
-Deque<T>::swap(Deque<T>& rhv)
+Deque<T, Allocator, Storage, Statistics>::swap(Deque<T, Allocator, Storage, Statistics>& rhv)
+    noexcept(nothrow_swap::value)
 {
     front_.swap(rhv.front_);
     back_.swap(rhv.back_);
 }
 
-template <typename T>
-typename Deque<T>::iterator 
-Deque<T>::begin() 
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::allocator_type
+Deque<T, Allocator, Storage, Statistics>::get_allocator() const
+{
+    return front_.get_allocator();
+}
+
+/// Calls function(data, size, reversed) for every contiguous run of
+/// elements, in logical order. Runs of the front half are stored backwards:
+/// their logical first element is data[size - 1]. Runs of the back half
+/// have reversed == false. Storage with one buffer per half yields at most
+/// two runs; segmented storage yields one run per block.
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+template <typename Function>
+void
+Deque<T, Allocator, Storage, Statistics>::for_each_segment(Function function) const
 {
-    return iterator(this, (!front_.empty()) ? &front_.back() : &back_.front());
+    visit_front_runs(front_, function);
+    visit_back_runs(back_, function);
 }
 
-template <typename T>
-typename Deque<T>::iterator 
-Deque<T>::end()
+/// As the const overload, with mutable data pointers.
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+template <typename Function>
+void
+Deque<T, Allocator, Storage, Statistics>::for_each_segment(Function function)
 {
-    return iterator(this, (!back_.empty()) ? &back_.back() : &front_.front());
+    visit_front_runs(front_, function);
+    visit_back_runs(back_, function);
+}
+
+/// Moves the front half to the start of the back half in logical order, so
+/// every element is stored forward and for_each_segment reports no reversed
+/// run until the next push_front or front rebalance. O(n).
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+void
+Deque<T, Allocator, Storage, Statistics>::normalize()
+{
+    if (front_.empty()) return;
+    growth_probe probe(*this, back_);
+    Statistics::record_moves(front_.size() + back_.size(), sizeof(T));
+    typedef std::reverse_iterator<typename Storage::iterator> reversed;
+    back_.insert(back_.begin(), std::make_move_iterator(reversed(front_.end())),
+                 std::make_move_iterator(reversed(front_.begin())));
+    front_.clear();
+}
+
+/// The instrumentation policy, e.g. for counters() with DequeStatistics.
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+const Statistics&
+Deque<T, Allocator, Storage, Statistics>::statistics() const
+{
+    return *this;
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+Statistics&
+Deque<T, Allocator, Storage, Statistics>::statistics()
+{
+    return *this;
 }
 
-template <typename T>
-typename Deque<T>::const_iterator 
-Deque<T>::begin() const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::iterator
+Deque<T, Allocator, Storage, Statistics>::begin()
 {
-    return const_iterator(this, (!front_.empty()) ? &front_.back() : &back_.front());
+    return iterator(this, 0);
 }
 
-template <typename T>
-typename Deque<T>::const_iterator 
-Deque<T>::end() const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::iterator
+Deque<T, Allocator, Storage, Statistics>::end()
 {
-    return const_iterator(this, (!back_.empty()) ? &back_.back() : &front_.front());
+    return iterator(this, size());
 }
 
-template <typename T>
-typename Deque<T>::reverse_iterator
-Deque<T>::rbegin()
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_iterator
+Deque<T, Allocator, Storage, Statistics>::begin() const
 {
-    return reverse_iterator(this, (!back_.empty()) ? &back_.back() : &front_.front());
+    return const_iterator(this, 0);
 }
 
-template <typename T>
-typename Deque<T>::reverse_iterator
-Deque<T>::rend()
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_iterator
+Deque<T, Allocator, Storage, Statistics>::end() const
 {
-    return reverse_iterator(this, (!front_.empty()) ? &front_.back() : &back_.front());
+    return const_iterator(this, size());
 }
 
-template <typename T>
-typename Deque<T>::const_reverse_iterator
-Deque<T>::rbegin() const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::reverse_iterator
+Deque<T, Allocator, Storage, Statistics>::rbegin()
 {
-    return const_reverse_iterator(this, (!back_.empty()) ? &back_.back() : &front_.front());
+    return reverse_iterator(this, size());
 }
 
-template <typename T>
-typename Deque<T>::const_reverse_iterator
-Deque<T>::rend() const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::reverse_iterator
+Deque<T, Allocator, Storage, Statistics>::rend()
 {
-    return const_reverse_iterator(this, (!front_.empty()) ? &front_.back() : &back_.front());
+    return reverse_iterator(this, 0);
 }
 
-template <typename T>
-typename Deque<T>::reference
-Deque<T>::at_index(const size_type index)
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator
+Deque<T, Allocator, Storage, Statistics>::rbegin() const
+{
+    return const_reverse_iterator(this, size());
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator
+Deque<T, Allocator, Storage, Statistics>::rend() const
+{
+    return const_reverse_iterator(this, 0);
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::reference
+Deque<T, Allocator, Storage, Statistics>::at_index(const size_type index)
 {
     return (*this)[index];
 }
 
-template <typename T>
-typename Deque<T>::const_reference
-Deque<T>::at_index(const size_type index) const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_reference
+Deque<T, Allocator, Storage, Statistics>::at_index(const size_type index) const
 {
     return (*this)[index];
 }
 
+/// Moves the older half of back_ into front_ (reversed) when front_ runs dry,
+/// so a sequence of pop_front calls costs amortized O(1) instead of O(n) each.
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+void
+Deque<T, Allocator, Storage, Statistics>::rebalance_front()
+{
+    assert(front_.empty());
+    const size_type half = (back_.size() + 1) / 2;
+    Statistics::record_rebalance(back_.size(), sizeof(T));
+    typedef std::reverse_iterator<typename Storage::iterator> reversed;
+    front_.assign(std::make_move_iterator(reversed(back_.begin() + half)),
+                  std::make_move_iterator(reversed(back_.begin())));
+    back_.erase(back_.begin(), back_.begin() + half);
+}
+
+/// Mirror of rebalance_front: moves the newer half of front_ into back_.
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+void
+Deque<T, Allocator, Storage, Statistics>::rebalance_back()
+{
+    assert(back_.empty());
+    const size_type half = (front_.size() + 1) / 2;
+    Statistics::record_rebalance(front_.size(), sizeof(T));
+    typedef std::reverse_iterator<typename Storage::iterator> reversed;
+    back_.assign(std::make_move_iterator(reversed(front_.begin() + half)),
+                 std::make_move_iterator(reversed(front_.begin())));
+    front_.erase(front_.begin(), front_.begin() + half);
+}
+
+/// Returns the first index below count where the deques differ, or count.
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::size_type
+Deque<T, Allocator, Storage, Statistics>::first_mismatch(const Deque<T, Allocator, Storage, Statistics>& rhv, const size_type count, std::true_type) const
+{
+    run_cursor lhs(*this);
+    run_cursor other(rhv);
+    T reversed[COMPARE_CHUNK];
+    size_type index = 0;
+    while (index < count) {
+        size_type chunk = count - index;
+        if (COMPARE_CHUNK < chunk)     chunk = COMPARE_CHUNK;
+        if (lhs.available() < chunk)   chunk = lhs.available();
+        if (other.available() < chunk) chunk = other.available();
+        const_pointer left = lhs.chunk(chunk);
+        const_pointer right = other.chunk(chunk);
+        if (lhs.reversed() != other.reversed()) {
+            /// Bring the reversed side into the other's order so memcmp applies.
+            const_pointer& flipped = lhs.reversed() ? left : right;
+            for (size_type i = 0; i < chunk; ++i) {
+                reversed[i] = flipped[chunk - 1 - i];
+            }
+            flipped = reversed;
+        }
+        if (0 != std::memcmp(left, right, chunk * sizeof(T))) {
+            for (size_type i = 0; i < chunk; ++i) {
+                if (!(lhs.at(i) == other.at(i))) return index + i;
+            }
+        }
+        lhs.advance(chunk);
+        other.advance(chunk);
+        index += chunk;
+    }
+    return count;
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::size_type
+Deque<T, Allocator, Storage, Statistics>::first_mismatch(const Deque<T, Allocator, Storage, Statistics>& rhv, const size_type count, std::false_type) const
+{
+    run_cursor lhs(*this);
+    run_cursor other(rhv);
+    size_type index = 0;
+    while (index < count) {
+        size_type chunk = count - index;
+        if (lhs.available() < chunk)   chunk = lhs.available();
+        if (other.available() < chunk) chunk = other.available();
+        for (size_type i = 0; i < chunk; ++i) {
+            if (!(lhs.at(i) == other.at(i))) return index + i;
+        }
+        lhs.advance(chunk);
+        other.advance(chunk);
+        index += chunk;
+    }
+    return count;
+}
+
+/// front_ holds the lowest logical indices at its end, so its runs are
+/// visited last to first.
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+template <typename Half, typename Function>
+void
+Deque<T, Allocator, Storage, Statistics>::visit_front_runs(Half& half, Function& function)
+{
+    for (size_type run = run_count(half, 0); run > 0; --run) {
+        function(run_data(half, run - 1, 0), run_size(half, run - 1, 0), true);
+    }
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+template <typename Half, typename Function>
+void
+Deque<T, Allocator, Storage, Statistics>::visit_back_runs(Half& half, Function& function)
+{
+    const size_type runs = run_count(half, 0);
+    for (size_type run = 0; run < runs; ++run) {
+        function(run_data(half, run, 0), run_size(half, run, 0), false);
+    }
+}
+
+/// Segmented storage (e.g. BlockVector) reports its runs through
+/// segment_count(), segment_data() and segment_size(); any other storage
+/// is taken to be one contiguous buffer reached through data().
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+template <typename Half>
+auto
+Deque<T, Allocator, Storage, Statistics>::run_count(Half& half, int) -> decltype(half.segment_count())
+{
+    return half.segment_count();
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+template <typename Half>
+typename Deque<T, Allocator, Storage, Statistics>::size_type
+Deque<T, Allocator, Storage, Statistics>::run_count(Half& half, long)
+{
+    return half.empty() ? 0 : 1;
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+template <typename Half>
+auto
+Deque<T, Allocator, Storage, Statistics>::run_data(Half& half, const size_type run, int) -> decltype(half.segment_data(run))
+{
+    return half.segment_data(run);
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+template <typename Half>
+auto
+Deque<T, Allocator, Storage, Statistics>::run_data(Half& half, const size_type /*run*/, long) -> decltype(half.data())
+{
+    return half.data();
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+template <typename Half>
+auto
+Deque<T, Allocator, Storage, Statistics>::run_size(Half& half, const size_type run, int) -> decltype(half.segment_size(run))
+{
+    return half.segment_size(run);
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+template <typename Half>
+typename Deque<T, Allocator, Storage, Statistics>::size_type
+Deque<T, Allocator, Storage, Statistics>::run_size(Half& half, const size_type /*run*/, long)
+{
+    return half.size();
+}
+
+///==================================GROWTH_PROBE======================
+
+/// Address of the buffer of contiguous storage, to tell a reallocation
+/// from growth that kept the elements in place.
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+template <typename Half>
+auto
+Deque<T, Allocator, Storage, Statistics>::storage_address(const Half& half, int) -> decltype(static_cast<const void*>(half.data()))
+{
+    return half.data();
+}
+
+/// Segmented storage grows by adding blocks and never moves elements.
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+template <typename Half>
+const void*
+Deque<T, Allocator, Storage, Statistics>::storage_address(const Half& /*half*/, long)
+{
+    return NULL;
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+Deque<T, Allocator, Storage, Statistics>::growth_probe::growth_probe(Deque& deque, const Storage& half)
+    : deque_(deque)
+    , half_(half)
+    , capacity_(0)
+    , size_(0)
+    , address_(NULL)
+{
+    if (Statistics::enabled) {
+        capacity_ = half.capacity();
+        size_ = half.size();
+        address_ = storage_address(half, 0);
+    }
+}
+
+/// A reallocation moved the old elements only if the buffer moved.
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+Deque<T, Allocator, Storage, Statistics>::growth_probe::~growth_probe()
+{
+    if (!Statistics::enabled) return;
+    if (half_.capacity() != capacity_) {
+        const bool moved = address_ != NULL && address_ != storage_address(half_, 0);
+        deque_.Statistics::record_reallocation(moved ? size_ : 0, sizeof(T));
+    }
+    deque_.Statistics::record_size(deque_.size());
+}
+
+///==================================RUN_CURSOR======================
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+Deque<T, Allocator, Storage, Statistics>::run_cursor::run_cursor(const Deque<T, Allocator, Storage, Statistics>& deque)
+    : deque_(&deque)
+    , inFront_(true)
+    , run_(run_count(deque.front_, 0))
+    , data_(NULL)
+    , size_(0)
+    , offset_(0)
+{
+    load();
+}
+
+/// The element at the cursor; in a reversed run later elements lie below it.
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_pointer
+Deque<T, Allocator, Storage, Statistics>::run_cursor::current() const
+{
+    return inFront_ ? data_ + (size_ - 1 - offset_) : data_ + offset_;
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::size_type
+Deque<T, Allocator, Storage, Statistics>::run_cursor::available() const
+{
+    return size_ - offset_;
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+bool
+Deque<T, Allocator, Storage, Statistics>::run_cursor::reversed() const
+{
+    return inFront_;
+}
+
+/// Lowest address of the next count elements, which are contiguous.
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_pointer
+Deque<T, Allocator, Storage, Statistics>::run_cursor::chunk(const size_type count) const
+{
+    assert(count <= available());
+    return inFront_ ? current() - (count - 1) : current();
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_reference
+Deque<T, Allocator, Storage, Statistics>::run_cursor::at(const size_type offset) const
+{
+    return inFront_ ? *(current() - offset) : current()[offset];
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+void
+Deque<T, Allocator, Storage, Statistics>::run_cursor::advance(const size_type count)
+{
+    assert(count <= available());
+    offset_ += count;
+    if (offset_ == size_) {
+        load();
+    }
+}
+
+/// Steps to the next run: down through the runs of front_, then up through
+/// those of back_.
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+void
+Deque<T, Allocator, Storage, Statistics>::run_cursor::load()
+{
+    offset_ = 0;
+    size_ = 0;
+    if (inFront_) {
+        if (run_ > 0) {
+            --run_;
+            data_ = run_data(deque_->front_, run_, 0);
+            size_ = run_size(deque_->front_, run_, 0);
+            return;
+        }
+        inFront_ = false;
+        run_ = 0;
+    }
+    if (run_ < run_count(deque_->back_, 0)) {
+        data_ = run_data(deque_->back_, run_, 0);
+        size_ = run_size(deque_->back_, run_, 0);
+        ++run_;
+    }
+}
+
 ///==================================CONST_ITERATOR======================
 
-template <typename T>
-Deque<T>::const_iterator::const_iterator()
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+Deque<T, Allocator, Storage, Statistics>::const_iterator::const_iterator()
     : deque_(NULL)
-    , ptr_(NULL)
+    , index_(0)
 {}
 
-template <typename T>
-Deque<T>::const_iterator::const_iterator(const const_iterator& rhv)
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+Deque<T, Allocator, Storage, Statistics>::const_iterator::const_iterator(const const_iterator& rhv)
     : deque_(rhv.deque_)
-    , ptr_(rhv.ptr_)
+    , index_(rhv.index_)
 {}
 
-template <typename T>
-Deque<T>::const_iterator::~const_iterator()
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+Deque<T, Allocator, Storage, Statistics>::const_iterator::~const_iterator()
 {
     deque_ = NULL;
-    ptr_   = NULL;
 }
 
-template <typename T>
-Deque<T>::const_iterator::const_iterator(const Deque<T>* deque, const_pointer ptr)
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+Deque<T, Allocator, Storage, Statistics>::const_iterator::const_iterator(const Deque<T, Allocator, Storage, Statistics>* deque, const size_type index)
     : deque_(deque)
-    , ptr_(ptr)
+    , index_(index)
 {}
 
-template <typename T>
-typename Deque<T>::const_iterator&
-Deque<T>::const_iterator::operator=(const const_iterator& rhv)
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_iterator&
+Deque<T, Allocator, Storage, Statistics>::const_iterator::operator=(const const_iterator& rhv)
 {
     if (this == &rhv) return *this;
     deque_ = rhv.deque_;
-    ptr_ = rhv.ptr_;
+    index_ = rhv.index_;
     return *this;
 }
 
-template <typename T>
-typename Deque<T>::const_reference
-Deque<T>::const_iterator::operator*() const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_reference
+Deque<T, Allocator, Storage, Statistics>::const_iterator::operator*() const
 {
-     return const_cast<reference>(*(this->getPtr())); 
+    return deque_->at_index(index_);
 }
 
-template <typename T>
-typename Deque<T>::const_pointer
-Deque<T>::const_iterator::operator->() const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_pointer
+Deque<T, Allocator, Storage, Statistics>::const_iterator::operator->() const
 {
-    return const_cast<pointer>(this->getPtr());
+    return &deque_->at_index(index_);
 }
 
-template <typename T>
-typename Deque<T>::const_reference
-Deque<T>::const_iterator::operator[](const size_type index) const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_reference
+Deque<T, Allocator, Storage, Statistics>::const_iterator::operator[](const difference_type index) const
 {
-    if (index < &deque_->front_.size()) {
-        return &deque_->front_[&deque_->size() - index - 1];
-    }
-    return &deque_->back_[index - &deque_->front_.size()];
+    return deque_->at_index(index_ + index);
 }
 
-template <typename T>
-typename Deque<T>::const_iterator&
-Deque<T>::const_iterator::operator++()
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_iterator&
+Deque<T, Allocator, Storage, Statistics>::const_iterator::operator++()
 {
-    if (ptr_ == &deque_->back_.back()) return *this;
-
-    if (ptr_ == (&deque_->front_.front())) {
-        ptr_ = &deque_->back_.front();
-        return *this;
-    }
-    if (ptr_ > &deque_->front_.front() && ptr_ < &deque_->front_.back() + 1) {
-        --ptr_;
-        return *this;
-    }
-    ++ptr_;
+    ++index_;
     return *this;
 }
 
-template <typename T>
-typename Deque<T>::const_iterator
-Deque<T>::const_iterator::operator++(int)
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_iterator
+Deque<T, Allocator, Storage, Statistics>::const_iterator::operator++(int)
 {
     const_iterator temp(*this);
     ++(*this);
     return temp;
 }
 
-template <typename T>
-typename Deque<T>::const_iterator&
-Deque<T>::const_iterator::operator--()
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_iterator&
+Deque<T, Allocator, Storage, Statistics>::const_iterator::operator--()
 {
-    if (ptr_ == &deque_->front_.back()) return *this;
- 
-    if (ptr_ == (&deque_->back_.front())) {
-        ptr_ = &deque_->front_.front();
-        return *this;
-    }
-
-    if (ptr_ > &deque_->front_.front() && ptr_ < &deque_->front_.back() + 1) {
-        ++ptr_;
-        return *this;
-    }
-    --ptr_;
+    --index_;
     return *this;
 }
 
-template <typename T>
-typename Deque<T>::const_iterator
-Deque<T>::const_iterator::operator--(int)
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_iterator
+Deque<T, Allocator, Storage, Statistics>::const_iterator::operator--(int)
 {
     const_iterator temp(*this);
     --(*this);
     return temp;
 }
 
-template <typename T>
-typename Deque<T>::const_iterator
-Deque<T>::const_iterator::operator+(const size_type index) const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_iterator
+Deque<T, Allocator, Storage, Statistics>::const_iterator::operator+(const difference_type size) const
 {
-    if (ptr_ == &deque_->back_.back()) return const_iterator(ptr_);
-
-    pointer newPtr = ptr_ - index;
-    if (newPtr > &deque_->front_.front() && newPtr < &deque_->front_.back() + 1) {
-        return const_iterator(newPtr);
-    }
-
-    if (ptr_ > &deque_->front_.front() && ptr_ < &deque_->front_.back() + 1 && newPtr > &deque_->front_.back() + 1) {
-        return const_iterator(&deque_->back_.front() + (index - (&deque_->front_.back() - 1 - ptr_)));  
-    }
-    return const_iterator(&deque_->back_.front() + index);
+    return const_iterator(deque_, index_ + size);
 }
 
-template <typename T>
-typename Deque<T>::const_iterator
-Deque<T>::const_iterator::operator-(const size_type index) const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_iterator
+Deque<T, Allocator, Storage, Statistics>::const_iterator::operator-(const difference_type size) const
 {
-    if (ptr_ == &deque_->front_.back()) return *this;
-
-    pointer newPtr = ptr_ + index;
-    if (newPtr > &deque_->back_.front() && newPtr < &deque_->back_.back() + 1) {
-        return const_iterator(newPtr);
-    }
-
-    if (ptr_ > &deque_->back_.front() && ptr_ < &deque_->back_.back() + 1 && newPtr < &deque_->back_.front()) {
-        return const_iterator(&deque_->front_.back() + 1 - (index - (ptr_ - &deque_->back_.front())));  
-    }
-    return const_iterator(&deque_->front_.back() + 1 - index);
-
+    return const_iterator(deque_, index_ - size);
 }
 
-template <typename T>
-typename Deque<T>::const_iterator&
-Deque<T>::const_iterator::operator+=(const size_type size)
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_iterator&
+Deque<T, Allocator, Storage, Statistics>::const_iterator::operator+=(const difference_type size)
 {
-    ptr_ = ptr_ + size;
+    index_ += size;
     return *this;
 }
 
-template <typename T>
-typename Deque<T>::const_iterator&
-Deque<T>::const_iterator::operator-=(const size_type size)
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_iterator&
+Deque<T, Allocator, Storage, Statistics>::const_iterator::operator-=(const difference_type size)
 {
-    ptr_ = ptr_ - size;
+    index_ -= size;
     return *this;
 }
 
-template <typename T>
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::difference_type
+Deque<T, Allocator, Storage, Statistics>::const_iterator::operator-(const const_iterator& rhv) const
+{
+    return static_cast<difference_type>(index_) - static_cast<difference_type>(rhv.index_);
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
 bool
-Deque<T>::const_iterator::operator==(const const_iterator& rhv) const
+Deque<T, Allocator, Storage, Statistics>::const_iterator::operator==(const const_iterator& rhv) const
 {
-    return ptr_ == rhv.ptr_ && deque_ == rhv.deque_;
+    return index_ == rhv.index_ && deque_ == rhv.deque_;
 }
 
-template <typename T>
+template <typename T, typename Allocator, typename Storage, typename Statistics>
 bool
-Deque<T>::const_iterator::operator!=(const const_iterator& rhv) const
+Deque<T, Allocator, Storage, Statistics>::const_iterator::operator!=(const const_iterator& rhv) const
 {
     return !(*this == rhv);
 }
 
-template <typename T>
+template <typename T, typename Allocator, typename Storage, typename Statistics>
 bool
-Deque<T>::const_iterator::operator<(const const_iterator& rhv) const
+Deque<T, Allocator, Storage, Statistics>::const_iterator::operator<(const const_iterator& rhv) const
 {
-    return ptr_ < rhv.ptr_;
+    return index_ < rhv.index_;
 }
 
-template <typename T>
+template <typename T, typename Allocator, typename Storage, typename Statistics>
 bool
-Deque<T>::const_iterator::operator>(const const_iterator& rhv) const
+Deque<T, Allocator, Storage, Statistics>::const_iterator::operator>(const const_iterator& rhv) const
 {
     return rhv < *this;
 }
 
-template <typename T>
+template <typename T, typename Allocator, typename Storage, typename Statistics>
 bool
-Deque<T>::const_iterator::operator<=(const const_iterator& rhv) const 
+Deque<T, Allocator, Storage, Statistics>::const_iterator::operator<=(const const_iterator& rhv) const
 {
     return !(*this > rhv);
 }
 
-template <typename T>
+template <typename T, typename Allocator, typename Storage, typename Statistics>
 bool
-Deque<T>::const_iterator::operator>=(const const_iterator& rhv) const
-{ 
+Deque<T, Allocator, Storage, Statistics>::const_iterator::operator>=(const const_iterator& rhv) const
+{
     return !(*this < rhv);
 }
 
-template <typename T>
-const Deque<T>*
-Deque<T>::const_iterator::getDeque() const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+const Deque<T, Allocator, Storage, Statistics>*
+Deque<T, Allocator, Storage, Statistics>::const_iterator::getDeque() const
 {
     return deque_;
 }
 
-template <typename T>
-typename Deque<T>::const_pointer
-Deque<T>::const_iterator::getPtr() const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::size_type
+Deque<T, Allocator, Storage, Statistics>::const_iterator::getIndex() const
 {
-    return ptr_;
+    return index_;
 }
 
 ///====================================================ITERATOR==============================================
 
-template <typename T>
-Deque<T>::iterator::iterator()
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+Deque<T, Allocator, Storage, Statistics>::iterator::iterator()
     : const_iterator()
 {}
 
-template <typename T>
-Deque<T>::iterator::iterator(const iterator& rhv)
-    : const_iterator(rhv.getDeque(), rhv.getPtr())
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+Deque<T, Allocator, Storage, Statistics>::iterator::iterator(const iterator& rhv)
+    : const_iterator(rhv.getDeque(), rhv.getIndex())
 {}
 
-template <typename T>
-Deque<T>::iterator::~iterator()
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+Deque<T, Allocator, Storage, Statistics>::iterator::~iterator()
 {}
 
-template <typename T>
-Deque<T>::iterator::iterator(const Deque<T>* deque, pointer ptr)
-    : const_iterator(deque, ptr)
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+Deque<T, Allocator, Storage, Statistics>::iterator::iterator(const Deque<T, Allocator, Storage, Statistics>* deque, const size_type index)
+    : const_iterator(deque, index)
 {}
 
-template <typename T>
-typename Deque<T>::reference
-Deque<T>::iterator::operator*() const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::iterator&
+Deque<T, Allocator, Storage, Statistics>::iterator::operator=(const iterator& rhv)
 {
-    return const_cast<reference>(*this->getPtr());
+    const_iterator::operator=(rhv);
+    return *this;
 }
 
-template <typename T>
-typename Deque<T>::pointer
-Deque<T>::iterator::operator->() const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::reference
+Deque<T, Allocator, Storage, Statistics>::iterator::operator*() const
 {
-    return const_cast<pointer>(this->getPtr());
+    return const_cast<reference>(const_iterator::operator*());
 }
 
-template <typename T>
-typename Deque<T>::reference
-Deque<T>::iterator::operator[](const size_type index) const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::pointer
+Deque<T, Allocator, Storage, Statistics>::iterator::operator->() const
 {
-    if (index < this->deque_->front_.size()) {
-        return const_cast<reference>(this->deque_->front_[this->deque_->size() - index - 1]);
-    }
-    return const_cast<reference>(this->deque_->back_[index - this->deque_->front_.size()]);
+    return const_cast<pointer>(const_iterator::operator->());
+}
 
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::reference
+Deque<T, Allocator, Storage, Statistics>::iterator::operator[](const difference_type index) const
+{
+    return const_cast<reference>(const_iterator::operator[](index));
 }
 
-template <typename T>
-typename Deque<T>::iterator
-Deque<T>::iterator::operator+(const size_type size) const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::iterator&
+Deque<T, Allocator, Storage, Statistics>::iterator::operator++()
 {
-    if (this->ptr_ == &this->deque_->back_.back()) return iterator(this->getDeque(), const_cast<pointer>(this->getPtr()));
+    const_iterator::operator++();
+    return *this;
+}
 
-    pointer newPtr = const_cast<pointer>(this->ptr_ - size);
-    if (newPtr > &this->deque_->front_.front() && newPtr < &this->deque_->front_.back() + 1) {
-        return iterator(this->getDeque(), const_cast<pointer>(newPtr)) ;
-    }
-    const_pointer first = &this->deque_->front_.front();
-    const_pointer first_back = &this->deque_->front_.back();
-    if (this->ptr_ > first && this->ptr_ < first_back && newPtr > first_back + 1) {
-        return iterator(this->getDeque(), const_cast<pointer>(&this->deque_->back_.front() + (size - (&this->deque_->front_.back() + 1 - this->ptr_))));  
-    }
-    return iterator(this->getDeque(), const_cast<pointer>(&this->deque_->back_.front() + size));
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::iterator
+Deque<T, Allocator, Storage, Statistics>::iterator::operator++(int)
+{
+    iterator temp(*this);
+    const_iterator::operator++();
+    return temp;
+}
 
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::iterator&
+Deque<T, Allocator, Storage, Statistics>::iterator::operator--()
+{
+    const_iterator::operator--();
+    return *this;
 }
 
-template <typename T>
-typename Deque<T>::iterator
-Deque<T>::iterator::operator-(const size_type size) const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::iterator
+Deque<T, Allocator, Storage, Statistics>::iterator::operator--(int)
 {
-    if (this->ptr_ == &this->deque_->front_.back()) return *this;
+    iterator temp(*this);
+    const_iterator::operator--();
+    return temp;
+}
 
-    pointer newPtr = const_cast<pointer>(this->ptr_ + size);
-    if (newPtr > &this->deque_->back_.front() && newPtr < &this->deque_->back_.back()) {
-        return iterator(this->getDeque(), const_cast<pointer>(newPtr));
-    }
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::iterator
+Deque<T, Allocator, Storage, Statistics>::iterator::operator+(const difference_type size) const
+{
+    return iterator(this->getDeque(), this->getIndex() + size);
+}
 
-    if (this->ptr_ > &this->deque_->back_.front() && this->ptr_ < &this->deque_->back_.back() + 1 && newPtr < &this->deque_->back_.front()) {
-        return iterator(this->getDeque(), const_cast<pointer>(&this->deque_->front_.back() + 1 - (size - (this->ptr_ - &this->deque_->back_.front()))));  
-    }
-    return iterator(this->getDeque(), const_cast<pointer>(&this->deque_->front_.back() + 1 - size));
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::iterator
+Deque<T, Allocator, Storage, Statistics>::iterator::operator-(const difference_type size) const
+{
+    return iterator(this->getDeque(), this->getIndex() - size);
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::iterator&
+Deque<T, Allocator, Storage, Statistics>::iterator::operator+=(const difference_type size)
+{
+    const_iterator::operator+=(size);
+    return *this;
+}
 
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::iterator&
+Deque<T, Allocator, Storage, Statistics>::iterator::operator-=(const difference_type size)
+{
+    const_iterator::operator-=(size);
+    return *this;
 }
 
 ///==================================CONST_REVERSE_ITERATOR======================
 
-template <typename T>
-Deque<T>::const_reverse_iterator::const_reverse_iterator()
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator::const_reverse_iterator()
     : deque_(NULL)
-    , ptr_(NULL)
+    , index_(0)
 {}
 
-template <typename T>
-Deque<T>::const_reverse_iterator::const_reverse_iterator(const const_reverse_iterator& rhv)
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator::const_reverse_iterator(const const_reverse_iterator& rhv)
     : deque_(rhv.deque_)
-    , ptr_(rhv.ptr_)
+    , index_(rhv.index_)
 {}
 
-template <typename T>
-Deque<T>::const_reverse_iterator::~const_reverse_iterator()
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator::~const_reverse_iterator()
 {
     deque_ = NULL;
-    ptr_   = NULL;
 }
 
-template <typename T>
-Deque<T>::const_reverse_iterator::const_reverse_iterator(const Deque<T>* deque, const_pointer ptr)
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator::const_reverse_iterator(const Deque<T, Allocator, Storage, Statistics>* deque, const size_type index)
     : deque_(deque)
-    , ptr_(ptr)
+    , index_(index)
 {}
 
-template <typename T>
-typename Deque<T>::const_reverse_iterator&
-Deque<T>::const_reverse_iterator::operator=(const const_reverse_iterator& rhv)
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator&
+Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator::operator=(const const_reverse_iterator& rhv)
 {
     if (this == &rhv) return *this;
     deque_ = rhv.deque_;
-    ptr_ = rhv.ptr_;
+    index_ = rhv.index_;
     return *this;
 }
 
-template <typename T>
-typename Deque<T>::const_reference
-Deque<T>::const_reverse_iterator::operator*() const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_reference
+Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator::operator*() const
 {
-     return const_cast<reference>(*(this->getPtr())); 
+    return deque_->at_index(index_ - 1);
 }
 
-template <typename T>
-typename Deque<T>::const_pointer
-Deque<T>::const_reverse_iterator::operator->() const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_pointer
+Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator::operator->() const
 {
-    return const_cast<pointer>(this->getPtr());
+    return &deque_->at_index(index_ - 1);
 }
 
-template <typename T>
-typename Deque<T>::const_reference
-Deque<T>::const_reverse_iterator::operator[](const size_type index) const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_reference
+Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator::operator[](const difference_type index) const
 {
-    if (index < &deque_->front_.size()) {
-        return &deque_->front_[&deque_->size() - index - 1];
-    }
-    return &deque_->back_[index - &deque_->front_.size()];
+    return deque_->at_index(index_ - index - 1);
 }
 
-template <typename T>
-typename Deque<T>::const_reverse_iterator&
-Deque<T>::const_reverse_iterator::operator++()
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator&
+Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator::operator++()
 {
-    if (ptr_ == &deque_->front_.back()) return *this;
- 
-    if (ptr_ == (&deque_->back_.front())) {
-        ptr_ = &deque_->front_.front();
-        return *this;
-    }
-
-    if (ptr_ > &deque_->front_.front() && ptr_ < &deque_->front_.back() + 1) {
-        ++ptr_;
-        return *this;
-    }
-    --ptr_;
+    --index_;
     return *this;
-
 }
 
-template <typename T>
-typename Deque<T>::const_reverse_iterator
-Deque<T>::const_reverse_iterator::operator++(int)
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator
+Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator::operator++(int)
 {
     const_reverse_iterator temp(*this);
     ++(*this);
     return temp;
 }
 
-template <typename T>
-typename Deque<T>::const_reverse_iterator&
-Deque<T>::const_reverse_iterator::operator--()
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator&
+Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator::operator--()
 {
-    if (ptr_ == &deque_->back_.back()) return *this;
-
-    if (ptr_ == (&deque_->front_.front())) {
-        ptr_ = &deque_->back_.front();
-        return *this;
-    }
-    if (ptr_ > &deque_->front_.front() && ptr_ < &deque_->front_.back() + 1) {
-        --ptr_;
-        return *this;
-    }
-    ++ptr_;
+    ++index_;
     return *this;
-
 }
 
-template <typename T>
-typename Deque<T>::const_reverse_iterator
-Deque<T>::const_reverse_iterator::operator--(int)
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator
+Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator::operator--(int)
 {
     const_reverse_iterator temp(*this);
     --(*this);
     return temp;
 }
 
-template <typename T>
-typename Deque<T>::const_reverse_iterator
-Deque<T>::const_reverse_iterator::operator+(const size_type index) const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator
+Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator::operator+(const difference_type size) const
 {
-    if (ptr_ == &deque_->front_.back()) return *this;
-
-    pointer newPtr = ptr_ + index;
-    if (newPtr > &deque_->back_.front() && newPtr < &deque_->back_.back() + 1) {
-        return const_reverse_iterator(newPtr);
-    }
-
-    if (ptr_ > &deque_->back_.front() && ptr_ < &deque_->back_.back() + 1 && newPtr < &deque_->back_.front()) {
-        return const_reverse_iterator(&deque_->front_.back() + 1 - (index - (ptr_ - &deque_->back_.front())));  
-    }
-    return const_reverse_iterator(&deque_->front_.back() + 1 - index);
-
+    return const_reverse_iterator(deque_, index_ - size);
 }
 
-template <typename T>
-typename Deque<T>::const_reverse_iterator
-Deque<T>::const_reverse_iterator::operator-(const size_type index) const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator
+Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator::operator-(const difference_type size) const
 {
-    if (ptr_ == &deque_->back_.back()) return const_reverse_iterator(ptr_);
-
-    pointer newPtr = ptr_ - index;
-    if (newPtr > &deque_->front_.front() && newPtr < &deque_->front_.back() + 1) {
-        return const_reverse_iterator(newPtr);
-    }
-
-    if (ptr_ > &deque_->front_.front() && ptr_ < &deque_->front_.back() + 1 && newPtr > &deque_->front_.back() + 1) {
-        return const_reverse_iterator(&deque_->back_.front() + (index - (&deque_->front_.back() - 1 - ptr_)));  
-    }
-    return const_reverse_iterator(&deque_->back_.front() + index);
-
+    return const_reverse_iterator(deque_, index_ + size);
 }
 
-template <typename T>
-typename Deque<T>::const_reverse_iterator&
-Deque<T>::const_reverse_iterator::operator+=(const size_type size)
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator&
+Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator::operator+=(const difference_type size)
 {
-    ptr_ = ptr_ - size;
+    index_ -= size;
     return *this;
 }
 
-template <typename T>
-typename Deque<T>::const_reverse_iterator&
-Deque<T>::const_reverse_iterator::operator-=(const size_type size)
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator&
+Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator::operator-=(const difference_type size)
 {
-    ptr_ = ptr_ + size;
+    index_ += size;
     return *this;
 }
 
-template <typename T>
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::difference_type
+Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator::operator-(const const_reverse_iterator& rhv) const
+{
+    return static_cast<difference_type>(rhv.index_) - static_cast<difference_type>(index_);
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
 bool
-Deque<T>::const_reverse_iterator::operator==(const const_reverse_iterator& rhv) const
+Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator::operator==(const const_reverse_iterator& rhv) const
 {
-    return ptr_ == rhv.ptr_ && deque_ == rhv.deque_;
+    return index_ == rhv.index_ && deque_ == rhv.deque_;
 }
 
-template <typename T>
+template <typename T, typename Allocator, typename Storage, typename Statistics>
 bool
-Deque<T>::const_reverse_iterator::operator!=(const const_reverse_iterator& rhv) const
+Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator::operator!=(const const_reverse_iterator& rhv) const
 {
     return !(*this == rhv);
 }
 
-template <typename T>
+template <typename T, typename Allocator, typename Storage, typename Statistics>
 bool
-Deque<T>::const_reverse_iterator::operator<(const const_reverse_iterator& rhv) const
+Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator::operator<(const const_reverse_iterator& rhv) const
 {
-    return ptr_ < rhv.ptr_;
+    return rhv.index_ < index_;
 }
 
-template <typename T>
+template <typename T, typename Allocator, typename Storage, typename Statistics>
 bool
-Deque<T>::const_reverse_iterator::operator>(const const_reverse_iterator& rhv) const
+Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator::operator>(const const_reverse_iterator& rhv) const
 {
     return rhv < *this;
 }
 
-template <typename T>
+template <typename T, typename Allocator, typename Storage, typename Statistics>
 bool
-Deque<T>::const_reverse_iterator::operator<=(const const_reverse_iterator& rhv) const 
+Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator::operator<=(const const_reverse_iterator& rhv) const
 {
     return !(*this > rhv);
 }
 
-template <typename T>
+template <typename T, typename Allocator, typename Storage, typename Statistics>
 bool
-Deque<T>::const_reverse_iterator::operator>=(const const_reverse_iterator& rhv) const
-{ 
+Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator::operator>=(const const_reverse_iterator& rhv) const
+{
     return !(*this < rhv);
 }
 
-template <typename T>
-const Deque<T>*
-Deque<T>::const_reverse_iterator::getDeque() const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+const Deque<T, Allocator, Storage, Statistics>*
+Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator::getDeque() const
 {
     return deque_;
 }
 
-template <typename T>
-typename Deque<T>::const_pointer
-Deque<T>::const_reverse_iterator::getPtr() const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::size_type
+Deque<T, Allocator, Storage, Statistics>::const_reverse_iterator::getIndex() const
 {
-    return ptr_;
+    return index_;
 }
 
 ///====================================================reverse_iterator==============================================
 
-template <typename T>
-Deque<T>::reverse_iterator::reverse_iterator()
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+Deque<T, Allocator, Storage, Statistics>::reverse_iterator::reverse_iterator()
     : const_reverse_iterator()
 {}
 
-template <typename T>
-Deque<T>::reverse_iterator::reverse_iterator(const reverse_iterator& rhv)
-    : const_reverse_iterator(rhv.getDeque(), rhv.getPtr())
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+Deque<T, Allocator, Storage, Statistics>::reverse_iterator::reverse_iterator(const reverse_iterator& rhv)
+    : const_reverse_iterator(rhv.getDeque(), rhv.getIndex())
 {}
 
-template <typename T>
-Deque<T>::reverse_iterator::~reverse_iterator()
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+Deque<T, Allocator, Storage, Statistics>::reverse_iterator::~reverse_iterator()
 {}
 
-template <typename T>
-Deque<T>::reverse_iterator::reverse_iterator(const Deque<T>* deque, pointer ptr)
-    : const_reverse_iterator(deque, ptr)
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+Deque<T, Allocator, Storage, Statistics>::reverse_iterator::reverse_iterator(const Deque<T, Allocator, Storage, Statistics>* deque, const size_type index)
+    : const_reverse_iterator(deque, index)
 {}
 
-template <typename T>
-typename Deque<T>::reference
-Deque<T>::reverse_iterator::operator*() const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::reverse_iterator&
+Deque<T, Allocator, Storage, Statistics>::reverse_iterator::operator=(const reverse_iterator& rhv)
 {
-    return const_cast<reference>(*this->getPtr());
+    const_reverse_iterator::operator=(rhv);
+    return *this;
 }
 
-template <typename T>
-typename Deque<T>::pointer
-Deque<T>::reverse_iterator::operator->() const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::reference
+Deque<T, Allocator, Storage, Statistics>::reverse_iterator::operator*() const
 {
-    return const_cast<pointer>(this->getPtr());
+    return const_cast<reference>(const_reverse_iterator::operator*());
 }
 
-template <typename T>
-typename Deque<T>::reference
-Deque<T>::reverse_iterator::operator[](const size_type index) const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::pointer
+Deque<T, Allocator, Storage, Statistics>::reverse_iterator::operator->() const
 {
-    if (index < this->deque_->front_.size()) {
-        return const_cast<reference>(this->deque_->front_[this->deque_->size() - index - 1]);
-    }
-    return const_cast<reference>(this->deque_->back_[index - this->deque_->front_.size()]);
+    return const_cast<pointer>(const_reverse_iterator::operator->());
+}
 
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::reference
+Deque<T, Allocator, Storage, Statistics>::reverse_iterator::operator[](const difference_type index) const
+{
+    return const_cast<reference>(const_reverse_iterator::operator[](index));
 }
 
-template <typename T>
-typename Deque<T>::reverse_iterator
-Deque<T>::reverse_iterator::operator+(const size_type size) const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::reverse_iterator&
+Deque<T, Allocator, Storage, Statistics>::reverse_iterator::operator++()
 {
-    if (this->ptr_ == &this->deque_->front_.back()) return *this;
+    const_reverse_iterator::operator++();
+    return *this;
+}
 
-    pointer newPtr = const_cast<pointer>(this->ptr_ + size);
-    if (newPtr > &this->deque_->back_.front() && newPtr < &this->deque_->back_.back()) {
-        return reverse_iterator(this->getDeque(), const_cast<pointer>(newPtr));
-    }
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::reverse_iterator
+Deque<T, Allocator, Storage, Statistics>::reverse_iterator::operator++(int)
+{
+    reverse_iterator temp(*this);
+    const_reverse_iterator::operator++();
+    return temp;
+}
 
-    if (this->ptr_ > &this->deque_->back_.front() && this->ptr_ < &this->deque_->back_.back() + 1 && newPtr < &this->deque_->back_.front()) {
-        return reverse_iterator(this->getDeque(), const_cast<pointer>(&this->deque_->front_.back() + 1 - (size - (this->ptr_ - &this->deque_->back_.front()))));  
-    }
-    return reverse_iterator(this->getDeque(), const_cast<pointer>(&this->deque_->front_.back() + 1 - size));
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::reverse_iterator&
+Deque<T, Allocator, Storage, Statistics>::reverse_iterator::operator--()
+{
+    const_reverse_iterator::operator--();
+    return *this;
+}
 
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::reverse_iterator
+Deque<T, Allocator, Storage, Statistics>::reverse_iterator::operator--(int)
+{
+    reverse_iterator temp(*this);
+    const_reverse_iterator::operator--();
+    return temp;
 }
 
-template <typename T>
-typename Deque<T>::reverse_iterator
-Deque<T>::reverse_iterator::operator-(const size_type size) const
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::reverse_iterator
+Deque<T, Allocator, Storage, Statistics>::reverse_iterator::operator+(const difference_type size) const
 {
-    if (this->ptr_ == &this->deque_->back_.back()) return reverse_iterator(this->getDeque(), const_cast<pointer>(this->getPtr()));
+    return reverse_iterator(this->getDeque(), this->getIndex() - size);
+}
 
-    pointer newPtr = const_cast<pointer>(this->ptr_ - size);
-    if (newPtr > &this->deque_->front_.front() && newPtr < &this->deque_->front_.back() + 1) {
-        return reverse_iterator(this->getDeque(), const_cast<pointer>(newPtr)) ;
-    }
-    const_pointer first = &this->deque_->front_.front();
-    const_pointer first_back = &this->deque_->front_.back();
-    if (this->ptr_ > first && this->ptr_ < first_back && newPtr > first_back + 1) {
-        return reverse_iterator(this->getDeque(), const_cast<pointer>(&this->deque_->back_.front() + (size - (&this->deque_->front_.back() + 1 - this->ptr_))));  
-    }
-    return reverse_iterator(this->getDeque(), const_cast<pointer>(&this->deque_->back_.front() + size));
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::reverse_iterator
+Deque<T, Allocator, Storage, Statistics>::reverse_iterator::operator-(const difference_type size) const
+{
+    return reverse_iterator(this->getDeque(), this->getIndex() + size);
+}
 
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::reverse_iterator&
+Deque<T, Allocator, Storage, Statistics>::reverse_iterator::operator+=(const difference_type size)
+{
+    const_reverse_iterator::operator+=(size);
+    return *this;
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+typename Deque<T, Allocator, Storage, Statistics>::reverse_iterator&
+Deque<T, Allocator, Storage, Statistics>::reverse_iterator::operator-=(const difference_type size)
+{
+    const_reverse_iterator::operator-=(size);
+    return *this;
 }
 
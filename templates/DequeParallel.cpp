@@ -0,0 +1,435 @@
+#include "../headers/DequeParallel.hpp"
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace deque_parallel {
+namespace detail {
+
+/// One contiguous run in logical order: first is the element with the
+/// lowest logical index and the next one is at first + step, which is -1
+/// for a front run since front_ is stored reversed.
+template <typename Pointer>
+struct run
+{
+    Pointer first;
+    std::ptrdiff_t step;
+    size_t begin; /// logical index of first
+    size_t size;
+};
+
+template <typename Pointer>
+class run_table {
+public:
+    template <typename Queue>
+    explicit run_table(Queue& queue)
+        : runs_(), size_(0)
+    {
+        queue.for_each_segment([this](Pointer data, const size_t size, const bool reversed) {
+            if (0 == size) return;
+            const run<Pointer> next = { reversed ? data + (size - 1) : data, reversed ? -1 : 1, size_, size };
+            runs_.push_back(next);
+            size_ += size;
+        });
+    }
+
+    size_t size() const { return size_; }
+    size_t runs() const { return runs_.size(); }
+
+    /// The run holding logical index; index is below size().
+    size_t find(const size_t index) const
+    {
+        size_t low = 0;
+        size_t high = runs_.size();
+        while (high - low > 1) {
+            const size_t middle = low + (high - low) / 2;
+            (runs_[middle].begin <= index ? low : high) = middle;
+        }
+        return low;
+    }
+
+    const run<Pointer>& operator[](const size_t position) const { return runs_[position]; }
+
+private:
+    std::vector<run<Pointer> > runs_;
+    size_t size_;
+};
+
+/// Walks a run_table forward in logical order from a given index,
+/// handing out the longest stretch that stays inside one run.
+template <typename Pointer>
+class cursor {
+public:
+    cursor(const run_table<Pointer>& table, const size_t index)
+        : table_(table), run_(table.find(index)), offset_(index - table[run_].begin)
+    {}
+
+    Pointer data() const { return table_[run_].first + table_[run_].step * static_cast<std::ptrdiff_t>(offset_); }
+    std::ptrdiff_t step() const { return table_[run_].step; }
+    size_t available() const { return table_[run_].size - offset_; }
+
+    void advance(const size_t count)
+    {
+        offset_ += count;
+        if (offset_ == table_[run_].size) {
+            ++run_;
+            offset_ = 0;
+        }
+    }
+
+private:
+    const run_table<Pointer>& table_;
+    size_t run_;
+    size_t offset_;
+};
+
+inline size_t
+chunk_count(const size_t size, const size_t grain)
+{
+    assert(grain > 0);
+    return (size + grain - 1) / grain;
+}
+
+template <typename Pointer, typename Function>
+void
+for_each_chunk(ThreadPool& pool, const run_table<Pointer>& table, Function& function, const size_t grain)
+{
+    const size_t size = table.size();
+    pool.run(chunk_count(size, grain), [&](const size_t chunk) {
+        const size_t begin = chunk * grain;
+        cursor<Pointer> at(table, begin);
+        for (size_t left = std::min(grain, size - begin); left > 0; ) {
+            const size_t count = std::min(left, at.available());
+            Pointer data = at.data();
+            if (1 == at.step()) {
+                for (size_t i = 0; i < count; ++i) function(data[i]);
+            } else {
+                for (size_t i = 0; i < count; ++i) function(*(data - i));
+            }
+            at.advance(count);
+            left -= count;
+        }
+    });
+}
+
+/// Forward iterator over a run_table in logical order, so that std::merge
+/// and std::move can read and write deque elements in place.
+template <typename T>
+class run_iterator {
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef T                         value_type;
+    typedef std::ptrdiff_t            difference_type;
+    typedef T*                        pointer;
+    typedef T&                        reference;
+
+    run_iterator(const run_table<T*>& table, const size_t index)
+        : table_(&table), index_(index), run_(0), data_(NULL), step_(1), left_(0)
+    {
+        if (index < table.size()) {
+            run_ = table.find(index);
+            const run<T*>& current = table[run_];
+            const size_t offset = index - current.begin;
+            step_ = current.step;
+            data_ = current.first + step_ * static_cast<std::ptrdiff_t>(offset);
+            left_ = current.size - offset;
+        }
+    }
+
+    reference operator*()  const { return *data_; }
+    pointer   operator->() const { return data_; }
+
+    run_iterator& operator++()
+    {
+        ++index_;
+        if (0 != --left_) {
+            data_ += step_;
+        } else if (index_ < table_->size()) {
+            const run<T*>& next = (*table_)[++run_];
+            data_ = next.first;
+            step_ = next.step;
+            left_ = next.size;
+        }
+        return *this;
+    }
+
+    run_iterator operator++(int)
+    {
+        const run_iterator previous(*this);
+        ++*this;
+        return previous;
+    }
+
+    bool operator==(const run_iterator& rhv) const { return index_ == rhv.index_; }
+    bool operator!=(const run_iterator& rhv) const { return index_ != rhv.index_; }
+
+private:
+    const run_table<T*>* table_;
+    size_t index_;
+    size_t run_;
+    T* data_;
+    std::ptrdiff_t step_;
+    size_t left_;
+};
+
+/// The two places a merge round reads from and writes to, addressed by
+/// logical index: the deque itself and the scratch buffer.
+template <typename T>
+struct deque_side
+{
+    typedef run_iterator<T> iterator;
+    iterator at(const size_t index) const { return iterator(*table, index); }
+    const run_table<T*>* table;
+};
+
+template <typename T>
+struct buffer_side
+{
+    typedef T* iterator;
+    iterator at(const size_t index) const { return data + index; }
+    T* data;
+};
+
+/// Pieces and merge parts are not cut below this many elements.
+const size_t MINIMUM_SORT_PIECE = 1 << 14;
+
+/// Sorts every run in pieces of at most pieceSize elements and stores the
+/// logical bounds of the pieces. A front run is stored reversed, so its
+/// pieces are sorted with the comparison flipped to come out ascending in
+/// logical order.
+template <typename T, typename Compare>
+void
+sort_pieces(ThreadPool& pool, const run_table<T*>& table, const size_t pieceSize, Compare& compare,
+            std::vector<size_t>& bounds)
+{
+    struct piece { T* data; size_t size; bool reversed; };
+    std::vector<piece> pieces;
+    bounds.assign(1, 0);
+    for (size_t r = 0; r < table.runs(); ++r) {
+        const run<T*>& current = table[r];
+        for (size_t offset = 0; offset < current.size; offset += pieceSize) {
+            const size_t size = std::min(pieceSize, current.size - offset);
+            const bool reversed = -1 == current.step;
+            T* const data = reversed ? current.first - (offset + size - 1) : current.first + offset;
+            const piece next = { data, size, reversed };
+            pieces.push_back(next);
+            bounds.push_back(current.begin + offset + size);
+        }
+    }
+    pool.run(pieces.size(), [&](const size_t p) {
+        T* const first = pieces[p].data;
+        T* const last = first + pieces[p].size;
+        if (pieces[p].reversed) {
+            std::sort(first, last, [&compare](const T& left, const T& right) { return compare(right, left); });
+        } else {
+            std::sort(first, last, compare);
+        }
+    });
+}
+
+/// Merge path: how many of the first k merged elements of [first, middle)
+/// and [middle, last) come from the first range.
+template <typename Side, typename Compare>
+size_t
+co_rank(const Side& side, const size_t first, const size_t middle, const size_t last, const size_t k, Compare& compare)
+{
+    size_t low = k > last - middle ? k - (last - middle) : 0;
+    size_t high = std::min(k, middle - first);
+    while (low < high) {
+        const size_t i = low + (high - low) / 2;
+        if (compare(*side.at(middle + (k - i) - 1), *side.at(first + i))) {
+            high = i;
+        } else {
+            low = i + 1;
+        }
+    }
+    return low;
+}
+
+/// Merges pieces pairwise from one side into the other and halves bounds.
+/// Each merge is cut into as many parts as its share of the threads, so
+/// the final merges keep every thread busy as well. The cuts are found
+/// before any part runs, as the parts move their elements out.
+template <typename Source, typename Destination, typename Compare>
+void
+merge_round(ThreadPool& pool, const Source& from, const Destination& to, std::vector<size_t>& bounds, Compare& compare)
+{
+    struct part { size_t first; size_t middle; size_t output; size_t firstCount; size_t secondCount; };
+    const size_t pieces = bounds.size() - 1;
+    const size_t merges = (pieces + 1) / 2;
+    const size_t share = (pool.threads() + merges - 1) / merges;
+    std::vector<part> parts;
+    std::vector<size_t> merged(1, bounds[0]);
+    for (size_t m = 0; m < pieces; m += 2) {
+        const size_t first = bounds[m];
+        const size_t middle = bounds[m + 1];
+        const size_t last = m + 2 <= pieces ? bounds[m + 2] : middle;
+        const size_t length = last - first;
+        const size_t splits = std::max<size_t>(1, std::min(share, length / MINIMUM_SORT_PIECE));
+        size_t begin = 0;
+        size_t taken = 0;
+        for (size_t s = 1; s <= splits; ++s) {
+            const size_t end = length * s / splits;
+            const size_t upTo = s == splits ? middle - first : co_rank(from, first, middle, last, end, compare);
+            const size_t fromSecond = begin - taken;
+            const part next = { first + taken, middle + fromSecond, first + begin,
+                                upTo - taken, (end - upTo) - fromSecond };
+            parts.push_back(next);
+            begin = end;
+            taken = upTo;
+        }
+        merged.push_back(last);
+    }
+    pool.run(parts.size(), [&](const size_t p) {
+        const part& work = parts[p];
+        std::merge(std::make_move_iterator(from.at(work.first)),
+                   std::make_move_iterator(from.at(work.first + work.firstCount)),
+                   std::make_move_iterator(from.at(work.middle)),
+                   std::make_move_iterator(from.at(work.middle + work.secondCount)),
+                   to.at(work.output), compare);
+    });
+    bounds.swap(merged);
+}
+
+} /// namespace detail
+
+template <typename T, typename Allocator, typename Storage, typename Statistics, typename Function>
+void
+for_each(ThreadPool& pool, Deque<T, Allocator, Storage, Statistics>& deque, Function function, const size_t grain)
+{
+    const detail::run_table<T*> table(deque);
+    detail::for_each_chunk(pool, table, function, grain);
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics, typename Function>
+void
+for_each(ThreadPool& pool, const Deque<T, Allocator, Storage, Statistics>& deque, Function function, const size_t grain)
+{
+    const detail::run_table<const T*> table(deque);
+    detail::for_each_chunk(pool, table, function, grain);
+}
+
+/// The destination is resized first, so the run tables of both deques
+/// are fixed while the chunks run; each chunk steps through a source and
+/// a destination cursor by the shorter of their current runs.
+template <typename T, typename Allocator, typename Storage, typename Statistics,
+          typename U, typename OutAllocator, typename OutStorage, typename OutStatistics, typename Function>
+void
+transform(ThreadPool& pool, const Deque<T, Allocator, Storage, Statistics>& source,
+          Deque<U, OutAllocator, OutStorage, OutStatistics>& destination, Function function, const size_t grain)
+{
+    destination.resize(source.size());
+    const detail::run_table<const T*> in(source);
+    const detail::run_table<U*> out(destination);
+    const size_t size = in.size();
+    pool.run(detail::chunk_count(size, grain), [&](const size_t chunk) {
+        const size_t begin = chunk * grain;
+        detail::cursor<const T*> from(in, begin);
+        detail::cursor<U*> to(out, begin);
+        for (size_t left = std::min(grain, size - begin); left > 0; ) {
+            const size_t count = std::min(left, std::min(from.available(), to.available()));
+            const T* input = from.data();
+            U* output = to.data();
+            if (1 == from.step() && 1 == to.step()) {
+                for (size_t i = 0; i < count; ++i) output[i] = function(input[i]);
+            } else {
+                const std::ptrdiff_t inputStep = from.step();
+                const std::ptrdiff_t outputStep = to.step();
+                for (size_t i = 0; i < count; ++i, input += inputStep, output += outputStep) {
+                    *output = function(*input);
+                }
+            }
+            from.advance(count);
+            to.advance(count);
+            left -= count;
+        }
+    });
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics,
+          typename Result, typename BinaryOperation>
+Result
+reduce(ThreadPool& pool, const Deque<T, Allocator, Storage, Statistics>& deque, Result init,
+       BinaryOperation operation, const size_t grain)
+{
+    const detail::run_table<const T*> table(deque);
+    const size_t size = table.size();
+    const size_t chunks = detail::chunk_count(size, grain);
+    std::vector<Result> partials(chunks, init);
+    pool.run(chunks, [&](const size_t chunk) {
+        const size_t begin = chunk * grain;
+        detail::cursor<const T*> at(table, begin);
+        Result partial = *at.data();
+        at.advance(1);
+        for (size_t left = std::min(grain, size - begin) - 1; left > 0; ) {
+            const size_t count = std::min(left, at.available());
+            const T* data = at.data();
+            if (1 == at.step()) {
+                for (size_t i = 0; i < count; ++i) partial = operation(partial, data[i]);
+            } else {
+                for (size_t i = 0; i < count; ++i) partial = operation(partial, *(data - i));
+            }
+            at.advance(count);
+            left -= count;
+        }
+        partials[chunk] = partial;
+    });
+    for (size_t chunk = 0; chunk < chunks; ++chunk) {
+        init = operation(init, partials[chunk]);
+    }
+    return init;
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics, typename Result>
+Result
+reduce(ThreadPool& pool, const Deque<T, Allocator, Storage, Statistics>& deque, Result init)
+{
+    return reduce(pool, deque, init, std::plus<Result>());
+}
+
+/// Merge rounds alternate between the deque and the scratch buffer; after
+/// an odd number of them the result is moved back in parallel chunks.
+template <typename T, typename Allocator, typename Storage, typename Statistics, typename Compare>
+void
+sort(ThreadPool& pool, Deque<T, Allocator, Storage, Statistics>& deque, Compare compare)
+{
+    const detail::run_table<T*> table(deque);
+    const size_t size = table.size();
+    if (size < 2) return;
+    const size_t threads = pool.threads();
+    const size_t pieceSize = std::max(detail::MINIMUM_SORT_PIECE, (size + threads - 1) / threads);
+    std::vector<size_t> bounds;
+    detail::sort_pieces(pool, table, pieceSize, compare, bounds);
+    if (bounds.size() <= 2) return;
+
+    const std::unique_ptr<T[]> scratch(new T[size]);
+    const detail::deque_side<T> inDeque = { &table };
+    const detail::buffer_side<T> inScratch = { scratch.get() };
+    bool merged = false;
+    while (bounds.size() > 2) {
+        if (merged) {
+            detail::merge_round(pool, inScratch, inDeque, bounds, compare);
+        } else {
+            detail::merge_round(pool, inDeque, inScratch, bounds, compare);
+        }
+        merged = !merged;
+    }
+    if (!merged) return;
+    pool.run(detail::chunk_count(size, DEFAULT_GRAIN), [&](const size_t chunk) {
+        const size_t begin = chunk * DEFAULT_GRAIN;
+        const size_t end = std::min(size, begin + DEFAULT_GRAIN);
+        std::move(scratch.get() + begin, scratch.get() + end, detail::run_iterator<T>(table, begin));
+    });
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+void
+sort(ThreadPool& pool, Deque<T, Allocator, Storage, Statistics>& deque)
+{
+    sort(pool, deque, std::less<T>());
+}
+
+} /// namespace deque_parallel
+
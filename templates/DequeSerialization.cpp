@@ -0,0 +1,339 @@
+#include "../headers/DequeSerialization.hpp"
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <utility>
+
+namespace deque_serialization {
+
+/// Gathers the runs of for_each_segment: the front half's runs in the order
+/// they are stored, and the back half's.
+template <typename Pointer>
+class run_collector {
+public:
+    typedef std::vector<std::pair<Pointer, size_t> > runs;
+
+    run_collector(runs& front, runs& back) : front_(front), back_(back) {}
+
+    void operator()(Pointer data, const size_t size, const bool reversed)
+    {
+        if (0 == size) return;
+        (reversed ? front_ : back_).push_back(std::make_pair(data, size));
+    }
+
+private:
+    runs& front_;
+    runs& back_;
+};
+
+template <typename Pointer>
+size_t
+total(const std::vector<std::pair<Pointer, size_t> >& runs)
+{
+    size_t size = 0;
+    for (size_t i = 0; i < runs.size(); ++i) {
+        size += runs[i].second;
+    }
+    return size;
+}
+
+template <typename Deque, typename Pointer>
+void
+collect(Deque& deque, std::vector<std::pair<Pointer, size_t> >& front, std::vector<std::pair<Pointer, size_t> >& back)
+{
+    deque.for_each_segment(run_collector<Pointer>(front, back));
+    std::reverse(front.begin(), front.end()); /// visited in logical order
+}
+
+/// One write call per run.
+template <typename T, typename Allocator, typename Storage, typename Statistics, typename Sink>
+void
+save_raw(const ::Deque<T, Allocator, Storage, Statistics>& deque, Sink& sink)
+{
+    std::vector<std::pair<const T*, size_t> > front;
+    std::vector<std::pair<const T*, size_t> > back;
+    collect(deque, front, back);
+    const DequeSnapshotHeader header = DequeSnapshotHeader::make(sizeof(T), DequeSnapshotHeader::RAW,
+                                                                 total(front), total(back));
+    deque_io::write_all(sink, &header, sizeof(header));
+    for (size_t i = 0; i < front.size(); ++i) {
+        deque_io::write_all(sink, front[i].first, front[i].second * sizeof(T));
+    }
+    for (size_t i = 0; i < back.size(); ++i) {
+        deque_io::write_all(sink, back[i].first, back[i].second * sizeof(T));
+    }
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+void
+save_encoded(const ::Deque<T, Allocator, Storage, Statistics>& deque, std::ostream& out)
+{
+    std::vector<std::pair<const T*, size_t> > front;
+    std::vector<std::pair<const T*, size_t> > back;
+    collect(deque, front, back);
+    const DequeSnapshotHeader header = DequeSnapshotHeader::make(sizeof(T), DequeSnapshotHeader::SERIALIZER,
+                                                                 total(front), total(back));
+    deque_io::write_all(out, &header, sizeof(header));
+    for (size_t i = 0; i < front.size(); ++i) {
+        for (size_t k = 0; k < front[i].second; ++k) {
+            Serializer<T>::write(out, front[i].first[k]);
+        }
+    }
+    for (size_t i = 0; i < back.size(); ++i) {
+        for (size_t k = 0; k < back[i].second; ++k) {
+            Serializer<T>::write(out, back[i].first[k]);
+        }
+    }
+    if (!out) throw std::runtime_error("Deque snapshot: write failed");
+}
+
+/// Reads the elements [first, last) of the back half, whose runs are given
+/// in logical order, straight from source.
+template <typename T, typename Source>
+void
+read_runs(Source& source, const std::vector<std::pair<T*, size_t> >& runs, const size_t first, const size_t last)
+{
+    size_t offset = 0;
+    for (size_t i = 0; i < runs.size() && offset < last; ++i) {
+        const size_t begin = std::max(first, offset);
+        const size_t end = std::min(last, offset + runs[i].second);
+        if (begin < end) {
+            deque_io::read_all(source, runs[i].first + (begin - offset), (end - begin) * sizeof(T));
+        }
+        offset += runs[i].second;
+    }
+}
+
+/// Bytes the deque may grow by, past what is already read, when the input
+/// has no known end.
+const size_t RAW_READ_STEP = 64 << 20;
+
+/// Reads the file front to back straight into the runs of the back half,
+/// then restores the order of the front part. The sizes in the header are
+/// checked against the bytes left when the input has a known end, and the
+/// deque is sized once; otherwise it grows by at most what is already read,
+/// so a corrupt header runs out of input before it runs out of memory.
+template <typename T, typename Allocator, typename Storage, typename Statistics, typename Source>
+void
+load_raw(::Deque<T, Allocator, Storage, Statistics>& deque, Source& source)
+{
+    DequeSnapshotHeader header;
+    deque_io::read_all(source, &header, sizeof(header));
+    header.check(sizeof(T), DequeSnapshotHeader::RAW);
+    const size_t size = static_cast<size_t>(header.elements(deque.max_size()));
+    const size_t frontSize = static_cast<size_t>(header.frontSize);
+    uint64_t available = 0;
+    const bool bounded = deque_io::remaining(source, available);
+    if (bounded && available / sizeof(T) < size) {
+        throw std::runtime_error("Deque snapshot: truncated input");
+    }
+    deque.clear();
+
+    std::vector<std::pair<T*, size_t> > front;
+    std::vector<std::pair<T*, size_t> > back;
+    for (size_t loaded = 0; loaded < size; ) {
+        const size_t step = bounded ? size - loaded
+                                    : std::min(size - loaded, std::max(RAW_READ_STEP / sizeof(T), loaded));
+        deque.resize(loaded + step);
+        front.clear();
+        back.clear();
+        collect(deque, front, back);
+        read_runs(source, back, loaded, loaded + step);
+        loaded += step;
+    }
+    if (!back.empty() && back.front().second >= frontSize) {
+        std::reverse(back.front().first, back.front().first + frontSize);
+    } else {
+        std::reverse(deque.begin(), deque.begin() + frontSize);
+    }
+}
+
+/// The front part is stored innermost element first, so push_front
+/// rebuilds it in order.
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+void
+load_encoded(::Deque<T, Allocator, Storage, Statistics>& deque, std::istream& in)
+{
+    DequeSnapshotHeader header;
+    deque_io::read_all(in, &header, sizeof(header));
+    header.check(sizeof(T), DequeSnapshotHeader::SERIALIZER);
+    deque.clear();
+    for (uint64_t i = 0; i < header.frontSize; ++i) {
+        deque.push_front(Serializer<T>::read(in));
+    }
+    for (uint64_t i = 0; i < header.backSize; ++i) {
+        deque.push_back(Serializer<T>::read(in));
+    }
+    if (!in) throw std::runtime_error("Deque snapshot: truncated input");
+}
+
+template <typename Deque>
+void
+save(const Deque& deque, std::ostream& out, std::true_type)
+{
+    save_raw(deque, out);
+}
+
+template <typename Deque>
+void
+save(const Deque& deque, std::ostream& out, std::false_type)
+{
+    save_encoded(deque, out);
+}
+
+template <typename Deque>
+void
+save(const Deque& deque, const int descriptor, std::true_type)
+{
+    save_raw(deque, descriptor);
+}
+
+template <typename Deque>
+void
+save(const Deque& deque, const int descriptor, std::false_type)
+{
+    FdStreamBuffer buffer(descriptor);
+    std::ostream out(&buffer);
+    save_encoded(deque, out);
+    out.flush();
+    if (!out) throw std::runtime_error("Deque snapshot: write failed");
+}
+
+template <typename Deque>
+void
+load(Deque& deque, std::istream& in, std::true_type)
+{
+    load_raw(deque, in);
+}
+
+template <typename Deque>
+void
+load(Deque& deque, std::istream& in, std::false_type)
+{
+    load_encoded(deque, in);
+}
+
+template <typename Deque>
+void
+load(Deque& deque, const int descriptor, std::true_type)
+{
+    load_raw(deque, descriptor);
+}
+
+/// The stream buffer may read ahead past the snapshot.
+template <typename Deque>
+void
+load(Deque& deque, const int descriptor, std::false_type)
+{
+    FdStreamBuffer buffer(descriptor);
+    std::istream in(&buffer);
+    load_encoded(deque, in);
+}
+
+} /// namespace deque_serialization
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+void
+save(const Deque<T, Allocator, Storage, Statistics>& deque, std::ostream& out)
+{
+    deque_serialization::save(deque, out, std::is_trivially_copyable<T>());
+}
+
+/// Writes at the descriptor's current offset.
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+void
+save(const Deque<T, Allocator, Storage, Statistics>& deque, const int descriptor)
+{
+    deque_serialization::save(deque, descriptor, std::is_trivially_copyable<T>());
+}
+
+/// Replaces the contents of deque with the snapshot read from in.
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+void
+load(Deque<T, Allocator, Storage, Statistics>& deque, std::istream& in)
+{
+    deque_serialization::load(deque, in, std::is_trivially_copyable<T>());
+}
+
+template <typename T, typename Allocator, typename Storage, typename Statistics>
+void
+load(Deque<T, Allocator, Storage, Statistics>& deque, const int descriptor)
+{
+    deque_serialization::load(deque, descriptor, std::is_trivially_copyable<T>());
+}
+
+///==================================DEQUE_VIEW======================
+
+template <typename T>
+DequeView<T>::DequeView(const std::string& path)
+    : file_(path, MappedFile::READ_ONLY)
+    , front_(NULL)
+    , frontSize_(0)
+    , back_(NULL)
+    , backSize_(0)
+{
+    if (file_.size() < sizeof(DequeSnapshotHeader)) {
+        throw std::runtime_error("Deque snapshot: " + path + " is too short");
+    }
+    const DequeSnapshotHeader* header = reinterpret_cast<const DequeSnapshotHeader*>(file_.data());
+    header->check(sizeof(T), DequeSnapshotHeader::RAW);
+    const uint64_t elements = header->elements((file_.size() - sizeof(DequeSnapshotHeader)) / sizeof(T));
+    frontSize_ = static_cast<size_type>(header->frontSize);
+    backSize_ = static_cast<size_type>(header->backSize);
+    if (file_.size() != sizeof(DequeSnapshotHeader) + elements * sizeof(T)) {
+        throw std::runtime_error("Deque snapshot: " + path + " has the wrong size");
+    }
+    front_ = reinterpret_cast<const_pointer>(file_.data() + sizeof(DequeSnapshotHeader));
+    back_ = front_ + frontSize_;
+}
+
+template <typename T>
+typename DequeView<T>::const_reference
+DequeView<T>::operator[](const size_type index) const
+{
+    if (index < frontSize_) {
+        return front_[frontSize_ - index - 1];
+    }
+    return back_[index - frontSize_];
+}
+
+template <typename T>
+typename DequeView<T>::const_reference
+DequeView<T>::front() const
+{
+    assert(!empty());
+    return (*this)[0];
+}
+
+template <typename T>
+typename DequeView<T>::const_reference
+DequeView<T>::back() const
+{
+    assert(!empty());
+    return (*this)[size() - 1];
+}
+
+template <typename T>
+typename DequeView<T>::size_type
+DequeView<T>::size() const
+{
+    return frontSize_ + backSize_;
+}
+
+template <typename T>
+bool
+DequeView<T>::empty() const
+{
+    return 0 == size();
+}
+
+/// As Deque::for_each_segment: at most two runs, the first reversed.
+template <typename T>
+template <typename Function>
+void
+DequeView<T>::for_each_segment(Function function) const
+{
+    if (frontSize_ > 0) function(front_, frontSize_, true);
+    if (backSize_ > 0)  function(back_, backSize_, false);
+}
+
@@ -0,0 +1,253 @@
+#include "../headers/MappedDeque.hpp"
+#include <cassert>
+#include <cstring>
+#include <stdexcept>
+
+namespace mapped_deque {
+const char MAGIC[8] = { 'D', 'E', 'Q', 'U', 'E', 'M', 'A', 'P' };
+} /// namespace mapped_deque
+
+template <typename T>
+const typename MappedDeque<T>::size_type MappedDeque<T>::DEFAULT_CHUNK_BYTES;
+
+template <typename T>
+const uint32_t MappedDeque<T>::VERSION;
+
+template <typename T>
+const typename MappedDeque<T>::size_type MappedDeque<T>::HEADER_BYTES;
+
+/// Creates path as an empty queue of one chunk if it is missing or empty,
+/// and otherwise checks that it holds a queue of this T.
+template <typename T>
+MappedDeque<T>::MappedDeque(const std::string& path, const size_type chunkBytes)
+    : file_(path, MappedFile::READ_WRITE)
+    , chunkElements_(chunkBytes / sizeof(T) > 0 ? chunkBytes / sizeof(T) : 1)
+    , header_(NULL)
+    , elements_(NULL)
+{
+    if (0 == file_.size()) {
+        file_.resize(HEADER_BYTES + chunkElements_ * sizeof(T));
+        attach();
+        std::memcpy(header_->magic, mapped_deque::MAGIC, sizeof(header_->magic));
+        header_->version = VERSION;
+        header_->elementSize = sizeof(T);
+        header_->capacity = chunkElements_;
+        header_->head = 0;
+        header_->size = 0;
+    } else {
+        if (file_.size() < HEADER_BYTES) {
+            throw std::runtime_error("not a MappedDeque file: " + path);
+        }
+        attach();
+        if (0 != std::memcmp(header_->magic, mapped_deque::MAGIC, sizeof(header_->magic))
+         || VERSION != header_->version || sizeof(T) != header_->elementSize
+         || header_->capacity > (file_.size() - HEADER_BYTES) / sizeof(T)
+         || header_->head >= header_->capacity || header_->size > header_->capacity) {
+            throw std::runtime_error("not a MappedDeque file of this element type: " + path);
+        }
+    }
+    file_.advise_sequential();
+}
+
+template <typename T>
+MappedDeque<T>::~MappedDeque()
+{}
+
+template <typename T>
+typename MappedDeque<T>::reference
+MappedDeque<T>::operator[](const size_type index)
+{
+    return elements_[slot(index)];
+}
+
+template <typename T>
+typename MappedDeque<T>::const_reference
+MappedDeque<T>::operator[](const size_type index) const
+{
+    return elements_[slot(index)];
+}
+
+template <typename T>
+void
+MappedDeque<T>::push_front(const_reference value)
+{
+    if (header_->size == header_->capacity) {
+        const T element = value; /// value may live in the mapping grow() replaces
+        grow();
+        push_front(element);
+        return;
+    }
+    header_->head = (0 == header_->head ? header_->capacity : header_->head) - 1;
+    elements_[header_->head] = value;
+    ++header_->size;
+}
+
+template <typename T>
+void
+MappedDeque<T>::push_back(const_reference value)
+{
+    if (header_->size == header_->capacity) {
+        const T element = value;
+        grow();
+        push_back(element);
+        return;
+    }
+    elements_[slot(header_->size)] = value;
+    ++header_->size;
+}
+
+/// Each time the head leaves a chunk behind, that chunk's pages are dropped
+/// from memory, so a long drain does not keep the whole file resident.
+template <typename T>
+void
+MappedDeque<T>::pop_front()
+{
+    assert(!empty());
+    ++header_->head;
+    if (header_->head == header_->capacity) {
+        header_->head = 0;
+    }
+    --header_->size;
+    if (0 == header_->head % chunkElements_) {
+        const size_type drained = (0 == header_->head ? header_->capacity : header_->head) - chunkElements_;
+        file_.release(HEADER_BYTES + drained * sizeof(T), chunkElements_ * sizeof(T));
+    }
+}
+
+template <typename T>
+void
+MappedDeque<T>::pop_back()
+{
+    assert(!empty());
+    --header_->size;
+}
+
+template <typename T>
+typename MappedDeque<T>::reference
+MappedDeque<T>::front()
+{
+    assert(!empty());
+    return elements_[header_->head];
+}
+
+template <typename T>
+typename MappedDeque<T>::const_reference
+MappedDeque<T>::front() const
+{
+    assert(!empty());
+    return elements_[header_->head];
+}
+
+template <typename T>
+typename MappedDeque<T>::reference
+MappedDeque<T>::back()
+{
+    assert(!empty());
+    return elements_[slot(header_->size - 1)];
+}
+
+template <typename T>
+typename MappedDeque<T>::const_reference
+MappedDeque<T>::back() const
+{
+    assert(!empty());
+    return elements_[slot(header_->size - 1)];
+}
+
+template <typename T>
+typename MappedDeque<T>::size_type
+MappedDeque<T>::capacity() const
+{
+    return header_->capacity;
+}
+
+template <typename T>
+typename MappedDeque<T>::size_type
+MappedDeque<T>::size() const
+{
+    return header_->size;
+}
+
+template <typename T>
+bool
+MappedDeque<T>::empty() const
+{
+    return 0 == header_->size;
+}
+
+/// Empties the queue; the file keeps its size.
+template <typename T>
+void
+MappedDeque<T>::clear()
+{
+    header_->head = 0;
+    header_->size = 0;
+}
+
+/// Blocks until the elements and the header are on disk.
+template <typename T>
+void
+MappedDeque<T>::sync()
+{
+    file_.sync();
+}
+
+template <typename T>
+void
+MappedDeque<T>::attach()
+{
+    header_ = reinterpret_cast<header*>(file_.data());
+    elements_ = reinterpret_cast<pointer>(file_.data() + HEADER_BYTES);
+}
+
+/// Extends the file by whole chunks, at least half the current capacity,
+/// and copies the wrapped part of the ring, if any, into the new space so
+/// the ring stays contiguous modulo the new capacity: the newer part
+/// [0, tail) to just past the old end when it fits, and otherwise the older
+/// part [head, capacity) to the end of the file. The new space is at least
+/// half the old capacity, so one of the two always fits without touching a
+/// live slot. The copy is synced before the header names the new layout,
+/// so a crash at any point leaves a file that opens as the old ring or the
+/// new one; a file longer than its capacity is accepted on open. Should
+/// the process stop between the two header stores, head is past the old
+/// capacity, which open rejects rather than misreads.
+template <typename T>
+void
+MappedDeque<T>::grow()
+{
+    const size_type oldCapacity = header_->capacity;
+    const size_type wanted = oldCapacity / 2 > chunkElements_ ? oldCapacity / 2 : chunkElements_;
+    const size_type added = (wanted + chunkElements_ - 1) / chunkElements_ * chunkElements_;
+    file_.resize(HEADER_BYTES + (oldCapacity + added) * sizeof(T));
+    attach();
+    const size_type head = header_->head;
+    size_type newHead = head;
+    if (head + header_->size > oldCapacity) {
+        const size_type tail = head + header_->size - oldCapacity;
+        size_type from = 0;
+        size_type to = oldCapacity;
+        size_type count = tail;
+        if (tail > added) {
+            from = head;
+            to = head + added;
+            count = oldCapacity - head;
+            newHead = head + added;
+        }
+        assert(count <= added);
+        std::memcpy(elements_ + to, elements_ + from, count * sizeof(T));
+        file_.sync(HEADER_BYTES + to * sizeof(T), count * sizeof(T));
+    }
+    header_->head = newHead;
+    header_->capacity = oldCapacity + added;
+    file_.advise_sequential();
+}
+
+/// Buffer slot of a logical index; head + index < 2 * capacity always.
+template <typename T>
+typename MappedDeque<T>::size_type
+MappedDeque<T>::slot(const size_type index) const
+{
+    const size_type position = header_->head + index;
+    return position < header_->capacity ? position : position - header_->capacity;
+}
+
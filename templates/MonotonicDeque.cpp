@@ -0,0 +1,110 @@
+#include "../headers/MonotonicDeque.hpp"
+#include <cassert>
+
+template <typename T, typename Compare, typename Stamp>
+MonotonicDeque<T, Compare, Stamp>::MonotonicDeque(const Compare& compare)
+    : compare_(compare)
+    , minimums_()
+    , maximums_()
+    , pushed_(0)
+{}
+
+template <typename T, typename Compare, typename Stamp>
+void
+MonotonicDeque<T, Compare, Stamp>::push(const_reference value)
+{
+    push(value, static_cast<Stamp>(pushed_));
+}
+
+/// An older candidate that is not better than value can never be the answer
+/// again, since value outlives it. Each element is pushed and popped at most
+/// once per Deque, hence amortized O(1).
+template <typename T, typename Compare, typename Stamp>
+void
+MonotonicDeque<T, Compare, Stamp>::push(const_reference value, const Stamp stamp)
+{
+    assert(minimums_.empty() || !(stamp < minimums_.back().stamp));
+    while (!minimums_.empty() && !compare_(minimums_.back().value, value)) {
+        minimums_.pop_back();
+    }
+    while (!maximums_.empty() && !compare_(value, maximums_.back().value)) {
+        maximums_.pop_back();
+    }
+    const entry candidate = { value, stamp };
+    minimums_.push_back(candidate);
+    maximums_.push_back(candidate);
+    ++pushed_;
+}
+
+/// Leaves only elements pushed with a stamp of at least stamp.
+template <typename T, typename Compare, typename Stamp>
+void
+MonotonicDeque<T, Compare, Stamp>::expire_older_than(const Stamp stamp)
+{
+    expire(minimums_, stamp);
+    expire(maximums_, stamp);
+}
+
+/// Leaves only the last count elements pushed with push(value).
+template <typename T, typename Compare, typename Stamp>
+void
+MonotonicDeque<T, Compare, Stamp>::keep_last(const size_type count)
+{
+    if (pushed_ > count) {
+        expire_older_than(static_cast<Stamp>(pushed_ - count));
+    }
+}
+
+template <typename T, typename Compare, typename Stamp>
+void
+MonotonicDeque<T, Compare, Stamp>::clear()
+{
+    minimums_.clear();
+    maximums_.clear();
+    pushed_ = 0;
+}
+
+/// Smallest element of the window under Compare.
+template <typename T, typename Compare, typename Stamp>
+typename MonotonicDeque<T, Compare, Stamp>::const_reference
+MonotonicDeque<T, Compare, Stamp>::min() const
+{
+    assert(!empty());
+    return minimums_.front().value;
+}
+
+/// Largest element of the window under Compare.
+template <typename T, typename Compare, typename Stamp>
+typename MonotonicDeque<T, Compare, Stamp>::const_reference
+MonotonicDeque<T, Compare, Stamp>::max() const
+{
+    assert(!empty());
+    return maximums_.front().value;
+}
+
+/// The newest element is a candidate in both Deques until it expires, so
+/// the window is empty exactly when they are.
+template <typename T, typename Compare, typename Stamp>
+bool
+MonotonicDeque<T, Compare, Stamp>::empty() const
+{
+    return minimums_.empty();
+}
+
+/// Number of elements pushed since construction or clear().
+template <typename T, typename Compare, typename Stamp>
+typename MonotonicDeque<T, Compare, Stamp>::size_type
+MonotonicDeque<T, Compare, Stamp>::pushed() const
+{
+    return pushed_;
+}
+
+template <typename T, typename Compare, typename Stamp>
+void
+MonotonicDeque<T, Compare, Stamp>::expire(Deque<entry>& candidates, const Stamp stamp)
+{
+    while (!candidates.empty() && candidates.front().stamp < stamp) {
+        candidates.pop_front();
+    }
+}
+
@@ -0,0 +1,419 @@
+#include "../headers/RingDeque.hpp"
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <new>
+#include <utility>
+
+template <typename T>
+RingDeque<T>::RingDeque()
+    : buffer_(NULL)
+    , mask_(0)
+    , head_(0)
+    , size_(0)
+{}
+
+template <typename T>
+RingDeque<T>::RingDeque(const size_type newSize, const_reference initialValue)
+    : buffer_(NULL)
+    , mask_(0)
+    , head_(0)
+    , size_(0)
+{
+    resize(newSize, initialValue);
+}
+
+template <typename T>
+RingDeque<T>::RingDeque(const int newSize, const_reference initialValue)
+    : buffer_(NULL)
+    , mask_(0)
+    , head_(0)
+    , size_(0)
+{
+    resize(newSize, initialValue);
+}
+
+template <typename T>
+RingDeque<T>::RingDeque(const RingDeque<T>& rhv)
+    : buffer_(NULL)
+    , mask_(0)
+    , head_(0)
+    , size_(0)
+{
+    reserve(rhv.size_);
+    for (size_type i = 0; i < rhv.size_; ++i) {
+        push_back(rhv[i]);
+    }
+}
+
+template <typename T>
+RingDeque<T>::RingDeque(RingDeque<T>&& rhv) noexcept
+    : buffer_(rhv.buffer_)
+    , mask_(rhv.mask_)
+    , head_(rhv.head_)
+    , size_(rhv.size_)
+{
+    rhv.buffer_ = NULL;
+    rhv.mask_ = 0;
+    rhv.head_ = 0;
+    rhv.size_ = 0;
+}
+
+template <typename T>
+template <typename InputIterator>
+RingDeque<T>::RingDeque(InputIterator first, InputIterator last)
+    : buffer_(NULL)
+    , mask_(0)
+    , head_(0)
+    , size_(0)
+{
+    for (; first != last; ++first) {
+        push_back(*first);
+    }
+}
+
+template <typename T>
+RingDeque<T>::~RingDeque()
+{
+    clear();
+    ::operator delete(buffer_);
+}
+
+template <typename T>
+RingDeque<T>&
+RingDeque<T>::operator=(const RingDeque<T>& rhv)
+{
+    if (this == &rhv) return *this;
+    RingDeque<T> temp(rhv);
+    swap(temp);
+    return *this;
+}
+
+template <typename T>
+RingDeque<T>&
+RingDeque<T>::operator=(RingDeque<T>&& rhv) noexcept
+{
+    if (this == &rhv) return *this;
+    RingDeque<T> temp(std::move(rhv));
+    swap(temp);
+    return *this;
+}
+
+template <typename T>
+bool
+RingDeque<T>::operator==(const RingDeque<T>& rhv) const
+{
+    if (this == &rhv)       return true;
+    if (size_ != rhv.size_) return false;
+    return std::equal(begin(), end(), rhv.begin());
+}
+
+template <typename T>
+bool
+RingDeque<T>::operator!=(const RingDeque<T>& rhv) const
+{
+    return !(*this == rhv);
+}
+
+template <typename T>
+bool
+RingDeque<T>::operator<(const RingDeque<T>& rhv) const
+{
+    return std::lexicographical_compare(begin(), end(), rhv.begin(), rhv.end());
+}
+
+template <typename T>
+bool
+RingDeque<T>::operator>(const RingDeque<T>& rhv) const
+{
+    return rhv < *this;
+}
+
+template <typename T>
+bool
+RingDeque<T>::operator<=(const RingDeque<T>& rhv) const
+{
+    return !(*this > rhv);
+}
+
+template <typename T>
+bool
+RingDeque<T>::operator>=(const RingDeque<T>& rhv) const
+{
+    return !(*this < rhv);
+}
+
+template <typename T>
+typename RingDeque<T>::reference
+RingDeque<T>::operator[](const size_type index)
+{
+    return buffer_[(head_ + index) & mask_];
+}
+
+template <typename T>
+typename RingDeque<T>::const_reference
+RingDeque<T>::operator[](const size_type index) const
+{
+    return buffer_[(head_ + index) & mask_];
+}
+
+template <typename T>
+template <typename... Args>
+typename RingDeque<T>::reference
+RingDeque<T>::emplace_front(Args&&... args)
+{
+    if (size_ == capacity()) {
+        T element(std::forward<Args>(args)...); /// args may refer into the buffer that grow() releases
+        grow(0 == size_ ? 8 : 2 * size_);
+        return emplace_front(std::move(element));
+    }
+    const size_type slot = (head_ - 1) & mask_;
+    new (buffer_ + slot) T(std::forward<Args>(args)...);
+    head_ = slot;
+    ++size_;
+    return buffer_[slot];
+}
+
+template <typename T>
+template <typename... Args>
+typename RingDeque<T>::reference
+RingDeque<T>::emplace_back(Args&&... args)
+{
+    if (size_ == capacity()) {
+        T element(std::forward<Args>(args)...);
+        grow(0 == size_ ? 8 : 2 * size_);
+        return emplace_back(std::move(element));
+    }
+    pointer slot = buffer_ + ((head_ + size_) & mask_);
+    new (slot) T(std::forward<Args>(args)...);
+    ++size_;
+    return *slot;
+}
+
+template <typename T>
+void
+RingDeque<T>::push_front(const_reference value)
+{
+    emplace_front(value);
+}
+
+template <typename T>
+void
+RingDeque<T>::push_front(value_type&& value)
+{
+    emplace_front(std::move(value));
+}
+
+template <typename T>
+void
+RingDeque<T>::push_back(const_reference value)
+{
+    emplace_back(value);
+}
+
+template <typename T>
+void
+RingDeque<T>::push_back(value_type&& value)
+{
+    emplace_back(std::move(value));
+}
+
+template <typename T>
+void
+RingDeque<T>::pop_front()
+{
+    assert(!empty());
+    buffer_[head_].~T();
+    head_ = (head_ + 1) & mask_;
+    --size_;
+}
+
+template <typename T>
+void
+RingDeque<T>::pop_back()
+{
+    assert(!empty());
+    --size_;
+    buffer_[(head_ + size_) & mask_].~T();
+}
+
+template <typename T>
+typename RingDeque<T>::reference
+RingDeque<T>::front()
+{
+    assert(!empty());
+    return buffer_[head_];
+}
+
+template <typename T>
+typename RingDeque<T>::const_reference
+RingDeque<T>::front() const
+{
+    assert(!empty());
+    return buffer_[head_];
+}
+
+template <typename T>
+typename RingDeque<T>::reference
+RingDeque<T>::back()
+{
+    assert(!empty());
+    return buffer_[(head_ + size_ - 1) & mask_];
+}
+
+template <typename T>
+typename RingDeque<T>::const_reference
+RingDeque<T>::back() const
+{
+    assert(!empty());
+    return buffer_[(head_ + size_ - 1) & mask_];
+}
+
+template <typename T>
+void
+RingDeque<T>::resize(const size_type newSize, const_reference initialValue)
+{
+    reserve(newSize);
+    while (size_ > newSize) {
+        pop_back();
+    }
+    while (size_ < newSize) {
+        push_back(initialValue);
+    }
+}
+
+template <typename T>
+void
+RingDeque<T>::reserve(const size_type newCapacity)
+{
+    if (newCapacity <= capacity()) return;
+    size_type powerOfTwo = 8;
+    while (powerOfTwo < newCapacity) {
+        powerOfTwo *= 2;
+    }
+    grow(powerOfTwo);
+}
+
+template <typename T>
+typename RingDeque<T>::size_type
+RingDeque<T>::capacity() const
+{
+    return (NULL == buffer_) ? 0 : mask_ + 1;
+}
+
+template <typename T>
+typename RingDeque<T>::size_type
+RingDeque<T>::max_size() const
+{
+    return std::numeric_limits<size_type>::max() / sizeof(T);
+}
+
+template <typename T>
+typename RingDeque<T>::size_type
+RingDeque<T>::size() const
+{
+    return size_;
+}
+
+template <typename T>
+bool
+RingDeque<T>::empty() const
+{
+    return 0 == size_;
+}
+
+template <typename T>
+void
+RingDeque<T>::clear()
+{
+    while (size_ > 0) {
+        pop_back();
+    }
+    head_ = 0;
+}
+
+template <typename T>
+void
+RingDeque<T>::swap(RingDeque<T>& rhv) noexcept
+{
+    std::swap(buffer_, rhv.buffer_);
+    std::swap(mask_, rhv.mask_);
+    std::swap(head_, rhv.head_);
+    std::swap(size_, rhv.size_);
+}
+
+template <typename T>
+typename RingDeque<T>::const_iterator
+RingDeque<T>::begin() const
+{
+    return const_iterator(buffer_, mask_, head_);
+}
+
+template <typename T>
+typename RingDeque<T>::const_iterator
+RingDeque<T>::end() const
+{
+    return const_iterator(buffer_, mask_, head_ + size_);
+}
+
+template <typename T>
+typename RingDeque<T>::const_reverse_iterator
+RingDeque<T>::rbegin() const
+{
+    return const_reverse_iterator(end());
+}
+
+template <typename T>
+typename RingDeque<T>::const_reverse_iterator
+RingDeque<T>::rend() const
+{
+    return const_reverse_iterator(begin());
+}
+
+template <typename T>
+typename RingDeque<T>::iterator
+RingDeque<T>::begin()
+{
+    return iterator(buffer_, mask_, head_);
+}
+
+template <typename T>
+typename RingDeque<T>::iterator
+RingDeque<T>::end()
+{
+    return iterator(buffer_, mask_, head_ + size_);
+}
+
+template <typename T>
+typename RingDeque<T>::reverse_iterator
+RingDeque<T>::rbegin()
+{
+    return reverse_iterator(end());
+}
+
+template <typename T>
+typename RingDeque<T>::reverse_iterator
+RingDeque<T>::rend()
+{
+    return reverse_iterator(begin());
+}
+
+/// Unrolls the ring into a new buffer of newCapacity slots (a power of two),
+/// placing the front element at slot 0.
+template <typename T>
+void
+RingDeque<T>::grow(const size_type newCapacity)
+{
+    assert(newCapacity >= size_ && 0 == (newCapacity & (newCapacity - 1)));
+    pointer newBuffer = static_cast<pointer>(::operator new(newCapacity * sizeof(T)));
+    for (size_type i = 0; i < size_; ++i) {
+        pointer element = buffer_ + ((head_ + i) & mask_);
+        new (newBuffer + i) T(std::move(*element));
+        element->~T();
+    }
+    ::operator delete(buffer_);
+    buffer_ = newBuffer;
+    mask_ = newCapacity - 1;
+    head_ = 0;
+}
+
@@ -0,0 +1,308 @@
+#include "../headers/RingIterator.hpp"
+
+inline size_t
+MaskWrap::slot(const size_t position, const size_t mask)
+{
+    return position & mask;
+}
+
+inline size_t
+CapacityWrap::slot(const size_t position, const size_t capacity)
+{
+    return position < capacity ? position : position - capacity;
+}
+
+///==================================CONST_ITERATOR======================
+
+template <typename T, typename Wrap, typename Container>
+RingConstIterator<T, Wrap, Container>::RingConstIterator()
+    : buffer_(NULL)
+    , bound_(0)
+    , position_(0)
+{}
+
+template <typename T, typename Wrap, typename Container>
+RingConstIterator<T, Wrap, Container>::RingConstIterator(const RingConstIterator& rhv)
+    : buffer_(rhv.buffer_)
+    , bound_(rhv.bound_)
+    , position_(rhv.position_)
+{}
+
+template <typename T, typename Wrap, typename Container>
+RingConstIterator<T, Wrap, Container>::~RingConstIterator()
+{
+    buffer_ = NULL;
+}
+
+template <typename T, typename Wrap, typename Container>
+RingConstIterator<T, Wrap, Container>::RingConstIterator(const T* buffer, const size_type bound, const size_type position)
+    : buffer_(const_cast<T*>(buffer))
+    , bound_(bound)
+    , position_(position)
+{}
+
+template <typename T, typename Wrap, typename Container>
+RingConstIterator<T, Wrap, Container>&
+RingConstIterator<T, Wrap, Container>::operator=(const RingConstIterator& rhv)
+{
+    buffer_ = rhv.buffer_;
+    bound_ = rhv.bound_;
+    position_ = rhv.position_;
+    return *this;
+}
+
+template <typename T, typename Wrap, typename Container>
+typename RingConstIterator<T, Wrap, Container>::reference
+RingConstIterator<T, Wrap, Container>::operator*() const
+{
+    return *element(position_);
+}
+
+template <typename T, typename Wrap, typename Container>
+typename RingConstIterator<T, Wrap, Container>::pointer
+RingConstIterator<T, Wrap, Container>::operator->() const
+{
+    return element(position_);
+}
+
+template <typename T, typename Wrap, typename Container>
+typename RingConstIterator<T, Wrap, Container>::reference
+RingConstIterator<T, Wrap, Container>::operator[](const difference_type index) const
+{
+    return *element(position_ + index);
+}
+
+template <typename T, typename Wrap, typename Container>
+RingConstIterator<T, Wrap, Container>&
+RingConstIterator<T, Wrap, Container>::operator++()
+{
+    ++position_;
+    return *this;
+}
+
+template <typename T, typename Wrap, typename Container>
+RingConstIterator<T, Wrap, Container>
+RingConstIterator<T, Wrap, Container>::operator++(int)
+{
+    RingConstIterator temp(*this);
+    ++position_;
+    return temp;
+}
+
+template <typename T, typename Wrap, typename Container>
+RingConstIterator<T, Wrap, Container>&
+RingConstIterator<T, Wrap, Container>::operator--()
+{
+    --position_;
+    return *this;
+}
+
+template <typename T, typename Wrap, typename Container>
+RingConstIterator<T, Wrap, Container>
+RingConstIterator<T, Wrap, Container>::operator--(int)
+{
+    RingConstIterator temp(*this);
+    --position_;
+    return temp;
+}
+
+template <typename T, typename Wrap, typename Container>
+RingConstIterator<T, Wrap, Container>
+RingConstIterator<T, Wrap, Container>::operator+(const difference_type size) const
+{
+    return RingConstIterator(buffer_, bound_, position_ + size);
+}
+
+template <typename T, typename Wrap, typename Container>
+RingConstIterator<T, Wrap, Container>
+RingConstIterator<T, Wrap, Container>::operator-(const difference_type size) const
+{
+    return RingConstIterator(buffer_, bound_, position_ - size);
+}
+
+template <typename T, typename Wrap, typename Container>
+RingConstIterator<T, Wrap, Container>&
+RingConstIterator<T, Wrap, Container>::operator+=(const difference_type size)
+{
+    position_ += size;
+    return *this;
+}
+
+template <typename T, typename Wrap, typename Container>
+RingConstIterator<T, Wrap, Container>&
+RingConstIterator<T, Wrap, Container>::operator-=(const difference_type size)
+{
+    position_ -= size;
+    return *this;
+}
+
+template <typename T, typename Wrap, typename Container>
+typename RingConstIterator<T, Wrap, Container>::difference_type
+RingConstIterator<T, Wrap, Container>::operator-(const RingConstIterator& rhv) const
+{
+    return static_cast<difference_type>(position_ - rhv.position_);
+}
+
+template <typename T, typename Wrap, typename Container>
+bool
+RingConstIterator<T, Wrap, Container>::operator==(const RingConstIterator& rhv) const
+{
+    return position_ == rhv.position_ && buffer_ == rhv.buffer_;
+}
+
+template <typename T, typename Wrap, typename Container>
+bool
+RingConstIterator<T, Wrap, Container>::operator!=(const RingConstIterator& rhv) const
+{
+    return !(*this == rhv);
+}
+
+template <typename T, typename Wrap, typename Container>
+bool
+RingConstIterator<T, Wrap, Container>::operator<(const RingConstIterator& rhv) const
+{
+    return position_ < rhv.position_;
+}
+
+template <typename T, typename Wrap, typename Container>
+bool
+RingConstIterator<T, Wrap, Container>::operator>(const RingConstIterator& rhv) const
+{
+    return rhv < *this;
+}
+
+template <typename T, typename Wrap, typename Container>
+bool
+RingConstIterator<T, Wrap, Container>::operator<=(const RingConstIterator& rhv) const
+{
+    return !(*this > rhv);
+}
+
+template <typename T, typename Wrap, typename Container>
+bool
+RingConstIterator<T, Wrap, Container>::operator>=(const RingConstIterator& rhv) const
+{
+    return !(*this < rhv);
+}
+
+template <typename T, typename Wrap, typename Container>
+T*
+RingConstIterator<T, Wrap, Container>::element(const size_type position) const
+{
+    return buffer_ + Wrap::slot(position, bound_);
+}
+
+///====================================================ITERATOR==============================================
+
+template <typename T, typename Wrap, typename Container>
+RingIterator<T, Wrap, Container>::RingIterator()
+    : const_iterator()
+{}
+
+template <typename T, typename Wrap, typename Container>
+RingIterator<T, Wrap, Container>::RingIterator(const RingIterator& rhv)
+    : const_iterator(rhv)
+{}
+
+template <typename T, typename Wrap, typename Container>
+RingIterator<T, Wrap, Container>::~RingIterator()
+{}
+
+template <typename T, typename Wrap, typename Container>
+RingIterator<T, Wrap, Container>::RingIterator(T* buffer, const size_type bound, const size_type position)
+    : const_iterator(buffer, bound, position)
+{}
+
+template <typename T, typename Wrap, typename Container>
+RingIterator<T, Wrap, Container>&
+RingIterator<T, Wrap, Container>::operator=(const RingIterator& rhv)
+{
+    const_iterator::operator=(rhv);
+    return *this;
+}
+
+template <typename T, typename Wrap, typename Container>
+typename RingIterator<T, Wrap, Container>::reference
+RingIterator<T, Wrap, Container>::operator*() const
+{
+    return *this->element(this->position_);
+}
+
+template <typename T, typename Wrap, typename Container>
+typename RingIterator<T, Wrap, Container>::pointer
+RingIterator<T, Wrap, Container>::operator->() const
+{
+    return this->element(this->position_);
+}
+
+template <typename T, typename Wrap, typename Container>
+typename RingIterator<T, Wrap, Container>::reference
+RingIterator<T, Wrap, Container>::operator[](const difference_type index) const
+{
+    return *this->element(this->position_ + index);
+}
+
+template <typename T, typename Wrap, typename Container>
+RingIterator<T, Wrap, Container>&
+RingIterator<T, Wrap, Container>::operator++()
+{
+    ++this->position_;
+    return *this;
+}
+
+template <typename T, typename Wrap, typename Container>
+RingIterator<T, Wrap, Container>
+RingIterator<T, Wrap, Container>::operator++(int)
+{
+    RingIterator temp(*this);
+    ++this->position_;
+    return temp;
+}
+
+template <typename T, typename Wrap, typename Container>
+RingIterator<T, Wrap, Container>&
+RingIterator<T, Wrap, Container>::operator--()
+{
+    --this->position_;
+    return *this;
+}
+
+template <typename T, typename Wrap, typename Container>
+RingIterator<T, Wrap, Container>
+RingIterator<T, Wrap, Container>::operator--(int)
+{
+    RingIterator temp(*this);
+    --this->position_;
+    return temp;
+}
+
+template <typename T, typename Wrap, typename Container>
+RingIterator<T, Wrap, Container>
+RingIterator<T, Wrap, Container>::operator+(const difference_type size) const
+{
+    return RingIterator(this->buffer_, this->bound_, this->position_ + size);
+}
+
+template <typename T, typename Wrap, typename Container>
+RingIterator<T, Wrap, Container>
+RingIterator<T, Wrap, Container>::operator-(const difference_type size) const
+{
+    return RingIterator(this->buffer_, this->bound_, this->position_ - size);
+}
+
+template <typename T, typename Wrap, typename Container>
+RingIterator<T, Wrap, Container>&
+RingIterator<T, Wrap, Container>::operator+=(const difference_type size)
+{
+    this->position_ += size;
+    return *this;
+}
+
+template <typename T, typename Wrap, typename Container>
+RingIterator<T, Wrap, Container>&
+RingIterator<T, Wrap, Container>::operator-=(const difference_type size)
+{
+    this->position_ -= size;
+    return *this;
+}
+
@@ -0,0 +1,591 @@
+#include "../headers/SmallVector.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <utility>
+
+template <typename T, size_t N, typename Allocator>
+const typename SmallVector<T, N, Allocator>::size_type SmallVector<T, N, Allocator>::INLINE_CAPACITY;
+
+template <typename T, size_t N, typename Allocator>
+SmallVector<T, N, Allocator>::SmallVector()
+    : allocator_()
+    , data_(inline_data())
+    , size_(0)
+    , capacity_(N)
+{}
+
+template <typename T, size_t N, typename Allocator>
+SmallVector<T, N, Allocator>::SmallVector(const Allocator& allocator)
+    : allocator_(allocator)
+    , data_(inline_data())
+    , size_(0)
+    , capacity_(N)
+{}
+
+template <typename T, size_t N, typename Allocator>
+SmallVector<T, N, Allocator>::SmallVector(const SmallVector<T, N, Allocator>& rhv)
+    : allocator_(traits::select_on_container_copy_construction(rhv.allocator_))
+    , data_(inline_data())
+    , size_(0)
+    , capacity_(N)
+{
+    reserve(rhv.size_);
+    construct_run(data_, rhv.data_, rhv.size_, std::is_trivially_copyable<T>());
+}
+
+/// A spilled buffer is adopted; inline elements have to be moved one by one.
+template <typename T, size_t N, typename Allocator>
+SmallVector<T, N, Allocator>::SmallVector(SmallVector<T, N, Allocator>&& rhv)
+    noexcept(nothrow_move_construction::value)
+    : allocator_(std::move(rhv.allocator_))
+    , data_(inline_data())
+    , size_(0)
+    , capacity_(N)
+{
+    if (!rhv.is_inline()) {
+        data_ = rhv.data_;
+        size_ = rhv.size_;
+        capacity_ = rhv.capacity_;
+        rhv.data_ = rhv.inline_data();
+        rhv.size_ = 0;
+        rhv.capacity_ = N;
+        return;
+    }
+    relocate_run(data_, rhv.data_, rhv.size_, std::is_trivially_copyable<T>());
+    size_ = rhv.size_;
+    rhv.size_ = 0;
+}
+
+template <typename T, size_t N, typename Allocator>
+SmallVector<T, N, Allocator>::~SmallVector()
+{
+    clear();
+    release();
+}
+
+template <typename T, size_t N, typename Allocator>
+SmallVector<T, N, Allocator>&
+SmallVector<T, N, Allocator>::operator=(const SmallVector<T, N, Allocator>& rhv)
+{
+    if (this == &rhv) return *this;
+    clear();
+    if (traits::propagate_on_container_copy_assignment::value && !(allocator_ == rhv.allocator_)) {
+        release();
+        data_ = inline_data();
+        capacity_ = N;
+        allocator_ = rhv.allocator_;
+    }
+    reserve(rhv.size_);
+    construct_run(data_, rhv.data_, rhv.size_, std::is_trivially_copyable<T>());
+    return *this;
+}
+
+template <typename T, size_t N, typename Allocator>
+SmallVector<T, N, Allocator>&
+SmallVector<T, N, Allocator>::operator=(SmallVector<T, N, Allocator>&& rhv)
+    noexcept(nothrow_move_assignment::value)
+{
+    if (this == &rhv) return *this;
+    clear();
+    if (!rhv.is_inline() && (traits::propagate_on_container_move_assignment::value || allocator_ == rhv.allocator_)) {
+        release();
+        if (traits::propagate_on_container_move_assignment::value) {
+            allocator_ = std::move(rhv.allocator_);
+        }
+        data_ = rhv.data_;
+        size_ = rhv.size_;
+        capacity_ = rhv.capacity_;
+        rhv.data_ = rhv.inline_data();
+        rhv.size_ = 0;
+        rhv.capacity_ = N;
+        return *this;
+    }
+    reserve(rhv.size_);
+    relocate_run(data_, rhv.data_, rhv.size_, std::is_trivially_copyable<T>());
+    size_ = rhv.size_;
+    rhv.size_ = 0;
+    return *this;
+}
+
+template <typename T, size_t N, typename Allocator>
+typename SmallVector<T, N, Allocator>::reference
+SmallVector<T, N, Allocator>::operator[](const size_type index)
+{
+    assert(index < size_);
+    return data_[index];
+}
+
+template <typename T, size_t N, typename Allocator>
+typename SmallVector<T, N, Allocator>::const_reference
+SmallVector<T, N, Allocator>::operator[](const size_type index) const
+{
+    assert(index < size_);
+    return data_[index];
+}
+
+template <typename T, size_t N, typename Allocator>
+template <typename InputIterator>
+void
+SmallVector<T, N, Allocator>::assign(InputIterator first, InputIterator last)
+{
+    clear();
+    insert(end(), first, last);
+}
+
+template <typename T, size_t N, typename Allocator>
+template <typename InputIterator, typename>
+void
+SmallVector<T, N, Allocator>::insert(iterator position, InputIterator first, InputIterator last)
+{
+    typedef typename std::iterator_traits<InputIterator>::iterator_category category;
+    insert_range(position - begin(), first, last,
+                 std::integral_constant<bool, std::is_base_of<std::forward_iterator_tag, category>::value>());
+}
+
+/// A forward range is measured, so the buffer grows at most once. On a
+/// spill the new elements are built in the new buffer before the old ones
+/// leave, so the range may come from this vector.
+template <typename T, size_t N, typename Allocator>
+template <typename ForwardIterator>
+void
+SmallVector<T, N, Allocator>::insert_range(const size_type index, ForwardIterator first, ForwardIterator last, std::true_type)
+{
+    const size_type count = static_cast<size_type>(std::distance(first, last));
+    const size_type oldSize = size_;
+    if (size_ + count > capacity_) {
+        const size_type newCapacity = grown_capacity(size_ + count);
+        pointer buffer = traits::allocate(allocator_, newCapacity);
+        try {
+            construct_range(buffer + size_, first, count);
+        } catch (...) {
+            traits::deallocate(allocator_, buffer, newCapacity);
+            throw;
+        }
+        relocate(buffer, newCapacity);
+    } else {
+        construct_range(data_ + size_, first, count);
+    }
+    size_ += count;
+    std::rotate(begin() + index, begin() + oldSize, end());
+}
+
+/// A single-pass range can only be appended element by element.
+template <typename T, size_t N, typename Allocator>
+template <typename InputIterator>
+void
+SmallVector<T, N, Allocator>::insert_range(const size_type index, InputIterator first, InputIterator last, std::false_type)
+{
+    const size_type oldSize = size_;
+    for (; first != last; ++first) {
+        push_back(*first);
+    }
+    std::rotate(begin() + index, begin() + oldSize, end());
+}
+
+/// Constructs count elements at uninitialized destination, destroying the
+/// ones already built if a constructor throws; size_ is left to the caller.
+template <typename T, size_t N, typename Allocator>
+template <typename ForwardIterator>
+void
+SmallVector<T, N, Allocator>::construct_range(pointer destination, ForwardIterator first, const size_type count)
+{
+    size_type built = 0;
+    try {
+        for (; built < count; ++built, ++first) {
+            traits::construct(allocator_, destination + built, *first);
+        }
+    } catch (...) {
+        for (size_type i = 0; i < built; ++i) {
+            traits::destroy(allocator_, destination + i);
+        }
+        throw;
+    }
+}
+
+/// value is copied first, since it may live in the buffer that grows.
+template <typename T, size_t N, typename Allocator>
+void
+SmallVector<T, N, Allocator>::insert(iterator position, const size_type size, const_reference value)
+{
+    const size_type index = position - begin();
+    const size_type oldSize = size_;
+    const T copy(value);
+    if (size_ + size > capacity_) {
+        reserve(grown_capacity(size_ + size));
+    }
+    for (size_type i = 0; i < size; ++i) {
+        traits::construct(allocator_, data_ + size_, copy);
+        ++size_;
+    }
+    std::rotate(begin() + index, begin() + oldSize, end());
+}
+
+template <typename T, size_t N, typename Allocator>
+typename SmallVector<T, N, Allocator>::iterator
+SmallVector<T, N, Allocator>::insert(iterator position, const_reference value)
+{
+    return emplace(position, value);
+}
+
+template <typename T, size_t N, typename Allocator>
+typename SmallVector<T, N, Allocator>::iterator
+SmallVector<T, N, Allocator>::insert(iterator position, value_type&& value)
+{
+    return emplace(position, std::move(value));
+}
+
+template <typename T, size_t N, typename Allocator>
+template <typename... Args>
+typename SmallVector<T, N, Allocator>::iterator
+SmallVector<T, N, Allocator>::emplace(iterator position, Args&&... args)
+{
+    const size_type index = position - begin();
+    emplace_back(std::forward<Args>(args)...);
+    std::rotate(begin() + index, end() - 1, end());
+    return begin() + index;
+}
+
+template <typename T, size_t N, typename Allocator>
+typename SmallVector<T, N, Allocator>::iterator
+SmallVector<T, N, Allocator>::erase(iterator position)
+{
+    return erase(position, position + 1);
+}
+
+template <typename T, size_t N, typename Allocator>
+typename SmallVector<T, N, Allocator>::iterator
+SmallVector<T, N, Allocator>::erase(iterator first, iterator last)
+{
+    const size_type index = first - begin();
+    std::move(last, end(), first);
+    destroy_from(size_ - (last - first));
+    return begin() + index;
+}
+
+/// On a spill the new element is constructed in the new buffer before the
+/// old elements leave, so args may refer to one of them.
+template <typename T, size_t N, typename Allocator>
+template <typename... Args>
+void
+SmallVector<T, N, Allocator>::emplace_back(Args&&... args)
+{
+    if (size_ == capacity_) {
+        const size_type newCapacity = grown_capacity(size_ + 1);
+        pointer buffer = traits::allocate(allocator_, newCapacity);
+        traits::construct(allocator_, buffer + size_, std::forward<Args>(args)...);
+        relocate(buffer, newCapacity);
+    } else {
+        traits::construct(allocator_, data_ + size_, std::forward<Args>(args)...);
+    }
+    ++size_;
+}
+
+template <typename T, size_t N, typename Allocator>
+void
+SmallVector<T, N, Allocator>::push_back(const_reference value)
+{
+    emplace_back(value);
+}
+
+template <typename T, size_t N, typename Allocator>
+void
+SmallVector<T, N, Allocator>::push_back(value_type&& value)
+{
+    emplace_back(std::move(value));
+}
+
+template <typename T, size_t N, typename Allocator>
+void
+SmallVector<T, N, Allocator>::pop_back()
+{
+    assert(!empty());
+    --size_;
+    traits::destroy(allocator_, data_ + size_);
+}
+
+template <typename T, size_t N, typename Allocator>
+typename SmallVector<T, N, Allocator>::reference
+SmallVector<T, N, Allocator>::front()
+{
+    assert(!empty());
+    return data_[0];
+}
+
+template <typename T, size_t N, typename Allocator>
+typename SmallVector<T, N, Allocator>::const_reference
+SmallVector<T, N, Allocator>::front() const
+{
+    assert(!empty());
+    return data_[0];
+}
+
+template <typename T, size_t N, typename Allocator>
+typename SmallVector<T, N, Allocator>::reference
+SmallVector<T, N, Allocator>::back()
+{
+    assert(!empty());
+    return data_[size_ - 1];
+}
+
+template <typename T, size_t N, typename Allocator>
+typename SmallVector<T, N, Allocator>::const_reference
+SmallVector<T, N, Allocator>::back() const
+{
+    assert(!empty());
+    return data_[size_ - 1];
+}
+
+template <typename T, size_t N, typename Allocator>
+void
+SmallVector<T, N, Allocator>::resize(const size_type newSize)
+{
+    if (newSize < size_) {
+        destroy_from(newSize);
+        return;
+    }
+    reserve(newSize);
+    while (size_ < newSize) {
+        emplace_back();
+    }
+}
+
+template <typename T, size_t N, typename Allocator>
+void
+SmallVector<T, N, Allocator>::resize(const size_type newSize, const_reference initialValue)
+{
+    if (newSize < size_) {
+        destroy_from(newSize);
+        return;
+    }
+    insert(end(), newSize - size_, initialValue);
+}
+
+template <typename T, size_t N, typename Allocator>
+void
+SmallVector<T, N, Allocator>::reserve(const size_type newCapacity)
+{
+    if (newCapacity <= capacity_) return;
+    relocate(traits::allocate(allocator_, newCapacity), newCapacity);
+}
+
+template <typename T, size_t N, typename Allocator>
+typename SmallVector<T, N, Allocator>::size_type
+SmallVector<T, N, Allocator>::capacity() const
+{
+    return capacity_;
+}
+
+/// Moves the elements back inline when they fit there again.
+template <typename T, size_t N, typename Allocator>
+void
+SmallVector<T, N, Allocator>::shrink_to_fit()
+{
+    if (is_inline() || size_ == capacity_) return;
+    if (size_ > N) {
+        relocate(traits::allocate(allocator_, size_), size_);
+        return;
+    }
+    relocate_run(inline_data(), data_, size_, std::is_trivially_copyable<T>());
+    release();
+    data_ = inline_data();
+    capacity_ = N;
+}
+
+template <typename T, size_t N, typename Allocator>
+typename SmallVector<T, N, Allocator>::size_type
+SmallVector<T, N, Allocator>::max_size() const
+{
+    return std::numeric_limits<size_type>::max() / sizeof(T);
+}
+
+template <typename T, size_t N, typename Allocator>
+typename SmallVector<T, N, Allocator>::size_type
+SmallVector<T, N, Allocator>::size() const
+{
+    return size_;
+}
+
+template <typename T, size_t N, typename Allocator>
+bool
+SmallVector<T, N, Allocator>::empty() const
+{
+    return 0 == size_;
+}
+
+/// True while the elements live in the buffer inside the object.
+template <typename T, size_t N, typename Allocator>
+bool
+SmallVector<T, N, Allocator>::is_inline() const
+{
+    return static_cast<const void*>(data_) == static_cast<const void*>(inline_);
+}
+
+template <typename T, size_t N, typename Allocator>
+void
+SmallVector<T, N, Allocator>::clear()
+{
+    destroy_from(0);
+}
+
+/// Two spilled buffers trade pointers; otherwise elements move through a
+/// temporary.
+template <typename T, size_t N, typename Allocator>
+void
+SmallVector<T, N, Allocator>::swap(SmallVector<T, N, Allocator>& rhv)
+    noexcept(nothrow_move_assignment::value)
+{
+    if (this == &rhv) return;
+    if (!is_inline() && !rhv.is_inline()) {
+        if (traits::propagate_on_container_swap::value) {
+            using std::swap;
+            swap(allocator_, rhv.allocator_);
+        }
+        std::swap(data_, rhv.data_);
+        std::swap(size_, rhv.size_);
+        std::swap(capacity_, rhv.capacity_);
+        return;
+    }
+    SmallVector<T, N, Allocator> temporary(std::move(rhv));
+    rhv = std::move(*this);
+    *this = std::move(temporary);
+}
+
+template <typename T, size_t N, typename Allocator>
+typename SmallVector<T, N, Allocator>::allocator_type
+SmallVector<T, N, Allocator>::get_allocator() const
+{
+    return allocator_;
+}
+
+template <typename T, size_t N, typename Allocator>
+typename SmallVector<T, N, Allocator>::pointer
+SmallVector<T, N, Allocator>::data()
+{
+    return data_;
+}
+
+template <typename T, size_t N, typename Allocator>
+typename SmallVector<T, N, Allocator>::const_pointer
+SmallVector<T, N, Allocator>::data() const
+{
+    return data_;
+}
+
+template <typename T, size_t N, typename Allocator>
+typename SmallVector<T, N, Allocator>::const_iterator
+SmallVector<T, N, Allocator>::begin() const
+{
+    return data_;
+}
+
+template <typename T, size_t N, typename Allocator>
+typename SmallVector<T, N, Allocator>::const_iterator
+SmallVector<T, N, Allocator>::end() const
+{
+    return data_ + size_;
+}
+
+template <typename T, size_t N, typename Allocator>
+typename SmallVector<T, N, Allocator>::iterator
+SmallVector<T, N, Allocator>::begin()
+{
+    return data_;
+}
+
+template <typename T, size_t N, typename Allocator>
+typename SmallVector<T, N, Allocator>::iterator
+SmallVector<T, N, Allocator>::end()
+{
+    return data_ + size_;
+}
+
+template <typename T, size_t N, typename Allocator>
+typename SmallVector<T, N, Allocator>::pointer
+SmallVector<T, N, Allocator>::inline_data()
+{
+    return reinterpret_cast<pointer>(inline_);
+}
+
+template <typename T, size_t N, typename Allocator>
+typename SmallVector<T, N, Allocator>::size_type
+SmallVector<T, N, Allocator>::grown_capacity(const size_type wanted) const
+{
+    return std::max(2 * capacity_, wanted);
+}
+
+/// Moves the elements into buffer, which holds newCapacity, and frees the
+/// old heap buffer if there was one.
+template <typename T, size_t N, typename Allocator>
+void
+SmallVector<T, N, Allocator>::relocate(pointer buffer, const size_type newCapacity)
+{
+    relocate_run(buffer, data_, size_, std::is_trivially_copyable<T>());
+    release();
+    data_ = buffer;
+    capacity_ = newCapacity;
+}
+
+template <typename T, size_t N, typename Allocator>
+void
+SmallVector<T, N, Allocator>::construct_run(pointer destination, const_pointer source, const size_type count, std::true_type)
+{
+    if (count > 0) {
+        std::memcpy(static_cast<void*>(destination), source, count * sizeof(T));
+    }
+    size_ += count;
+}
+
+template <typename T, size_t N, typename Allocator>
+void
+SmallVector<T, N, Allocator>::construct_run(pointer destination, const_pointer source, const size_type count, std::false_type)
+{
+    for (size_type i = 0; i < count; ++i) {
+        traits::construct(allocator_, destination + i, source[i]);
+        ++size_;
+    }
+}
+
+/// Moves count elements to uninitialized destination and destroys the
+/// sources; size_ is left to the caller.
+template <typename T, size_t N, typename Allocator>
+void
+SmallVector<T, N, Allocator>::relocate_run(pointer destination, pointer source, const size_type count, std::true_type)
+{
+    if (count > 0) {
+        std::memcpy(static_cast<void*>(destination), source, count * sizeof(T));
+    }
+}
+
+template <typename T, size_t N, typename Allocator>
+void
+SmallVector<T, N, Allocator>::relocate_run(pointer destination, pointer source, const size_type count, std::false_type)
+{
+    for (size_type i = 0; i < count; ++i) {
+        traits::construct(allocator_, destination + i, std::move(source[i]));
+        traits::destroy(allocator_, source + i);
+    }
+}
+
+template <typename T, size_t N, typename Allocator>
+void
+SmallVector<T, N, Allocator>::release()
+{
+    if (!is_inline()) {
+        traits::deallocate(allocator_, data_, capacity_);
+    }
+}
+
+template <typename T, size_t N, typename Allocator>
+void
+SmallVector<T, N, Allocator>::destroy_from(const size_type newSize)
+{
+    assert(newSize <= size_);
+    while (size_ > newSize) {
+        pop_back();
+    }
+}
+
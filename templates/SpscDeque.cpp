@@ -0,0 +1,212 @@
+#include "../headers/SpscDeque.hpp"
+#include <cassert>
+#include <limits>
+#include <new>
+#include <utility>
+
+template <typename T>
+const typename SpscDeque<T>::size_type SpscDeque<T>::CACHE_LINE;
+
+/// The capacity is rounded up to a power of two.
+template <typename T>
+SpscDeque<T>::SpscDeque(const size_type capacity)
+    : buffer_(NULL)
+    , mask_(0)
+    , head_(0)
+    , tailCache_(0)
+    , tail_(0)
+    , headCache_(0)
+{
+    assert(capacity > 0);
+    size_type powerOfTwo = 1;
+    while (powerOfTwo < capacity) {
+        powerOfTwo *= 2;
+    }
+    buffer_ = static_cast<pointer>(::operator new(powerOfTwo * sizeof(T)));
+    mask_ = powerOfTwo - 1;
+}
+
+template <typename T>
+SpscDeque<T>::~SpscDeque()
+{
+    const size_type tail = tail_.load(std::memory_order_relaxed);
+    for (size_type head = head_.load(std::memory_order_relaxed); head != tail; ++head) {
+        buffer_[head & mask_].~T();
+    }
+    ::operator delete(buffer_);
+}
+
+template <typename T>
+bool
+SpscDeque<T>::try_push_back(const_reference value)
+{
+    return try_emplace_back(value);
+}
+
+template <typename T>
+bool
+SpscDeque<T>::try_push_back(value_type&& value)
+{
+    return try_emplace_back(std::move(value));
+}
+
+template <typename T>
+template <typename... Args>
+bool
+SpscDeque<T>::try_emplace_back(Args&&... args)
+{
+    const size_type tail = tail_.load(std::memory_order_relaxed);
+    if (0 == free_slots(tail, 1)) return false;
+    new (buffer_ + (tail & mask_)) T(std::forward<Args>(args)...);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+/// Pushes up to count elements and publishes them with one store.
+/// Returns how many were pushed. If a copy or the iterator throws, the
+/// elements already constructed are published before it propagates.
+template <typename T>
+template <typename InputIterator>
+typename SpscDeque<T>::size_type
+SpscDeque<T>::try_push_back_n(InputIterator first, const size_type count)
+{
+    const size_type tail = tail_.load(std::memory_order_relaxed);
+    const size_type free = free_slots(tail, count);
+    const size_type pushed = count < free ? count : free;
+    size_type constructed = 0;
+    try {
+        for (; constructed < pushed; ++first) {
+            new (buffer_ + ((tail + constructed) & mask_)) T(*first);
+            ++constructed;
+        }
+    } catch (...) {
+        tail_.store(tail + constructed, std::memory_order_release);
+        throw;
+    }
+    tail_.store(tail + pushed, std::memory_order_release);
+    return pushed;
+}
+
+template <typename T>
+bool
+SpscDeque<T>::try_pop_front(reference value)
+{
+    const size_type head = head_.load(std::memory_order_relaxed);
+    if (0 == filled_slots(head, 1)) return false;
+    pointer slot = buffer_ + (head & mask_);
+    value = std::move(*slot);
+    slot->~T();
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+/// Pops up to count elements into out and frees their slots with one store.
+/// Returns how many were popped. If a move or the iterator throws, the
+/// slots already emptied are freed before it propagates; the element whose
+/// move threw stays at the front.
+template <typename T>
+template <typename OutputIterator>
+typename SpscDeque<T>::size_type
+SpscDeque<T>::try_pop_front_n(OutputIterator out, const size_type count)
+{
+    const size_type head = head_.load(std::memory_order_relaxed);
+    const size_type filled = filled_slots(head, count);
+    const size_type popped = count < filled ? count : filled;
+    size_type emptied = 0;
+    try {
+        for (; emptied < popped; ++out) {
+            pointer slot = buffer_ + ((head + emptied) & mask_);
+            *out = std::move(*slot);
+            slot->~T();
+            ++emptied;
+        }
+    } catch (...) {
+        head_.store(head + emptied, std::memory_order_release);
+        throw;
+    }
+    head_.store(head + popped, std::memory_order_release);
+    return popped;
+}
+
+/// Consumer only.
+template <typename T>
+typename SpscDeque<T>::reference
+SpscDeque<T>::front()
+{
+    const size_type head = head_.load(std::memory_order_relaxed);
+    const size_type filled = filled_slots(head, 1);
+    assert(0 != filled);
+    (void)filled;
+    return buffer_[head & mask_];
+}
+
+/// Consumer only.
+template <typename T>
+void
+SpscDeque<T>::pop_front()
+{
+    const size_type head = head_.load(std::memory_order_relaxed);
+    assert(0 != filled_slots(head, 1));
+    buffer_[head & mask_].~T();
+    head_.store(head + 1, std::memory_order_release);
+}
+
+template <typename T>
+typename SpscDeque<T>::size_type
+SpscDeque<T>::capacity() const
+{
+    return mask_ + 1;
+}
+
+template <typename T>
+typename SpscDeque<T>::size_type
+SpscDeque<T>::max_size() const
+{
+    return std::numeric_limits<size_type>::max() / sizeof(T);
+}
+
+/// Exact only from the producer or the consumer thread; elsewhere a snapshot.
+template <typename T>
+typename SpscDeque<T>::size_type
+SpscDeque<T>::size() const
+{
+    const size_type head = head_.load(std::memory_order_acquire);
+    const size_type tail = tail_.load(std::memory_order_acquire);
+    return tail - head;
+}
+
+template <typename T>
+bool
+SpscDeque<T>::empty() const
+{
+    return 0 == size();
+}
+
+/// Producer side: the cached head is refreshed only when it shows fewer than
+/// wanted free slots.
+template <typename T>
+typename SpscDeque<T>::size_type
+SpscDeque<T>::free_slots(const size_type tail, const size_type wanted)
+{
+    size_type free = capacity() - (tail - headCache_);
+    if (free < wanted) {
+        headCache_ = head_.load(std::memory_order_acquire);
+        free = capacity() - (tail - headCache_);
+    }
+    return free;
+}
+
+/// Consumer side: the cached tail is refreshed only when it shows fewer than
+/// wanted filled slots.
+template <typename T>
+typename SpscDeque<T>::size_type
+SpscDeque<T>::filled_slots(const size_type head, const size_type wanted)
+{
+    size_type filled = tailCache_ - head;
+    if (filled < wanted) {
+        tailCache_ = tail_.load(std::memory_order_acquire);
+        filled = tailCache_ - head;
+    }
+    return filled;
+}
+
@@ -0,0 +1,173 @@
+#include "../headers/WorkStealingDeque.hpp"
+#include <cassert>
+#include <type_traits>
+
+/// Follows "Correct and Efficient Work-Stealing for Weak Memory Models"
+/// (Le, Pop, Cohen, Zappa Nardelli, 2013).
+
+template <typename T>
+const typename WorkStealingDeque<T>::size_type WorkStealingDeque<T>::CACHE_LINE;
+
+template <typename T>
+WorkStealingDeque<T>::WorkStealingDeque(const size_type capacity)
+    : top_(0)
+    , bottom_(0)
+    , array_(NULL)
+    , retired_()
+{
+    static_assert(std::is_trivially_copyable<T>::value, "WorkStealingDeque needs a trivially copyable T");
+    size_type powerOfTwo = 2;
+    while (powerOfTwo < capacity) {
+        powerOfTwo *= 2;
+    }
+    array_.store(new Array(powerOfTwo), std::memory_order_relaxed);
+}
+
+template <typename T>
+WorkStealingDeque<T>::~WorkStealingDeque()
+{
+    delete array_.load(std::memory_order_relaxed);
+    for (size_type i = 0; i < retired_.size(); ++i) {
+        delete retired_[i];
+    }
+}
+
+/// Owner only.
+template <typename T>
+void
+WorkStealingDeque<T>::push_back(const_reference value)
+{
+    const difference_type bottom = bottom_.load(std::memory_order_relaxed);
+    const difference_type top = top_.load(std::memory_order_acquire);
+    Array* array = array_.load(std::memory_order_relaxed);
+    if (bottom - top > static_cast<difference_type>(array->capacity()) - 1) {
+        /// Nothing changes if an allocation throws: the retired slot is
+        /// reserved first, and the old array is retired only once the new
+        /// one is published, as thieves may still be reading it.
+        retired_.reserve(retired_.size() + 1);
+        Array* const grown = array->grow(top, bottom);
+        array_.store(grown, std::memory_order_release);
+        retired_.push_back(array);
+        array = grown;
+    }
+    array->put(bottom, value);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+}
+
+/// Owner only. Takes the newest element; races with thieves only for the
+/// last one.
+template <typename T>
+bool
+WorkStealingDeque<T>::pop_back(value_type& value)
+{
+    const difference_type bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Array* array = array_.load(std::memory_order_relaxed);
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    difference_type top = top_.load(std::memory_order_relaxed);
+    if (top > bottom) {
+        bottom_.store(bottom + 1, std::memory_order_relaxed);
+        return false;
+    }
+    value = array->get(bottom);
+    if (top < bottom) return true;
+    const bool won = top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return won;
+}
+
+/// Any thread. Takes the oldest element; returns false when the deque is
+/// empty or another thread took that element first.
+template <typename T>
+bool
+WorkStealingDeque<T>::steal(value_type& value)
+{
+    difference_type top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const difference_type bottom = bottom_.load(std::memory_order_acquire);
+    if (top >= bottom) return false;
+    Array* array = array_.load(std::memory_order_acquire);
+    const T stolen = array->get(top);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return false;
+    }
+    value = stolen;
+    return true;
+}
+
+/// Owner only.
+template <typename T>
+typename WorkStealingDeque<T>::size_type
+WorkStealingDeque<T>::capacity() const
+{
+    return array_.load(std::memory_order_relaxed)->capacity();
+}
+
+/// A snapshot when called concurrently with thieves.
+template <typename T>
+typename WorkStealingDeque<T>::size_type
+WorkStealingDeque<T>::size() const
+{
+    const difference_type bottom = bottom_.load(std::memory_order_relaxed);
+    const difference_type top = top_.load(std::memory_order_relaxed);
+    return bottom > top ? static_cast<size_type>(bottom - top) : 0;
+}
+
+template <typename T>
+bool
+WorkStealingDeque<T>::empty() const
+{
+    return 0 == size();
+}
+
+///==================================ARRAY======================
+
+template <typename T>
+WorkStealingDeque<T>::Array::Array(const size_type capacity)
+    : mask_(capacity - 1)
+    , slots_(new std::atomic<T>[capacity])
+{
+    assert(0 == (capacity & mask_));
+}
+
+template <typename T>
+WorkStealingDeque<T>::Array::~Array()
+{
+    delete [] slots_;
+}
+
+template <typename T>
+typename WorkStealingDeque<T>::size_type
+WorkStealingDeque<T>::Array::capacity() const
+{
+    return mask_ + 1;
+}
+
+template <typename T>
+T
+WorkStealingDeque<T>::Array::get(const difference_type index) const
+{
+    return slots_[static_cast<size_type>(index) & mask_].load(std::memory_order_relaxed);
+}
+
+template <typename T>
+void
+WorkStealingDeque<T>::Array::put(const difference_type index, const_reference value)
+{
+    slots_[static_cast<size_type>(index) & mask_].store(value, std::memory_order_relaxed);
+}
+
+/// Copies the live range [top, bottom) into an array twice the size; each
+/// element keeps its logical index.
+template <typename T>
+typename WorkStealingDeque<T>::Array*
+WorkStealingDeque<T>::Array::grow(const difference_type top, const difference_type bottom) const
+{
+    Array* array = new Array(2 * capacity());
+    for (difference_type i = top; i < bottom; ++i) {
+        array->put(i, get(i));
+    }
+    return array;
+}
+